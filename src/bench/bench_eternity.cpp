@@ -4,6 +4,7 @@
 
 #include "bench.h"
 
+#include "crypto/x11.h"
 #include "key.h"
 #include "main.h"
 #include "util.h"
@@ -11,6 +12,7 @@
 int
 main(int argc, char** argv)
 {
+    X11AutoDetect();
     ECC_Start();
     SetupEnvironment();
     fPrintToDebugLog = false; // don't want to write to debug.log file
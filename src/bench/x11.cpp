@@ -0,0 +1,43 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "crypto/x11.h"
+#include "hash.h"
+#include "primitives/block.h"
+#include "uint256.h"
+
+// X11 of a block header, as done for every header during sync/reindex and in the miner loop
+static void X11_BlockHeader(benchmark::State& state)
+{
+    CBlockHeader header;
+    header.nVersion = 4;
+    header.nTime = 1483228800;
+    header.nBits = 0x1e0ffff0;
+    header.nNonce = 0;
+    while (state.KeepRunning()) {
+        header.nNonce++;
+        header.GetHash();
+    }
+}
+
+static void X11_Shavite512_64(benchmark::State& state)
+{
+    uint512 hash;
+    while (state.KeepRunning()) {
+        X11Shavite512_64(&hash, &hash);
+    }
+}
+
+static void X11_Echo512_64(benchmark::State& state)
+{
+    uint512 hash;
+    while (state.KeepRunning()) {
+        X11Echo512_64(&hash, &hash);
+    }
+}
+
+BENCHMARK(X11_BlockHeader);
+BENCHMARK(X11_Shavite512_64);
+BENCHMARK(X11_Echo512_64);
@@ -297,6 +297,20 @@ struct CCoinsCacheEntry
 
 typedef boost::unordered_map<uint256, CCoinsCacheEntry, CCoinsKeyHasher> CCoinsMap;
 
+/** Salted hasher for containers keyed by COutPoint (see CCoinsKeyHasher). */
+class COutPointHasher
+{
+private:
+    uint256 salt;
+
+public:
+    COutPointHasher();
+
+    size_t operator()(const COutPoint& outpoint) const {
+        return outpoint.hash.GetHash(salt) + outpoint.n;
+    }
+};
+
 struct CCoinsStats
 {
     int nHeight;
@@ -419,6 +433,12 @@ public:
      */
     const CCoins* AccessCoins(const uint256 &txid) const;
 
+    /**
+     * Get the height of the block which created an unspent output without copying
+     * its CCoins. Returns false if the output doesn't exist or is spent already.
+     */
+    bool GetUnspentOutputHeight(const COutPoint &outpoint, int &nHeightRet) const;
+
     /**
      * Return a modifiable reference to a CCoins. If no entry with the given
      * txid exists, a new one is created. Simultaneous modifications are not
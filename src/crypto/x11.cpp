@@ -0,0 +1,294 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "crypto/x11.h"
+
+#include "crypto/sph_echo.h"
+#include "crypto/sph_shavite.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENABLE_X11_AESNI 1
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <emmintrin.h>
+#endif
+
+// Internal implementation code.
+namespace
+{
+/// Portable implementations (sph).
+namespace x11_ref
+{
+void Shavite512_64(const void* pin, void* pout)
+{
+    sph_shavite512_context ctx;
+    sph_shavite512_init(&ctx);
+    sph_shavite512(&ctx, pin, 64);
+    sph_shavite512_close(&ctx, pout);
+}
+
+void Echo512_64(const void* pin, void* pout)
+{
+    sph_echo512_context ctx;
+    sph_echo512_init(&ctx);
+    sph_echo512(&ctx, pin, 64);
+    sph_echo512_close(&ctx, pout);
+}
+} // namespace x11_ref
+
+#ifdef ENABLE_X11_AESNI
+/**
+ * AES-NI implementations.
+ *
+ * Both primitives are built from full AES rounds (SubBytes, ShiftRows, MixColumns,
+ * AddRoundKey) on 128 bit words, which is exactly what AESENC computes. Since the
+ * input is always a single 64 byte message, padding and bit counters are constants.
+ */
+namespace x11_aesni
+{
+#define X11_AESNI __attribute__((target("aes,sse2")))
+
+/** SHAvite-512 IV */
+static const uint32_t SHAVITE_IV512[16] = {
+    0x72FCCDD8, 0x79CA4727, 0x128A077B, 0x40D55AEC,
+    0xD1901A06, 0x430AE307, 0xB29F5CD1, 0xDF07FBFC,
+    0x8E45D73D, 0x681AB538, 0xBDE86578, 0xDD577E47,
+    0xE275EADE, 0x502D9FCD, 0xB9357178, 0x022A4B9A
+};
+
+void X11_AESNI Shavite512_64(const void* pin, void* pout)
+{
+    const __m128i zero = _mm_setzero_si128();
+    // message block and 448 words of round keys, 4 words per entry
+    __m128i rk[112];
+
+    // 64 bytes of data, padding byte, bit counter (512) at 110, output size (512) at 126
+    const __m128i* in = (const __m128i*)pin;
+    rk[0] = _mm_loadu_si128(in + 0);
+    rk[1] = _mm_loadu_si128(in + 1);
+    rk[2] = _mm_loadu_si128(in + 2);
+    rk[3] = _mm_loadu_si128(in + 3);
+    rk[4] = _mm_set_epi32(0, 0, 0, 0x80);
+    rk[5] = zero;
+    rk[6] = _mm_insert_epi16(zero, 0x0200, 7);
+    rk[7] = _mm_set_epi32(0x02000000, 0, 0, 0);
+
+    // counter words are (count0, count1, count2, count3) = (512, 0, 0, 0), injected
+    // in different orders and with one word inverted at four points of the key schedule
+    const __m128i cnt8 = _mm_set_epi32(~0, 0, 0, 512);
+    const __m128i cnt41 = _mm_set_epi32(~512, 0, 0, 0);
+    const __m128i cnt79 = _mm_set_epi32(~0, 512, 0, 0);
+    const __m128i cnt110 = _mm_set_epi32(~0, 0, 512, 0);
+
+    int k = 8;
+    for (;;) {
+        for (int s = 0; s < 8; s++) {
+            __m128i x = _mm_shuffle_epi32(rk[k - 8], 0x39);
+            x = _mm_aesenc_si128(x, zero);
+            rk[k] = _mm_xor_si128(x, rk[k - 1]);
+            if (k == 8) rk[k] = _mm_xor_si128(rk[k], cnt8);
+            else if (k == 41) rk[k] = _mm_xor_si128(rk[k], cnt41);
+            else if (k == 79) rk[k] = _mm_xor_si128(rk[k], cnt79);
+            else if (k == 110) rk[k] = _mm_xor_si128(rk[k], cnt110);
+            k++;
+        }
+        if (k == 112)
+            break;
+        for (int s = 0; s < 8; s++) {
+            // words 4k-7 .. 4k-4 straddle two entries
+            __m128i y = _mm_loadu_si128((const __m128i*)((const uint32_t*)rk + 4 * k - 7));
+            rk[k] = _mm_xor_si128(rk[k - 8], y);
+            k++;
+        }
+    }
+
+    const __m128i* iv = (const __m128i*)SHAVITE_IV512;
+    __m128i p0 = _mm_loadu_si128(iv + 0);
+    __m128i p1 = _mm_loadu_si128(iv + 1);
+    __m128i p2 = _mm_loadu_si128(iv + 2);
+    __m128i p3 = _mm_loadu_si128(iv + 3);
+
+    k = 0;
+    for (int r = 0; r < 14; r++) {
+        __m128i x = _mm_xor_si128(p1, rk[k]);
+        x = _mm_aesenc_si128(x, rk[k + 1]);
+        x = _mm_aesenc_si128(x, rk[k + 2]);
+        x = _mm_aesenc_si128(x, rk[k + 3]);
+        x = _mm_aesenc_si128(x, zero);
+        p0 = _mm_xor_si128(p0, x);
+
+        x = _mm_xor_si128(p3, rk[k + 4]);
+        x = _mm_aesenc_si128(x, rk[k + 5]);
+        x = _mm_aesenc_si128(x, rk[k + 6]);
+        x = _mm_aesenc_si128(x, rk[k + 7]);
+        x = _mm_aesenc_si128(x, zero);
+        p2 = _mm_xor_si128(p2, x);
+        k += 8;
+
+        __m128i t = p3;
+        p3 = p2;
+        p2 = p1;
+        p1 = p0;
+        p0 = t;
+    }
+
+    __m128i* out = (__m128i*)pout;
+    _mm_storeu_si128(out + 0, _mm_xor_si128(_mm_loadu_si128(iv + 0), p0));
+    _mm_storeu_si128(out + 1, _mm_xor_si128(_mm_loadu_si128(iv + 1), p1));
+    _mm_storeu_si128(out + 2, _mm_xor_si128(_mm_loadu_si128(iv + 2), p2));
+    _mm_storeu_si128(out + 3, _mm_xor_si128(_mm_loadu_si128(iv + 3), p3));
+}
+
+/** Multiply every byte by x in GF(2^8) */
+static inline __m128i X11_AESNI XTime(__m128i x)
+{
+    const __m128i poly = _mm_set1_epi8(0x1b);
+    __m128i hi = _mm_cmplt_epi8(x, _mm_setzero_si128());
+    return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(hi, poly));
+}
+
+static inline void X11_AESNI EchoMixColumn(__m128i* W, int ia, int ib, int ic, int id)
+{
+    __m128i a = W[ia];
+    __m128i b = W[ib];
+    __m128i c = W[ic];
+    __m128i d = W[id];
+    __m128i ab = _mm_xor_si128(a, b);
+    __m128i bc = _mm_xor_si128(b, c);
+    __m128i cd = _mm_xor_si128(c, d);
+    __m128i abx = XTime(ab);
+    __m128i bcx = XTime(bc);
+    __m128i cdx = XTime(cd);
+    W[ia] = _mm_xor_si128(abx, _mm_xor_si128(bc, d));
+    W[ib] = _mm_xor_si128(bcx, _mm_xor_si128(a, cd));
+    W[ic] = _mm_xor_si128(cdx, _mm_xor_si128(ab, d));
+    W[id] = _mm_xor_si128(_mm_xor_si128(abx, bcx), _mm_xor_si128(_mm_xor_si128(cdx, ab), c));
+}
+
+void X11_AESNI Echo512_64(const void* pin, void* pout)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    // chaining value is the output size in bits
+    const __m128i v = _mm_set_epi32(0, 0, 0, 512);
+    const __m128i* in = (const __m128i*)pin;
+    __m128i W[16];
+
+    for (int i = 0; i < 8; i++)
+        W[i] = v;
+    W[8] = _mm_loadu_si128(in + 0);
+    W[9] = _mm_loadu_si128(in + 1);
+    W[10] = _mm_loadu_si128(in + 2);
+    W[11] = _mm_loadu_si128(in + 3);
+    // padding byte, output size (512) at 110, bit counter (512) at 112
+    W[12] = _mm_set_epi32(0, 0, 0, 0x80);
+    W[13] = zero;
+    W[14] = _mm_insert_epi16(zero, 0x0200, 7);
+    W[15] = _mm_set_epi32(0, 0, 0, 512);
+
+    // salt starts at the bit counter and is incremented for every AES pair,
+    // 160 increments can't carry out of the lowest word
+    __m128i K = _mm_set_epi32(0, 0, 0, 512);
+
+    for (int r = 0; r < 10; r++) {
+        // BIG.SubWords
+        for (int i = 0; i < 16; i++) {
+            W[i] = _mm_aesenc_si128(_mm_aesenc_si128(W[i], K), zero);
+            K = _mm_add_epi32(K, one);
+        }
+
+        // BIG.ShiftRows
+        __m128i t = W[1];
+        W[1] = W[5];
+        W[5] = W[9];
+        W[9] = W[13];
+        W[13] = t;
+        t = W[2];
+        W[2] = W[10];
+        W[10] = t;
+        t = W[6];
+        W[6] = W[14];
+        W[14] = t;
+        t = W[15];
+        W[15] = W[11];
+        W[11] = W[7];
+        W[7] = W[3];
+        W[3] = t;
+
+        // BIG.MixColumns
+        EchoMixColumn(W, 0, 1, 2, 3);
+        EchoMixColumn(W, 4, 5, 6, 7);
+        EchoMixColumn(W, 8, 9, 10, 11);
+        EchoMixColumn(W, 12, 13, 14, 15);
+    }
+
+    __m128i* out = (__m128i*)pout;
+    for (int i = 0; i < 4; i++) {
+        __m128i x = _mm_xor_si128(_mm_xor_si128(v, _mm_loadu_si128(in + i)), _mm_xor_si128(W[i], W[i + 8]));
+        _mm_storeu_si128(out + i, x);
+    }
+}
+
+#undef X11_AESNI
+
+bool Available()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    // AES-NI and SSE2
+    return (ecx & (1U << 25)) && (edx & (1U << 26));
+}
+} // namespace x11_aesni
+#endif // ENABLE_X11_AESNI
+
+typedef void (*X11Func64)(const void* pin, void* pout);
+
+X11Func64 shavite512_64 = x11_ref::Shavite512_64;
+X11Func64 echo512_64 = x11_ref::Echo512_64;
+
+/** Compare an implementation against the reference on a few inputs */
+bool SelfTest(X11Func64 func, X11Func64 ref)
+{
+    unsigned char in[64], out[64], outRef[64];
+    for (int n = 0; n < 8; n++) {
+        for (int i = 0; i < 64; i++)
+            in[i] = (unsigned char)(i * 7 + n * 131 + (i * n) % 13);
+        func(in, out);
+        ref(in, outRef);
+        if (memcmp(out, outRef, sizeof(out)) != 0)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+void X11Shavite512_64(const void* pin, void* pout)
+{
+    shavite512_64(pin, pout);
+}
+
+void X11Echo512_64(const void* pin, void* pout)
+{
+    echo512_64(pin, pout);
+}
+
+std::string X11AutoDetect()
+{
+#ifdef ENABLE_X11_AESNI
+    if (x11_aesni::Available() &&
+        SelfTest(x11_aesni::Shavite512_64, x11_ref::Shavite512_64) &&
+        SelfTest(x11_aesni::Echo512_64, x11_ref::Echo512_64)) {
+        shavite512_64 = x11_aesni::Shavite512_64;
+        echo512_64 = x11_aesni::Echo512_64;
+        return "aesni(shavite,echo)";
+    }
+#endif
+    shavite512_64 = x11_ref::Shavite512_64;
+    echo512_64 = x11_ref::Echo512_64;
+    return "standard";
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_CRYPTO_X11_H
+#define BITCOIN_CRYPTO_X11_H
+
+#include <string>
+
+/**
+ * X11 stages which have faster implementations on some CPUs.
+ *
+ * All X11 stages after the first one hash exactly 64 bytes (the previous 512 bit
+ * result), the functions below compute SHAvite-512 and ECHO-512 of such an input.
+ * They use the portable sph implementations until X11AutoDetect() selects
+ * something faster.
+ */
+
+/** SHAvite-512 of 64 bytes at pin, writes 64 bytes to pout */
+void X11Shavite512_64(const void* pin, void* pout);
+
+/** ECHO-512 of 64 bytes at pin, writes 64 bytes to pout */
+void X11Echo512_64(const void* pin, void* pout);
+
+/**
+ * Select the fastest X11 implementation available on this CPU.
+ * Every candidate is checked against the portable implementation first.
+ * Call once at startup before any other thread uses X11, returns a description of the selected implementation.
+ */
+std::string X11AutoDetect();
+
+#endif // BITCOIN_CRYPTO_X11_H
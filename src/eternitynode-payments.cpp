@@ -3,11 +3,13 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "activeeternitynode.h"
+#include "core_memusage.h"
 #include "spysend.h"
 #include "governance-classes.h"
 #include "eternitynode-payments.h"
 #include "eternitynode-sync.h"
 #include "eternitynodeman.h"
+#include "memusage.h"
 #include "netfulfilledman.h"
 #include "spork.h"
 #include "util.h"
@@ -236,18 +238,30 @@ void CEternitynodePayments::Clear()
     LOCK2(cs_mapEternitynodeBlocks, cs_mapEternitynodePaymentVotes);
     mapEternitynodeBlocks.clear();
     mapEternitynodePaymentVotes.clear();
+    mapVoteHashesByHeight.clear();
+    mapBestPayees.clear();
+    mapScheduledPayees.clear();
 }
 
 bool CEternitynodePayments::CanVote(COutPoint outEternitynode, int nBlockHeight)
 {
     LOCK(cs_mapEternitynodePaymentVotes);
 
-    if (mapEternitynodesLastVote.count(outEternitynode) && mapEternitynodesLastVote[outEternitynode] == nBlockHeight) {
-        return false;
+    last_vote_m_t::iterator it = mapEternitynodesLastVote.find(outEternitynode);
+    if (it != mapEternitynodesLastVote.end()) {
+        if (it->second == nBlockHeight) {
+            return false;
+        }
+        std::map<int, std::set<COutPoint> >::iterator itHeight = mapLastVotesByHeight.find(it->second);
+        if (itHeight != mapLastVotesByHeight.end()) {
+            itHeight->second.erase(outEternitynode);
+            if (itHeight->second.empty()) mapLastVotesByHeight.erase(itHeight);
+        }
     }
 
     //record this eternitynode voted
     mapEternitynodesLastVote[outEternitynode] = nBlockHeight;
+    mapLastVotesByHeight[nBlockHeight].insert(outEternitynode);
     return true;
 }
 
@@ -348,10 +362,9 @@ void CEternitynodePayments::ProcessMessage(CNode* pfrom, std::string& strCommand
             }
 
             // Avoid processing same vote multiple times
-            mapEternitynodePaymentVotes[nHash] = vote;
             // but first mark vote as non-verified,
             // AddPaymentVote() below should take care of it if vote is actually ok
-            mapEternitynodePaymentVotes[nHash].MarkAsNotVerified();
+            StorePaymentVote(nHash, vote).MarkAsNotVerified();
         }
 
         int nFirstBlock = pCurrentBlockIndex->nHeight - GetStorageLimit();
@@ -410,12 +423,17 @@ void CEternitynodePayments::ProcessMessage(CNode* pfrom, std::string& strCommand
     }
 }
 
+std::string CEternitynodePaymentVote::GetSignatureMessage() const
+{
+    return vinEternitynode.prevout.ToStringShort() +
+            boost::lexical_cast<std::string>(nBlockHeight) +
+            ScriptToAsmStr(payee);
+}
+
 bool CEternitynodePaymentVote::Sign()
 {
     std::string strError;
-    std::string strMessage = vinEternitynode.prevout.ToStringShort() +
-                boost::lexical_cast<std::string>(nBlockHeight) +
-                ScriptToAsmStr(payee);
+    std::string strMessage = GetSignatureMessage();
 
     if(!spySendSigner.SignMessage(strMessage, vchSig, activeEternitynode.keyEternitynode)) {
         LogPrintf("CEternitynodePaymentVote::Sign -- SignMessage() failed\n");
@@ -446,19 +464,94 @@ bool CEternitynodePayments::IsScheduled(CEternitynode& mn, int nNotBlockHeight)
     LOCK(cs_mapEternitynodeBlocks);
 
     if(!pCurrentBlockIndex) return false;
+    if(nScheduledHeight != pCurrentBlockIndex->nHeight) RebuildScheduledPayees();
 
     CScript mnpayee;
     mnpayee = GetScriptForDestination(mn.pubKeyCollateralAddress.GetID());
 
+    std::map<CScript, int>::iterator it = mapScheduledPayees.find(mnpayee);
+    if(it == mapScheduledPayees.end()) return false;
+
+    return CountScheduled(mnpayee, it->second, nNotBlockHeight) > 0;
+}
+
+void CEternitynodePayments::GetScheduledPayees(int nNotBlockHeight, std::set<CScript>& setPayeesRet)
+{
+    LOCK(cs_mapEternitynodeBlocks);
+
+    setPayeesRet.clear();
+
+    if(!pCurrentBlockIndex) return;
+    if(nScheduledHeight != pCurrentBlockIndex->nHeight) RebuildScheduledPayees();
+
+    for(std::map<CScript, int>::iterator it = mapScheduledPayees.begin(); it != mapScheduledPayees.end(); ++it) {
+        if(CountScheduled(it->first, it->second, nNotBlockHeight) > 0) {
+            setPayeesRet.insert(it->first);
+        }
+    }
+}
+
+int CEternitynodePayments::CountScheduled(const CScript& payee, int nScheduledCount, int nNotBlockHeight)
+{
+    AssertLockHeld(cs_mapEternitynodeBlocks);
+
+    if(nNotBlockHeight < nScheduledHeight || nNotBlockHeight > nScheduledHeight + 8) return nScheduledCount;
+
+    std::map<int, CScript>::iterator it = mapBestPayees.find(nNotBlockHeight);
+    if(it != mapBestPayees.end() && it->second == payee) return nScheduledCount - 1;
+
+    return nScheduledCount;
+}
+
+void CEternitynodePayments::UpdateBestPayee(int nBlockHeight)
+{
+    AssertLockHeld(cs_mapEternitynodeBlocks);
+
     CScript payee;
-    for(int64_t h = pCurrentBlockIndex->nHeight; h <= pCurrentBlockIndex->nHeight + 8; h++){
-        if(h == nNotBlockHeight) continue;
-        if(mapEternitynodeBlocks.count(h) && mapEternitynodeBlocks[h].GetBestPayee(payee) && mnpayee == payee) {
-            return true;
+    std::map<int, CEternitynodeBlockPayees>::iterator it = mapEternitynodeBlocks.find(nBlockHeight);
+    if(it != mapEternitynodeBlocks.end() && it->second.GetBestPayee(payee)) {
+        mapBestPayees[nBlockHeight] = payee;
+    } else {
+        mapBestPayees.erase(nBlockHeight);
+    }
+
+    // only blocks from the tip up to 8 blocks ahead are scheduled
+    if(nBlockHeight >= nScheduledHeight && nBlockHeight <= nScheduledHeight + 8) {
+        RebuildScheduledPayees();
+    }
+}
+
+void CEternitynodePayments::RebuildBestPayees()
+{
+    AssertLockHeld(cs_mapEternitynodeBlocks);
+
+    mapBestPayees.clear();
+    CScript payee;
+    for(std::map<int, CEternitynodeBlockPayees>::iterator it = mapEternitynodeBlocks.begin(); it != mapEternitynodeBlocks.end(); ++it) {
+        if(it->second.GetBestPayee(payee)) {
+            mapBestPayees[it->first] = payee;
         }
     }
+    RebuildScheduledPayees();
+}
 
-    return false;
+void CEternitynodePayments::RebuildScheduledPayees()
+{
+    AssertLockHeld(cs_mapEternitynodeBlocks);
+
+    mapScheduledPayees.clear();
+    if(!pCurrentBlockIndex) {
+        nScheduledHeight = -1;
+        return;
+    }
+
+    nScheduledHeight = pCurrentBlockIndex->nHeight;
+    for(int h = nScheduledHeight; h <= nScheduledHeight + 8; h++) {
+        std::map<int, CScript>::iterator it = mapBestPayees.find(h);
+        if(it != mapBestPayees.end()) {
+            mapScheduledPayees[it->second]++;
+        }
+    }
 }
 
 bool CEternitynodePayments::AddPaymentVote(const CEternitynodePaymentVote& vote)
@@ -470,7 +563,7 @@ bool CEternitynodePayments::AddPaymentVote(const CEternitynodePaymentVote& vote)
 
     LOCK2(cs_mapEternitynodeBlocks, cs_mapEternitynodePaymentVotes);
 
-    mapEternitynodePaymentVotes[vote.GetHash()] = vote;
+    StorePaymentVote(vote.GetHash(), vote);
 
     if(!mapEternitynodeBlocks.count(vote.nBlockHeight)) {
        CEternitynodeBlockPayees blockPayees(vote.nBlockHeight);
@@ -478,6 +571,7 @@ bool CEternitynodePayments::AddPaymentVote(const CEternitynodePaymentVote& vote)
     }
 
     mapEternitynodeBlocks[vote.nBlockHeight].AddPayee(vote);
+    UpdateBestPayee(vote.nBlockHeight);
 
     return true;
 }
@@ -485,10 +579,63 @@ bool CEternitynodePayments::AddPaymentVote(const CEternitynodePaymentVote& vote)
 bool CEternitynodePayments::HasVerifiedPaymentVote(uint256 hashIn)
 {
     LOCK(cs_mapEternitynodePaymentVotes);
-    std::map<uint256, CEternitynodePaymentVote>::iterator it = mapEternitynodePaymentVotes.find(hashIn);
+    vote_m_t::iterator it = mapEternitynodePaymentVotes.find(hashIn);
     return it != mapEternitynodePaymentVotes.end() && it->second.IsVerified();
 }
 
+CEternitynodePaymentVote& CEternitynodePayments::StorePaymentVote(const uint256& nHash, const CEternitynodePaymentVote& vote)
+{
+    AssertLockHeld(cs_mapEternitynodePaymentVotes);
+
+    std::pair<vote_m_t::iterator, bool> ret = mapEternitynodePaymentVotes.insert(std::make_pair(nHash, vote));
+    if(ret.second) {
+        mapVoteHashesByHeight[vote.nBlockHeight].push_back(nHash);
+    } else {
+        ret.first->second = vote;
+    }
+    return ret.first->second;
+}
+
+void CEternitynodePayments::RebuildVoteHashesByHeight()
+{
+    AssertLockHeld(cs_mapEternitynodePaymentVotes);
+
+    mapVoteHashesByHeight.clear();
+    for(vote_m_t::iterator it = mapEternitynodePaymentVotes.begin(); it != mapEternitynodePaymentVotes.end(); ++it) {
+        mapVoteHashesByHeight[it->second.nBlockHeight].push_back(it->first);
+    }
+}
+
+size_t CEternitynodePayments::GetMemoryUsage()
+{
+    LOCK2(cs_mapEternitynodeBlocks, cs_mapEternitynodePaymentVotes);
+
+    size_t nUsage = memusage::DynamicUsage(mapEternitynodePaymentVotes) +
+                    memusage::DynamicUsage(mapEternitynodeBlocks) +
+                    memusage::DynamicUsage(mapEternitynodesLastVote) +
+                    memusage::DynamicUsage(mapLastVotesByHeight) +
+                    memusage::DynamicUsage(mapVoteHashesByHeight) +
+                    memusage::DynamicUsage(mapBestPayees);
+
+    for(vote_m_t::iterator it = mapEternitynodePaymentVotes.begin(); it != mapEternitynodePaymentVotes.end(); ++it) {
+        nUsage += RecursiveDynamicUsage(it->second.payee) + memusage::DynamicUsage(it->second.vchSig);
+    }
+    for(std::map<int, CEternitynodeBlockPayees>::iterator it = mapEternitynodeBlocks.begin(); it != mapEternitynodeBlocks.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second.vecPayees);
+        BOOST_FOREACH(CEternitynodePayee& payee, it->second.vecPayees) {
+            nUsage += RecursiveDynamicUsage(payee.GetPayee()) + payee.GetVoteCount() * sizeof(uint256);
+        }
+    }
+    for(std::map<int, std::vector<uint256> >::iterator it = mapVoteHashesByHeight.begin(); it != mapVoteHashesByHeight.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second);
+    }
+    for(std::map<int, std::set<COutPoint> >::iterator it = mapLastVotesByHeight.begin(); it != mapLastVotesByHeight.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second);
+    }
+
+    return nUsage;
+}
+
 void CEternitynodeBlockPayees::AddPayee(const CEternitynodePaymentVote& vote)
 {
     LOCK(cs_vecPayees);
@@ -547,9 +694,7 @@ bool CEternitynodeBlockPayees::IsTransactionValid(const CTransaction& txNew)
     
 	CAmount nEternitynodePayment;
 	if( sporkManager.IsSporkWorkActive(SPORK_6_EVOLUTION_PAYMENTS) ){
-		CScript payeeEvo;
-		CBitcoinAddress address( evolutionManager.getEvolution(nBlockHeight) );
-		payeeEvo = GetScriptForDestination( address.Get() );
+		CScript payeeEvo = evolutionManager.getEvolutionScript( nBlockHeight );
 		nEternitynodePayment = GetEternitynodePayment(  nBlockHeight, txNew.GetValueOutWOEvol( payeeEvo )   );
 	}else{
 		nEternitynodePayment = GetEternitynodePayment(   nBlockHeight, txNew.GetValueOut()    );
@@ -644,19 +789,29 @@ void CEternitynodePayments::CheckAndRemove()
     LOCK2(cs_mapEternitynodeBlocks, cs_mapEternitynodePaymentVotes);
 
     int nLimit = GetStorageLimit();
+    // votes for blocks below this height are out of the storage window
+    int nFirstBlock = pCurrentBlockIndex->nHeight - nLimit;
+
+    std::map<int, std::vector<uint256> >::iterator it = mapVoteHashesByHeight.begin();
+    while(it != mapVoteHashesByHeight.end() && it->first < nFirstBlock) {
+        LogPrint("enpayments", "CEternitynodePayments::CheckAndRemove -- Removing old Eternitynode payments: nBlockHeight=%d, votes=%d\n", it->first, it->second.size());
+        BOOST_FOREACH(const uint256& hash, it->second) {
+            mapEternitynodePaymentVotes.erase(hash);
+        }
+        mapEternitynodeBlocks.erase(it->first);
+        mapBestPayees.erase(it->first);
+        mapVoteHashesByHeight.erase(it++);
+    }
 
-    std::map<uint256, CEternitynodePaymentVote>::iterator it = mapEternitynodePaymentVotes.begin();
-    while(it != mapEternitynodePaymentVotes.end()) {
-        CEternitynodePaymentVote vote = (*it).second;
-
-        if(pCurrentBlockIndex->nHeight - vote.nBlockHeight > nLimit) {
-            LogPrint("enpayments", "CEternitynodePayments::CheckAndRemove -- Removing old Eternitynode payment: nBlockHeight=%d\n", vote.nBlockHeight);
-            mapEternitynodePaymentVotes.erase(it++);
-            mapEternitynodeBlocks.erase(vote.nBlockHeight);
-        } else {
-            ++it;
+    // last votes for blocks out of the window can't block any vote we would still accept
+    std::map<int, std::set<COutPoint> >::iterator itLastVotes = mapLastVotesByHeight.begin();
+    while(itLastVotes != mapLastVotesByHeight.end() && itLastVotes->first < nFirstBlock) {
+        BOOST_FOREACH(const COutPoint& outpoint, itLastVotes->second) {
+            mapEternitynodesLastVote.erase(outpoint);
         }
+        mapLastVotesByHeight.erase(itLastVotes++);
     }
+    RebuildScheduledPayees();
     LogPrintf("CEternitynodePayments::CheckAndRemove -- %s\n", ToString());
 }
 
@@ -795,9 +950,7 @@ bool CEternitynodePaymentVote::CheckSignature(const CPubKey& pubKeyEternitynode,
     // do not ban by default
     nDos = 0;
 
-    std::string strMessage = vinEternitynode.prevout.ToStringShort() +
-                boost::lexical_cast<std::string>(nBlockHeight) +
-                ScriptToAsmStr(payee);
+    std::string strMessage = GetSignatureMessage();
 
     std::string strError = "";
     if (!spySendSigner.VerifyMessage(pubKeyEternitynode, vchSig, strMessage, strError)) {
@@ -855,13 +1008,7 @@ void CEternitynodePayments::CreateEvolution( CMutableTransaction& txNewRet, int
     // make sure it's empty, just in case
     voutSuperblockRet.clear();
 			
-	CScript payeeEvo;
-	CPubKey pb;
-
-	CBitcoinAddress address( evolutionManager.getEvolution(nBlockHeight)  );
-
-	//--.
-	payeeEvo = GetScriptForDestination( address.Get() );
+	CScript payeeEvo = evolutionManager.getEvolutionScript( nBlockHeight );
 	
 	CTxOut txout = CTxOut(  blockEvolution, payeeEvo );
 	
@@ -954,7 +1101,8 @@ std::string CEternitynodePayments::ToString() const
     std::ostringstream info;
 
     info << "Votes: " << (int)mapEternitynodePaymentVotes.size() <<
-            ", Blocks: " << (int)mapEternitynodeBlocks.size();
+            ", Blocks: " << (int)mapEternitynodeBlocks.size() <<
+            ", Heights: " << (int)mapVoteHashesByHeight.size();
 
     return info.str();
 }
@@ -976,5 +1124,10 @@ void CEternitynodePayments::UpdatedBlockTip(const CBlockIndex *pindex)
     pCurrentBlockIndex = pindex;
     LogPrint("enpayments", "CEternitynodePayments::UpdatedBlockTip -- pCurrentBlockIndex->nHeight=%d\n", pCurrentBlockIndex->nHeight);
 
+    {
+        LOCK(cs_mapEternitynodeBlocks);
+        RebuildScheduledPayees();
+    }
+
     ProcessBlock(pindex->nHeight + 10);
 }
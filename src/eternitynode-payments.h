@@ -12,6 +12,8 @@
 #include "eternitynode.h"
 #include "utilstrencodings.h"
 
+#include <boost/unordered_map.hpp>
+
 class CEternitynodePayments;
 class CEternitynodePaymentVote;
 class CEternitynodeBlockPayees;
@@ -29,6 +31,7 @@ static const int MIN_ETERNITYNODE_PAYMENT_PROTO_VERSION_2 = 70207;
 extern CCriticalSection cs_vecPayees;
 extern CCriticalSection cs_mapEternitynodeBlocks;
 extern CCriticalSection cs_mapEternitynodePayeeVotes;
+extern CCriticalSection cs_mapEternitynodePaymentVotes;
 
 extern CEternitynodePayments enpayments;
 
@@ -147,6 +150,8 @@ public:
         return ss.GetHash();
     }
 
+    /// The message covered by vchSig
+    std::string GetSignatureMessage() const;
     bool Sign();
     bool CheckSignature(const CPubKey& pubKeyEternitynode, int nValidationHeight, int &nDos);
 
@@ -175,19 +180,75 @@ private:
     // Keep track of current block index
     const CBlockIndex *pCurrentBlockIndex;
 
+    /// Best payee of every block in mapEternitynodeBlocks which has one
+    std::map<int, CScript> mapBestPayees;
+    /// Number of blocks IsScheduled() looks at (see nScheduledHeight) each payee is the best payee of
+    std::map<CScript, int> mapScheduledPayees;
+    /// Tip height mapScheduledPayees was built for
+    int nScheduledHeight;
+
+    /// Hashes of all votes in mapEternitynodePaymentVotes by block height, the unit of expiry
+    std::map<int, std::vector<uint256> > mapVoteHashesByHeight;
+    /// Eternitynodes in mapEternitynodesLastVote by the height of their last vote, the unit of expiry
+    std::map<int, std::set<COutPoint> > mapLastVotesByHeight;
+
+    /// Add a vote to mapEternitynodePaymentVotes and its height bucket, returns the stored vote
+    CEternitynodePaymentVote& StorePaymentVote(const uint256& nHash, const CEternitynodePaymentVote& vote);
+    void RebuildVoteHashesByHeight();
+
+    // unordered maps use the same serialization format as std::map
+    template <typename Stream, typename K, typename V, typename H>
+    static void SerializeMap(Stream& s, boost::unordered_map<K, V, H>& m, int nType, int nVersion, CSerActionSerialize ser_action)
+    {
+        WriteCompactSize(s, m.size());
+        for(typename boost::unordered_map<K, V, H>::const_iterator it = m.begin(); it != m.end(); ++it) {
+            ::Serialize(s, it->first, nType, nVersion);
+            ::Serialize(s, it->second, nType, nVersion);
+        }
+    }
+
+    template <typename Stream, typename K, typename V, typename H>
+    static void SerializeMap(Stream& s, boost::unordered_map<K, V, H>& m, int nType, int nVersion, CSerActionUnserialize ser_action)
+    {
+        m.clear();
+        unsigned int nSize = ReadCompactSize(s);
+        for(unsigned int i = 0; i < nSize; i++) {
+            K key;
+            ::Unserialize(s, key, nType, nVersion);
+            ::Unserialize(s, m[key], nType, nVersion);
+        }
+    }
+
+    /// Refresh the best payee of a single block after it got a vote
+    void UpdateBestPayee(int nBlockHeight);
+    void RebuildBestPayees();
+    void RebuildScheduledPayees();
+    /// Number of blocks IsScheduled() looks at which have payee as their best payee, without nNotBlockHeight
+    int CountScheduled(const CScript& payee, int nScheduledCount, int nNotBlockHeight);
+
 public:
-    std::map<uint256, CEternitynodePaymentVote> mapEternitynodePaymentVotes;
+    typedef boost::unordered_map<uint256, CEternitynodePaymentVote, CCoinsKeyHasher> vote_m_t;
+    typedef boost::unordered_map<COutPoint, int, COutPointHasher> last_vote_m_t;
+
+    vote_m_t mapEternitynodePaymentVotes;
     std::map<int, CEternitynodeBlockPayees> mapEternitynodeBlocks;
-    std::map<COutPoint, int> mapEternitynodesLastVote;
+    last_vote_m_t mapEternitynodesLastVote;
 
-    CEternitynodePayments() : nStorageCoeff(1.25), nMinBlocksToStore(5000) {}
+    CEternitynodePayments() : nStorageCoeff(1.25), nMinBlocksToStore(5000), pCurrentBlockIndex(NULL), nScheduledHeight(-1) {}
 
     ADD_SERIALIZE_METHODS;
 
     template <typename Stream, typename Operation>
     inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
-        READWRITE(mapEternitynodePaymentVotes);
+        // writes can come from the cache snapshot thread while votes keep coming in
+        LOCK2(cs_mapEternitynodeBlocks, cs_mapEternitynodePaymentVotes);
+        LOCK(cs_vecPayees);
+        SerializeMap(s, mapEternitynodePaymentVotes, nType, nVersion, ser_action);
         READWRITE(mapEternitynodeBlocks);
+        if(ser_action.ForRead()) {
+            RebuildBestPayees();
+            RebuildVoteHashesByHeight();
+        }
     }
 
     void Clear();
@@ -203,6 +264,8 @@ public:
     bool GetBlockPayee(int nBlockHeight, CScript& payee);
     bool IsTransactionValid(const CTransaction& txNew, int nBlockHeight);
     bool IsScheduled(CEternitynode& mn, int nNotBlockHeight);
+    /// Collect best payees of the next 8 blocks except nNotBlockHeight, i.e. everyone IsScheduled() would return true for
+    void GetScheduledPayees(int nNotBlockHeight, std::set<CScript>& setPayeesRet);
 
     bool CanVote(COutPoint outEternitynode, int nBlockHeight);
 
@@ -214,6 +277,8 @@ public:
 
     int GetBlockCount() { return mapEternitynodeBlocks.size(); }
     int GetVoteCount() { return mapEternitynodePaymentVotes.size(); }
+    /// Approximate memory used by payment votes and blocks in bytes
+    size_t GetMemoryUsage();
 
     bool IsEnoughData();
     int GetStorageLimit();
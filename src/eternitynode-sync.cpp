@@ -132,6 +132,7 @@ void CEternitynodeSync::Reset()
 {
     nRequestedEternitynodeAssets = ETERNITYNODE_SYNC_INITIAL;
     nRequestedEternitynodeAttempt = 0;
+    ClearListPartitions();
     nTimeAssetSyncStarted = GetTime();
     nTimeLastEternitynodeList = GetTime();
     nTimeLastPaymentVote = GetTime();
@@ -169,6 +170,7 @@ void CEternitynodeSync::SwitchToNextAsset()
             break;
         case(ETERNITYNODE_SYNC_SPORKS):
             nTimeLastEternitynodeList = GetTime();
+            ClearListPartitions();
             nRequestedEternitynodeAssets = ETERNITYNODE_SYNC_LIST;
             LogPrintf("CEternitynodeSync::SwitchToNextAsset -- Starting %s\n", GetAssetName());
             break;
@@ -228,6 +230,77 @@ void CEternitynodeSync::ProcessMessage(CNode* pfrom, std::string& strCommand, CD
         vRecv >> nItemID >> nCount;
 
         LogPrintf("SYNCSTATUSCOUNT -- got inventory count: nItemID=%d  nCount=%d  peer=%d\n", nItemID, nCount, pfrom->id);
+
+        if(nItemID == ETERNITYNODE_SYNC_LIST && nRequestedEternitynodeAssets == ETERNITYNODE_SYNC_LIST) {
+            // the invs can still be on their way, CheckListPartitions waits for them
+            LOCK(cs_partitions);
+            std::map<NodeId, list_partition_request_t>::iterator it = mapListPartitionRequests.find(pfrom->id);
+            if(it != mapListPartitionRequests.end()) {
+                it->second.nCount = nCount;
+                it->second.nTimeLastReply = GetTime();
+            }
+        }
+    }
+}
+
+void CEternitynodeSync::AddedEternitynodeListInv(NodeId nodeid, const CInv& inv)
+{
+    if(inv.type != MSG_ETERNITYNODE_PING || nRequestedEternitynodeAssets != ETERNITYNODE_SYNC_LIST) return;
+
+    LOCK(cs_partitions);
+    std::map<NodeId, list_partition_request_t>::iterator it = mapListPartitionRequests.find(nodeid);
+    if(it != mapListPartitionRequests.end()) {
+        it->second.setPingHashes.insert(inv.hash);
+        it->second.nTimeLastReply = GetTime();
+    }
+}
+
+void CEternitynodeSync::ClearListPartitions()
+{
+    LOCK(cs_partitions);
+    nListPartitionRequests = 0;
+    mapListPartitionRequests.clear();
+    setListPartitionsServed.clear();
+    nTimeLastListPartitionServed = 0;
+}
+
+void CEternitynodeSync::CheckListPartitions()
+{
+    // A partition is served once the peer's count arrived, all of its invs arrived (or it went quiet, the
+    // peer doesn't announce what it thinks we know) and every ping it announced was actually received.
+    std::map<NodeId, std::set<uint256> > mapPending;
+    {
+        LOCK(cs_partitions);
+        for(std::map<NodeId, list_partition_request_t>::iterator it = mapListPartitionRequests.begin(); it != mapListPartitionRequests.end(); ++it) {
+            const list_partition_request_t& request = it->second;
+            if(request.nCount < 0) continue;
+            if((int)request.setPingHashes.size() < request.nCount &&
+                request.nTimeLastReply >= GetTime() - ETERNITYNODE_SYNC_LIST_SETTLE_SECONDS) continue;
+            mapPending[it->first] = request.setPingHashes;
+        }
+    }
+
+    std::vector<NodeId> vecServed;
+    for(std::map<NodeId, std::set<uint256> >::iterator it = mapPending.begin(); it != mapPending.end(); ++it) {
+        bool fReceived = true;
+        BOOST_FOREACH(const uint256& nHash, it->second) {
+            if(!mnodeman.HasSeenPing(nHash)) {
+                fReceived = false;
+                break;
+            }
+        }
+        if(fReceived) vecServed.push_back(it->first);
+    }
+    if(vecServed.empty()) return;
+
+    LOCK(cs_partitions);
+    BOOST_FOREACH(NodeId nodeid, vecServed) {
+        std::map<NodeId, list_partition_request_t>::iterator it = mapListPartitionRequests.find(nodeid);
+        if(it == mapListPartitionRequests.end()) continue;
+        LogPrint("eternitynode", "CEternitynodeSync::CheckListPartitions -- partition %d received from peer %d\n", it->second.nPartition, nodeid);
+        setListPartitionsServed.insert(it->second.nPartition);
+        mapListPartitionRequests.erase(it);
+        nTimeLastListPartitionServed = GetTime();
     }
 }
 
@@ -374,6 +447,21 @@ void CEternitynodeSync::ProcessTick()
                     return;
                 }
 
+                // every part of the list was diffed against some peer and nothing new came in since
+                CheckListPartitions();
+                bool fListPartitionsServed = false;
+                {
+                    LOCK(cs_partitions);
+                    fListPartitionsServed = (int)setListPartitionsServed.size() == ETERNITYNODE_SYNC_LIST_PARTITIONS &&
+                        std::max(nTimeLastEternitynodeList, nTimeLastListPartitionServed) < GetTime() - ETERNITYNODE_SYNC_LIST_SETTLE_SECONDS;
+                }
+                if(fListPartitionsServed) {
+                    LogPrintf("CEternitynodeSync::ProcessTick -- nTick %d nRequestedEternitynodeAssets %d -- all list partitions synced\n", nTick, nRequestedEternitynodeAssets);
+                    SwitchToNextAsset();
+                    ReleaseNodeVector(vNodesCopy);
+                    return;
+                }
+
                 // only request once from each peer
                 if(netfulfilledman.HasFulfilledRequest(pnode->addr, "eternitynode-list-sync")) continue;
                 netfulfilledman.AddFulfilledRequest(pnode->addr, "eternitynode-list-sync");
@@ -381,6 +469,25 @@ void CEternitynodeSync::ProcessTick()
                 if (pnode->nVersion < enpayments.GetMinEternitynodePaymentsProto()) continue;
                 nRequestedEternitynodeAttempt++;
 
+                if (pnode->nVersion >= MIN_ETERNITYNODE_DSEGDIFF_PROTO_VERSION) {
+                    // peers only send what differs from our list, ask several of them for different parts at once
+                    int nPartition;
+                    {
+                        LOCK(cs_partitions);
+                        nPartition = nListPartitionRequests % ETERNITYNODE_SYNC_LIST_PARTITIONS;
+                        // register before asking, the reply can come in before DsegUpdate returns
+                        mapListPartitionRequests[pnode->id] = list_partition_request_t(nPartition);
+                    }
+                    bool fRequested = mnodeman.DsegUpdate(pnode, nPartition, ETERNITYNODE_SYNC_LIST_PARTITIONS);
+                    LOCK(cs_partitions);
+                    if(fRequested) {
+                        nListPartitionRequests++;
+                    } else {
+                        mapListPartitionRequests.erase(pnode->id);
+                    }
+                    continue;
+                }
+
                 mnodeman.DsegUpdate(pnode);
 
                 ReleaseNodeVector(vNodesCopy);
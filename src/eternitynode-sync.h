@@ -26,6 +26,9 @@ static const int ETERNITYNODE_SYNC_TIMEOUT_SECONDS = 30; // our blocks are 2.5 m
 
 static const int ETERNITYNODE_SYNC_ENOUGH_PEERS    = 6;
 
+static const int ETERNITYNODE_SYNC_LIST_PARTITIONS     = 4; // ask that many peers for a part of the eternitynode list each at once
+static const int ETERNITYNODE_SYNC_LIST_SETTLE_SECONDS = 2 * ETERNITYNODE_SYNC_TICK_SECONDS; // wait for the invs of the last part
+
 extern CEternitynodeSync eternitynodeSync;
 
 //
@@ -53,12 +56,37 @@ private:
     // How many times we failed
     int nCountFailures;
 
+    // A part of the eternitynode list requested from a peer, the pings it announced for it and the count it reported
+    struct list_partition_request_t {
+        int nPartition;
+        int nCount;
+        std::set<uint256> setPingHashes;
+        int64_t nTimeLastReply;
+
+        list_partition_request_t(int nPartitionIn = 0)
+            : nPartition(nPartitionIn),
+              nCount(-1),
+              setPingHashes(),
+              nTimeLastReply(GetTime())
+        {}
+    };
+
+    // Eternitynode list partitions we asked peers for, the ones we received completely and when the last one was.
+    // Changed from the message handler thread as well as from ProcessTick, always hold cs_partitions.
+    CCriticalSection cs_partitions;
+    int nListPartitionRequests;
+    std::map<NodeId, list_partition_request_t> mapListPartitionRequests;
+    std::set<int> setListPartitionsServed;
+    int64_t nTimeLastListPartitionServed;
+
     // Keep track of current block index
     const CBlockIndex *pCurrentBlockIndex;
 
     bool CheckNodeHeight(CNode* pnode, bool fDisconnectStuckNodes = false);
     void Fail();
     void ClearFulfilledRequests();
+    void ClearListPartitions();
+    void CheckListPartitions();
 
 public:
     CEternitynodeSync() { Reset(); }
@@ -66,6 +94,7 @@ public:
     void AddedEternitynodeList() { nTimeLastEternitynodeList = GetTime(); }
     void AddedPaymentVote() { nTimeLastPaymentVote = GetTime(); }
     void AddedGovernanceItem() { nTimeLastGovernanceItem = GetTime(); };
+    void AddedEternitynodeListInv(NodeId nodeid, const CInv& inv);
 
     void SendGovernanceSyncRequest(CNode* pnode);
 
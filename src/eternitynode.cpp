@@ -17,6 +17,8 @@
 
 
 CEternitynode::CEternitynode() :
+    fListChanged(false),
+    nBlockLastPaidScanned(0),
     vin(),
     addr(),
     pubKeyCollateralAddress(),
@@ -39,6 +41,8 @@ CEternitynode::CEternitynode() :
 {}
 
 CEternitynode::CEternitynode(CService addrNew, CTxIn vinNew, CPubKey pubKeyCollateralAddressNew, CPubKey pubKeyEternitynodeNew, int nProtocolVersionIn) :
+    fListChanged(false),
+    nBlockLastPaidScanned(0),
     vin(vinNew),
     addr(addrNew),
     pubKeyCollateralAddress(pubKeyCollateralAddressNew),
@@ -61,6 +65,8 @@ CEternitynode::CEternitynode(CService addrNew, CTxIn vinNew, CPubKey pubKeyColla
 {}
 
 CEternitynode::CEternitynode(const CEternitynode& other) :
+    fListChanged(false),
+    nBlockLastPaidScanned(other.nBlockLastPaidScanned),
     vin(other.vin),
     addr(other.addr),
     pubKeyCollateralAddress(other.pubKeyCollateralAddress),
@@ -83,6 +89,8 @@ CEternitynode::CEternitynode(const CEternitynode& other) :
 {}
 
 CEternitynode::CEternitynode(const CEternitynodeBroadcast& mnb) :
+    fListChanged(false),
+    nBlockLastPaidScanned(0),
     vin(mnb.vin),
     addr(mnb.addr),
     pubKeyCollateralAddress(mnb.pubKeyCollateralAddress),
@@ -107,6 +115,12 @@ CEternitynode::CEternitynode(const CEternitynodeBroadcast& mnb) :
 //
 // When a new eternitynode broadcast is sent, update our information
 //
+void CEternitynode::SetStateChanged()
+{
+    fListChanged = true;
+    mnodeman.SetStateChanged();
+}
+
 bool CEternitynode::UpdateFromNewBroadcast(CEternitynodeBroadcast& mnb)
 {
     if(mnb.sigTime <= sigTime && !mnb.fRecovery) return false;
@@ -119,9 +133,10 @@ bool CEternitynode::UpdateFromNewBroadcast(CEternitynodeBroadcast& mnb)
     nPoSeBanScore = 0;
     nPoSeBanHeight = 0;
     nTimeLastChecked = 0;
+    SetStateChanged();
     int nDos = 0;
     if(mnb.lastPing == CEternitynodePing() || (mnb.lastPing != CEternitynodePing() && mnb.lastPing.CheckAndUpdate(this, true, nDos))) {
-        lastPing = mnb.lastPing;
+        SetLastPing(mnb.lastPing);
         mnodeman.mapSeenEternitynodePing.insert(std::make_pair(lastPing.GetHash(), lastPing));
     }
     // if it matches our Eternitynode privkey...
@@ -169,6 +184,7 @@ void CEternitynode::Check(bool fForce)
 
     if(!fForce && (GetTime() - nTimeLastChecked < ETERNITYNODE_CHECK_SECONDS)) return;
     nTimeLastChecked = GetTime();
+    fListChanged = true;
 
     LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state\n", vin.prevout.ToStringShort(), GetStateString());
 
@@ -184,7 +200,7 @@ void CEternitynode::Check(bool fForce)
         if(!pcoinsTip->GetCoins(vin.prevout.hash, coins) ||
            (unsigned int)vin.prevout.n>=coins.vout.size() ||
            coins.vout[vin.prevout.n].IsNull()) {
-            nActiveState = ETERNITYNODE_OUTPOINT_SPENT;
+            SetActiveState(ETERNITYNODE_OUTPOINT_SPENT);
             LogPrint("eternitynode", "CEternitynode::Check -- Failed to find Eternitynode UTXO, eternitynode=%s\n", vin.prevout.ToStringShort());
             return;
         }
@@ -200,7 +216,7 @@ void CEternitynode::Check(bool fForce)
         LogPrintf("CEternitynode::Check -- Eternitynode %s is unbanned and back in list now\n", vin.prevout.ToStringShort());
         DecreasePoSeBanScore();
     } else if(nPoSeBanScore >= ETERNITYNODE_POSE_BAN_MAX_SCORE) {
-        nActiveState = ETERNITYNODE_POSE_BAN;
+        SetActiveState(ETERNITYNODE_POSE_BAN);
         // ban for the whole payment cycle
         nPoSeBanHeight = nHeight + mnodeman.size();
         LogPrintf("CEternitynode::Check -- Eternitynode %s is banned till block %d now\n", vin.prevout.ToStringShort(), nPoSeBanHeight);
@@ -216,7 +232,7 @@ void CEternitynode::Check(bool fForce)
                    (fOurEternitynode && nProtocolVersion < PROTOCOL_VERSION);
 
     if(fRequireUpdate) {
-        nActiveState = ETERNITYNODE_UPDATE_REQUIRED;
+        SetActiveState(ETERNITYNODE_UPDATE_REQUIRED);
         if(nActiveStatePrev != nActiveState) {
             LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
         }
@@ -238,7 +254,7 @@ void CEternitynode::Check(bool fForce)
     if(!fWaitForPing || fOurEternitynode) {
 
         if(!IsPingedWithin(ETERNITYNODE_NEW_START_REQUIRED_SECONDS)) {
-            nActiveState = ETERNITYNODE_NEW_START_REQUIRED;
+            SetActiveState(ETERNITYNODE_NEW_START_REQUIRED);
             if(nActiveStatePrev != nActiveState) {
                 LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
             }
@@ -252,7 +268,7 @@ void CEternitynode::Check(bool fForce)
                 vin.prevout.ToStringShort(), nTimeLastWatchdogVote, GetTime(), fWatchdogExpired);
 
         if(fWatchdogExpired) {
-            nActiveState = ETERNITYNODE_WATCHDOG_EXPIRED;
+            SetActiveState(ETERNITYNODE_WATCHDOG_EXPIRED);
             if(nActiveStatePrev != nActiveState) {
                 LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
             }
@@ -260,7 +276,7 @@ void CEternitynode::Check(bool fForce)
         }
 
         if(!IsPingedWithin(ETERNITYNODE_EXPIRATION_SECONDS)) {
-            nActiveState = ETERNITYNODE_EXPIRED;
+            SetActiveState(ETERNITYNODE_EXPIRED);
             if(nActiveStatePrev != nActiveState) {
                 LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
             }
@@ -269,14 +285,14 @@ void CEternitynode::Check(bool fForce)
     }
 
     if(lastPing.sigTime - sigTime < ETERNITYNODE_MIN_MNP_SECONDS) {
-        nActiveState = ETERNITYNODE_PRE_ENABLED;
+        SetActiveState(ETERNITYNODE_PRE_ENABLED);
         if(nActiveStatePrev != nActiveState) {
             LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
         }
         return;
     }
 
-    nActiveState = ETERNITYNODE_ENABLED; // OK
+    SetActiveState(ETERNITYNODE_ENABLED); // OK
     if(nActiveStatePrev != nActiveState) {
         LogPrint("eternitynode", "CEternitynode::Check -- Eternitynode %s is in %s state now\n", vin.prevout.ToStringShort(), GetStateString());
     }
@@ -353,6 +369,7 @@ int CEternitynode::GetCollateralAge()
         int nInputAge = GetInputAge(vin);
         if(nInputAge > 0) {
             nCacheCollateralBlock = nHeight - nInputAge;
+            fListChanged = true;
         } else {
             return nInputAge;
         }
@@ -365,17 +382,39 @@ void CEternitynode::UpdateLastPaid(const CBlockIndex *pindex, int nMaxBlocksToSc
 {
     if(!pindex) return;
 
-    const CBlockIndex *BlockReading = pindex;
-
     CScript mnpayee = GetScriptForDestination(pubKeyCollateralAddress.GetID());
     // LogPrint("eternitynode", "CEternitynode::UpdateLastPaidBlock -- searching for block with payment to %s\n", vin.prevout.ToStringShort());
 
+    // Latest payment to this eternitynode is taken from the payment index which is filled
+    // from connected blocks, no need to read blocks from disk here
+    CEternitynodeLastPayment payment;
+    if(!mnodeman.GetLastPayment(mnpayee, pindex, nMaxBlocksToScanBack, payment) || payment.nHeight <= nBlockLastPaid) {
+        // LogPrint("eternitynode", "CEternitynode::UpdateLastPaidBlock -- searching for block with payment to %s -- keeping old %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
+        return;
+    }
+
     LOCK(cs_mapEternitynodeBlocks);
 
-    for (int i = 0; BlockReading && BlockReading->nHeight > nBlockLastPaid && i < nMaxBlocksToScanBack; i++) {
-        if(enpayments.mapEternitynodeBlocks.count(BlockReading->nHeight) &&
-            enpayments.mapEternitynodeBlocks[BlockReading->nHeight].HasPayeeWithVotes(mnpayee, 2))
-        {
+    std::map<int, CEternitynodeBlockPayees>::iterator it = enpayments.mapEternitynodeBlocks.find(payment.nHeight);
+    if(it != enpayments.mapEternitynodeBlocks.end() && it->second.HasPayeeWithVotes(mnpayee, 2)) {
+        nBlockLastPaid = payment.nHeight;
+        nTimeLastPaid = payment.nTime;
+        fListChanged = true;
+        LogPrint("eternitynode", "CEternitynode::UpdateLastPaidBlock -- searching for block with payment to %s -- found new %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
+        return;
+    }
+
+    // Latest payment for this eternitynode wasn't found in latest enpayments blocks (or didn't have enough votes),
+    // an older one still could have been, the index only keeps the latest one so scan back from the block below it.
+    // Blocks scanned for an earlier call didn't pay us and won't start to, each one is read at most once.
+    const CBlockIndex *BlockReading = pindex->GetAncestor(payment.nHeight - 1);
+    int nBlocksLeft = nMaxBlocksToScanBack - (pindex->nHeight - payment.nHeight + 1);
+    int nScanStop = std::max(nBlockLastPaid, nBlockLastPaidScanned);
+    nBlockLastPaidScanned = std::max(nBlockLastPaidScanned, payment.nHeight - 1);
+
+    for (int i = 0; BlockReading && BlockReading->nHeight > nScanStop && i < nBlocksLeft; i++) {
+        it = enpayments.mapEternitynodeBlocks.find(BlockReading->nHeight);
+        if(it != enpayments.mapEternitynodeBlocks.end() && it->second.HasPayeeWithVotes(mnpayee, 2)) {
             CBlock block;
             if(!ReadBlockFromDisk(block, BlockReading, Params().GetConsensus())) // shouldn't really happen
                 continue;
@@ -386,6 +425,7 @@ void CEternitynode::UpdateLastPaid(const CBlockIndex *pindex, int nMaxBlocksToSc
                 if(mnpayee == txout.scriptPubKey && nEternitynodePayment == txout.nValue) {
                     nBlockLastPaid = BlockReading->nHeight;
                     nTimeLastPaid = BlockReading->nTime;
+                    fListChanged = true;
                     LogPrint("eternitynode", "CEternitynode::UpdateLastPaidBlock -- searching for block with payment to %s -- found new %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
                     return;
                 }
@@ -503,7 +543,7 @@ bool CEternitynodeBroadcast::SimpleCheck(int& nDos)
     // empty ping or incorrect sigTime/unknown blockhash
     if(lastPing == CEternitynodePing() || !lastPing.SimpleCheck(nDos)) {
         // one of us is probably forked or smth, just mark it as expired and check the rest of the rules
-        nActiveState = ETERNITYNODE_EXPIRED;
+        SetActiveState(ETERNITYNODE_EXPIRED);
     }
 
     if(nProtocolVersion < enpayments.GetMinEternitynodePaymentsProto()) {
@@ -669,6 +709,13 @@ bool CEternitynodeBroadcast::CheckOutpoint(int& nDos)
     return true;
 }
 
+std::string CEternitynodeBroadcast::GetSignatureMessage() const
+{
+    return addr.ToString(false) + boost::lexical_cast<std::string>(sigTime) +
+            pubKeyCollateralAddress.GetID().ToString() + pubKeyEternitynode.GetID().ToString() +
+            boost::lexical_cast<std::string>(nProtocolVersion);
+}
+
 bool CEternitynodeBroadcast::Sign(CKey& keyCollateralAddress)
 {
     std::string strError;
@@ -676,9 +723,7 @@ bool CEternitynodeBroadcast::Sign(CKey& keyCollateralAddress)
 
     sigTime = GetAdjustedTime();
 
-    strMessage = addr.ToString(false) + boost::lexical_cast<std::string>(sigTime) +
-                    pubKeyCollateralAddress.GetID().ToString() + pubKeyEternitynode.GetID().ToString() +
-                    boost::lexical_cast<std::string>(nProtocolVersion);
+    strMessage = GetSignatureMessage();
 
     if(!spySendSigner.SignMessage(strMessage, vchSig, keyCollateralAddress)) {
         LogPrintf("CEternitynodeBroadcast::Sign -- SignMessage() failed\n");
@@ -699,9 +744,7 @@ bool CEternitynodeBroadcast::CheckSignature(int& nDos)
     std::string strError = "";
     nDos = 0;
 
-    strMessage = addr.ToString(false) + boost::lexical_cast<std::string>(sigTime) +
-                    pubKeyCollateralAddress.GetID().ToString() + pubKeyEternitynode.GetID().ToString() +
-                    boost::lexical_cast<std::string>(nProtocolVersion);
+    strMessage = GetSignatureMessage();
 
     LogPrint("eternitynode", "CEternitynodeBroadcast::CheckSignature -- strMessage: %s  pubKeyCollateralAddress address: %s  sig: %s\n", strMessage, CBitcoinAddress(pubKeyCollateralAddress.GetID()).ToString(), EncodeBase64(&vchSig[0], vchSig.size()));
 
@@ -731,13 +774,18 @@ CEternitynodePing::CEternitynodePing(CTxIn& vinNew)
     vchSig = std::vector<unsigned char>();
 }
 
+std::string CEternitynodePing::GetSignatureMessage() const
+{
+    return vin.ToString() + blockHash.ToString() + boost::lexical_cast<std::string>(sigTime);
+}
+
 bool CEternitynodePing::Sign(CKey& keyEternitynode, CPubKey& pubKeyEternitynode)
 {
     std::string strError;
     std::string strEternityNodeSignMessage;
 
     sigTime = GetAdjustedTime();
-    std::string strMessage = vin.ToString() + blockHash.ToString() + boost::lexical_cast<std::string>(sigTime);
+    std::string strMessage = GetSignatureMessage();
 
     if(!spySendSigner.SignMessage(strMessage, vchSig, keyEternitynode)) {
         LogPrintf("CEternitynodePing::Sign -- SignMessage() failed\n");
@@ -754,7 +802,7 @@ bool CEternitynodePing::Sign(CKey& keyEternitynode, CPubKey& pubKeyEternitynode)
 
 bool CEternitynodePing::CheckSignature(CPubKey& pubKeyEternitynode, int &nDos)
 {
-    std::string strMessage = vin.ToString() + blockHash.ToString() + boost::lexical_cast<std::string>(sigTime);
+    std::string strMessage = GetSignatureMessage();
     std::string strError = "";
     nDos = 0;
 
@@ -852,7 +900,7 @@ bool CEternitynodePing::CheckAndUpdate(CEternitynode* pmn, bool fFromNewBroadcas
 
     // let's store this ping as the last one
     LogPrint("eternitynode", "CEternitynodePing::CheckAndUpdate -- Eternitynode ping accepted, eternitynode=%s\n", vin.prevout.ToStringShort());
-    pmn->lastPing = *this;
+    pmn->SetLastPing(*this);
 
     // and update mnodeman.mapSeenEternitynodeBroadcast.lastPing which is probably outdated
     CEternitynodeBroadcast mnb(*pmn);
@@ -883,6 +931,7 @@ void CEternitynode::AddGovernanceVote(uint256 nGovernanceObjectHash)
     } else {
         mapGovernanceObjectsVotedOn.insert(std::make_pair(nGovernanceObjectHash, 1));
     }
+    fListChanged = true;
 }
 
 void CEternitynode::RemoveGovernanceObject(uint256 nGovernanceObjectHash)
@@ -892,12 +941,14 @@ void CEternitynode::RemoveGovernanceObject(uint256 nGovernanceObjectHash)
         return;
     }
     mapGovernanceObjectsVotedOn.erase(it);
+    fListChanged = true;
 }
 
 void CEternitynode::UpdateWatchdogVoteTime()
 {
     LOCK(cs);
     nTimeLastWatchdogVote = GetTime();
+    fListChanged = true;
 }
 
 /**
@@ -78,6 +78,8 @@ public:
 
     bool IsExpired() { return GetTime() - sigTime > ETERNITYNODE_NEW_START_REQUIRED_SECONDS; }
 
+    /// The message covered by vchSig
+    std::string GetSignatureMessage() const;
     bool Sign(CKey& keyEternitynode, CPubKey& pubKeyEternitynode);
     bool CheckSignature(CPubKey& pubKeyEternitynode, int &nDos);
     bool SimpleCheck(int& nDos);
@@ -143,6 +145,11 @@ private:
     // critical section to protect the inner data structures
     mutable CCriticalSection cs;
 
+    // changed since CEternitynodeMan last published the list, not serialized
+    bool fListChanged;
+    // blocks up to this height were already read from disk by UpdateLastPaid, not serialized
+    int nBlockLastPaidScanned;
+
 public:
     enum state {
         ETERNITYNODE_PRE_ENABLED,
@@ -231,6 +238,7 @@ public:
         swap(first.nActiveState, second.nActiveState);
         swap(first.nCacheCollateralBlock, second.nCacheCollateralBlock);
         swap(first.nBlockLastPaid, second.nBlockLastPaid);
+        swap(first.nBlockLastPaidScanned, second.nBlockLastPaidScanned);
         swap(first.nProtocolVersion, second.nProtocolVersion);
         swap(first.nPoSeBanScore, second.nPoSeBanScore);
         swap(first.nPoSeBanHeight, second.nPoSeBanHeight);
@@ -239,6 +247,12 @@ public:
         swap(first.mapGovernanceObjectsVotedOn, second.mapGovernanceObjectsVotedOn);
     }
 
+private:
+    /// Active state or protocol version changed, ranks have to be calculated again (see CEternitynodeMan::SetStateChanged())
+    void SetStateChanged();
+
+public:
+
     // CALCULATE A RANK AGAINST OF GIVEN BLOCK
     arith_uint256 CalculateScore(const uint256& blockHash);
 
@@ -258,16 +272,35 @@ public:
         return nTimeToCheckAt - lastPing.sigTime < nSeconds;
     }
 
-    bool IsEnabled() { return nActiveState == ETERNITYNODE_ENABLED; }
-    bool IsPreEnabled() { return nActiveState == ETERNITYNODE_PRE_ENABLED; }
-    bool IsPoSeBanned() { return nActiveState == ETERNITYNODE_POSE_BAN; }
+    /// Set by everything that changes this eternitynode, copy it into the next list snapshot
+    bool IsListChanged() const { return fListChanged; }
+    void ClearListChanged() { fListChanged = false; }
+
+    void SetActiveState(int nActiveStateIn)
+    {
+        if(nActiveState == nActiveStateIn) return;
+        nActiveState = nActiveStateIn;
+        SetStateChanged();
+    }
+    void SetLastPing(const CEternitynodePing& mnp) { lastPing = mnp; fListChanged = true; }
+    void SetLastDsq(int64_t nLastDsqIn) { nLastDsq = nLastDsqIn; fListChanged = true; }
+    void SetAllowMixingTx(bool fAllowMixingTxIn)
+    {
+        if(fAllowMixingTx == fAllowMixingTxIn) return;
+        fAllowMixingTx = fAllowMixingTxIn;
+        fListChanged = true;
+    }
+
+    bool IsEnabled() const { return nActiveState == ETERNITYNODE_ENABLED; }
+    bool IsPreEnabled() const { return nActiveState == ETERNITYNODE_PRE_ENABLED; }
+    bool IsPoSeBanned() const { return nActiveState == ETERNITYNODE_POSE_BAN; }
     // NOTE: this one relies on nPoSeBanScore, not on nActiveState as everything else here
-    bool IsPoSeVerified() { return nPoSeBanScore <= -ETERNITYNODE_POSE_BAN_MAX_SCORE; }
-    bool IsExpired() { return nActiveState == ETERNITYNODE_EXPIRED; }
-    bool IsOutpointSpent() { return nActiveState == ETERNITYNODE_OUTPOINT_SPENT; }
-    bool IsUpdateRequired() { return nActiveState == ETERNITYNODE_UPDATE_REQUIRED; }
-    bool IsWatchdogExpired() { return nActiveState == ETERNITYNODE_WATCHDOG_EXPIRED; }
-    bool IsNewStartRequired() { return nActiveState == ETERNITYNODE_NEW_START_REQUIRED; }
+    bool IsPoSeVerified() const { return nPoSeBanScore <= -ETERNITYNODE_POSE_BAN_MAX_SCORE; }
+    bool IsExpired() const { return nActiveState == ETERNITYNODE_EXPIRED; }
+    bool IsOutpointSpent() const { return nActiveState == ETERNITYNODE_OUTPOINT_SPENT; }
+    bool IsUpdateRequired() const { return nActiveState == ETERNITYNODE_UPDATE_REQUIRED; }
+    bool IsWatchdogExpired() const { return nActiveState == ETERNITYNODE_WATCHDOG_EXPIRED; }
+    bool IsNewStartRequired() const { return nActiveState == ETERNITYNODE_NEW_START_REQUIRED; }
 
     static bool IsValidStateForAutoStart(int nActiveStateIn)
     {
@@ -293,8 +326,8 @@ public:
     bool IsValidNetAddr();
     static bool IsValidNetAddr(CService addrIn);
 
-    void IncreasePoSeBanScore() { if(nPoSeBanScore < ETERNITYNODE_POSE_BAN_MAX_SCORE) nPoSeBanScore++; }
-    void DecreasePoSeBanScore() { if(nPoSeBanScore > -ETERNITYNODE_POSE_BAN_MAX_SCORE) nPoSeBanScore--; }
+    void IncreasePoSeBanScore() { if(nPoSeBanScore < ETERNITYNODE_POSE_BAN_MAX_SCORE) { nPoSeBanScore++; fListChanged = true; } }
+    void DecreasePoSeBanScore() { if(nPoSeBanScore > -ETERNITYNODE_POSE_BAN_MAX_SCORE) { nPoSeBanScore--; fListChanged = true; } }
 
     eternitynode_info_t GetInfo();
 
@@ -304,8 +337,8 @@ public:
 
     int GetCollateralAge();
 
-    int GetLastPaidTime() { return nTimeLastPaid; }
-    int GetLastPaidBlock() { return nBlockLastPaid; }
+    int GetLastPaidTime() const { return nTimeLastPaid; }
+    int GetLastPaidBlock() const { return nBlockLastPaid; }
     void UpdateLastPaid(const CBlockIndex *pindex, int nMaxBlocksToScanBack);
 
     // KEEP TRACK OF EACH GOVERNANCE ITEM INCASE THIS NODE GOES OFFLINE, SO WE CAN RECALC THEIR STATUS
@@ -320,6 +353,7 @@ public:
     CEternitynode& operator=(CEternitynode from)
     {
         swap(*this, from);
+        SetStateChanged();
         return *this;
     }
     friend bool operator==(const CEternitynode& a, const CEternitynode& b)
@@ -380,6 +414,8 @@ public:
     bool Update(CEternitynode* pmn, int& nDos);
     bool CheckOutpoint(int& nDos);
 
+    /// The message covered by vchSig
+    std::string GetSignatureMessage() const;
     bool Sign(CKey& keyCollateralAddress);
     bool CheckSignature(int& nDos);
     void Relay();
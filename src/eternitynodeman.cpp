@@ -15,16 +15,7 @@
 /** Eternitynode manager */
 CEternitynodeMan mnodeman;
 
-const std::string CEternitynodeMan::SERIALIZATION_VERSION_STRING = "CEternitynodeMan-Version-4";
-
-struct CompareLastPaidBlock
-{
-    bool operator()(const std::pair<int, CEternitynode*>& t1,
-                    const std::pair<int, CEternitynode*>& t2) const
-    {
-        return (t1.first != t2.first) ? (t1.first < t2.first) : (t1.second->vin < t2.second->vin);
-    }
-};
+const std::string CEternitynodeMan::SERIALIZATION_VERSION_STRING = "CEternitynodeMan-Version-5";
 
 struct CompareScoreMN
 {
@@ -96,6 +87,121 @@ void CEternitynodeIndex::RebuildIndex()
     }
 }
 
+CEternitynodePaymentIndex::CEternitynodePaymentIndex()
+    : mapLastPayments(),
+      nFirstHeight(-1),
+      nLastHeight(-1)
+{}
+
+void CEternitynodePaymentIndex::AddBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    if(block.vtx.empty()) return;
+
+    // when scanning back, newer payments which are already indexed take precedence,
+    // otherwise the block is the new tip and anything indexed at or above its height was disconnected
+    bool fScanBack = pindex->nHeight == nFirstHeight - 1;
+
+    if(fScanBack) {
+        nFirstHeight = pindex->nHeight;
+    } else if(nFirstHeight >= 0 && pindex->nHeight >= nFirstHeight && pindex->nHeight <= nLastHeight + 1) {
+        nLastHeight = pindex->nHeight;
+    } else {
+        // empty index or a gap, start over from this block
+        nFirstHeight = nLastHeight = pindex->nHeight;
+    }
+
+    CAmount nEternitynodePayment = GetEternitynodePayment(pindex->nHeight, block.vtx[0].GetValueOut());
+
+    BOOST_FOREACH(const CTxOut& txout, block.vtx[0].vout) {
+        if(txout.nValue != nEternitynodePayment) continue;
+        CScriptID payeeID(txout.scriptPubKey);
+        payment_m_it it = mapLastPayments.find(payeeID);
+        if(it == mapLastPayments.end()) {
+            mapLastPayments.insert(std::make_pair(payeeID, CEternitynodeLastPayment(pindex)));
+        } else if(!fScanBack || it->second.nHeight < pindex->nHeight) {
+            it->second = CEternitynodeLastPayment(pindex);
+        }
+    }
+}
+
+bool CEternitynodePaymentIndex::Get(const CScript& payee, const CBlockIndex* pindex, int nMaxBlocksToScanBack, CEternitynodeLastPayment& paymentRet) const
+{
+    payment_m_cit it = mapLastPayments.find(CScriptID(payee));
+    if(it == mapLastPayments.end()) return false;
+
+    const CEternitynodeLastPayment& payment = it->second;
+    if(payment.nHeight > pindex->nHeight || payment.nHeight <= pindex->nHeight - nMaxBlocksToScanBack) return false;
+
+    // make sure the payment wasn't reorganized away
+    const CBlockIndex* pindexPayment = pindex->GetAncestor(payment.nHeight);
+    if(!pindexPayment || pindexPayment->GetBlockHash() != payment.blockHash) return false;
+
+    paymentRet = payment;
+    return true;
+}
+
+bool CEternitynodePaymentIndex::Covers(const CBlockIndex* pindex, int nMaxBlocksToScanBack) const
+{
+    if(nFirstHeight < 0) return false;
+    return nLastHeight >= pindex->nHeight &&
+            nFirstHeight <= std::max(0, pindex->nHeight - nMaxBlocksToScanBack + 1);
+}
+
+void CEternitynodePaymentIndex::Prune(int nMinHeight)
+{
+    payment_m_it it = mapLastPayments.begin();
+    while(it != mapLastPayments.end()) {
+        if(it->second.nHeight < nMinHeight) {
+            mapLastPayments.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    if(nFirstHeight >= 0 && nFirstHeight < nMinHeight) {
+        nFirstHeight = std::min(nMinHeight, nLastHeight);
+    }
+}
+
+void CEternitynodePaymentIndex::Clear()
+{
+    mapLastPayments.clear();
+    nFirstHeight = -1;
+    nLastHeight = -1;
+}
+
+int CEternitynodeRankTable::GetRank(const COutPoint& outpoint) const
+{
+    rank_m_cit it = mapRanks.find(outpoint);
+    if(it == mapRanks.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+bool CEternitynodeRankTable::GetScore(const COutPoint& outpoint, arith_uint256& nScoreRet) const
+{
+    int nRank = GetRank(outpoint);
+    if(nRank == -1) {
+        return false;
+    }
+    nScoreRet = vecScores[nRank - 1];
+    return true;
+}
+
+/**
+ * Publishes a new eternitynode list snapshot when it goes out of scope,
+ * declared at the top of everything which changes the eternitynode list
+ */
+class CEternitynodeListUpdate
+{
+private:
+    CEternitynodeMan& man;
+
+public:
+    CEternitynodeListUpdate(CEternitynodeMan& manIn) : man(manIn) {}
+    ~CEternitynodeListUpdate() { man.PublishEternitynodeList(); }
+};
+
 CEternitynodeMan::CEternitynodeMan()
 : cs(),
   vEternitynodes(),
@@ -109,11 +215,28 @@ CEternitynodeMan::CEternitynodeMan()
   nLastIndexRebuildTime(0),
   indexEternitynodes(),
   indexEternitynodesOld(),
+  indexPayments(),
   fIndexRebuilt(false),
   fEternitynodesAdded(false),
   fEternitynodesRemoved(false),
   vecDirtyGovernanceObjectHashes(),
   nLastWatchdogVoteTime(0),
+  mapRankCache(),
+  listRankCacheKeys(),
+  nListVersion(0),
+  fStateChanged(false),
+  setPaymentQueue(),
+  nPaymentQueueEligible(0),
+  nPaymentQueueVersion(-1),
+  nPaymentQueueMinProtocol(0),
+  fPaymentQueueSentinelRequired(false),
+  listSnapshot(),
+  fListChangedAll(false),
+  fListPublishPending(false),
+  mapFindByOutpoint(),
+  mapFindByPubKey(),
+  mapFindByCollateral(),
+  fFindIndexesDirty(false),
   mapSeenEternitynodeBroadcast(),
   mapSeenEternitynodePing(),
   nDsqCount(0)
@@ -121,13 +244,18 @@ CEternitynodeMan::CEternitynodeMan()
 
 bool CEternitynodeMan::Add(CEternitynode &mn)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
 
     CEternitynode *pmn = Find(mn.vin);
     if (pmn == NULL) {
         LogPrint("eternitynode", "CEternitynodeMan::Add -- Adding new Eternitynode: addr=%s, %i now\n", mn.addr.ToString(), size() + 1);
         vEternitynodes.push_back(mn);
+        AddToFindIndexes(vEternitynodes.size() - 1);
         indexEternitynodes.AddEternitynodeVIN(mn.vin);
+        SetListChanged();
+        // vector could be reallocated, queue will be rebuilt on next use
+        setPaymentQueue.clear();
         fEternitynodesAdded = true;
         return true;
     }
@@ -166,6 +294,7 @@ void CEternitynodeMan::AskForEN(CNode* pnode, const CTxIn &vin)
 
 void CEternitynodeMan::Check()
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
 
     LogPrint("eternitynode", "CEternitynodeMan::Check -- nLastWatchdogVoteTime=%d, IsWatchdogActive()=%d\n", nLastWatchdogVoteTime, IsWatchdogActive());
@@ -177,6 +306,7 @@ void CEternitynodeMan::Check()
 
 void CEternitynodeMan::CheckAndRemove()
 {
+    CEternitynodeListUpdate listUpdate(*this);
     if(!eternitynodeSync.IsEternitynodeListSynced()) return;
 
     LogPrintf("CEternitynodeMan::CheckAndRemove\n");
@@ -190,7 +320,7 @@ void CEternitynodeMan::CheckAndRemove()
 
         // Remove spent eternitynodes, prepare structures and make requests to reasure the state of inactive ones
         std::vector<CEternitynode>::iterator it = vEternitynodes.begin();
-        std::vector<std::pair<int, CEternitynode> > vecEternitynodeRanks;
+        std::vector<std::pair<int, eternitynode_ptr_t> > vecEternitynodeRanks;
         // ask for up to MNB_RECOVERY_MAX_ASK_ENTRIES eternitynode entries at a time
         int nAskForMnbRecovery = MNB_RECOVERY_MAX_ASK_ENTRIES;
         while(it != vEternitynodes.end()) {
@@ -207,6 +337,10 @@ void CEternitynodeMan::CheckAndRemove()
                 // and finally remove it from the list
                 it->FlagGovernanceItemsAsDirty();
                 it = vEternitynodes.erase(it);
+                fListChangedAll = true;
+                SetListChanged();
+                fFindIndexesDirty = true;
+                setPaymentQueue.clear();
                 fEternitynodesRemoved = true;
             } else {
                 bool fAsk = pCurrentBlockIndex &&
@@ -226,9 +360,9 @@ void CEternitynodeMan::CheckAndRemove()
                     // ask first MNB_RECOVERY_QUORUM_TOTAL eternitynodes we can connect to and we haven't asked recently
                     for(int i = 0; setRequested.size() < MNB_RECOVERY_QUORUM_TOTAL && i < (int)vecEternitynodeRanks.size(); i++) {
                         // avoid banning
-                        if(mWeAskedForEternitynodeListEntry.count(it->vin.prevout) && mWeAskedForEternitynodeListEntry[it->vin.prevout].count(vecEternitynodeRanks[i].second.addr)) continue;
+                        if(mWeAskedForEternitynodeListEntry.count(it->vin.prevout) && mWeAskedForEternitynodeListEntry[it->vin.prevout].count(vecEternitynodeRanks[i].second->addr)) continue;
                         // didn't ask recently, ok to ask now
-                        CService addr = vecEternitynodeRanks[i].second.addr;
+                        CService addr = vecEternitynodeRanks[i].second->addr;
                         setRequested.insert(addr);
                         listScheduledMnbRequestConnections.push_back(std::make_pair(addr, hash));
                         fAskedForMnbRecovery = true;
@@ -365,8 +499,11 @@ void CEternitynodeMan::CheckAndRemove()
 
 void CEternitynodeMan::Clear()
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     vEternitynodes.clear();
+    fListChangedAll = true;
+    SetListChanged();
     mAskedUsForEternitynodeList.clear();
     mWeAskedForEternitynodeList.clear();
     mWeAskedForEternitynodeListEntry.clear();
@@ -376,6 +513,11 @@ void CEternitynodeMan::Clear()
     nLastWatchdogVoteTime = 0;
     indexEternitynodes.Clear();
     indexEternitynodesOld.Clear();
+    setPaymentQueue.clear();
+    mapFindByOutpoint.clear();
+    mapFindByPubKey.clear();
+    mapFindByCollateral.clear();
+    fFindIndexesDirty = false;
 }
 
 int CEternitynodeMan::CountEternitynodes(int nProtocolVersion)
@@ -423,7 +565,19 @@ int CEternitynodeMan::CountByIP(int nNetworkType)
 }
 */
 
-void CEternitynodeMan::DsegUpdate(CNode* pnode)
+uint64_t CEternitynodeMan::GetListDigest(const CEternitynode& mn)
+{
+    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
+    ss << mn.vin.prevout << mn.lastPing.GetHash();
+    return ss.GetHash().GetCheapHash();
+}
+
+int CEternitynodeMan::GetListPartition(const COutPoint& outpoint, int nPartitions)
+{
+    return (int)(outpoint.hash.GetCheapHash() % nPartitions);
+}
+
+bool CEternitynodeMan::DsegUpdate(CNode* pnode, int nPartition, int nPartitions)
 {
     LOCK(cs);
 
@@ -432,52 +586,97 @@ void CEternitynodeMan::DsegUpdate(CNode* pnode)
             std::map<CNetAddr, int64_t>::iterator it = mWeAskedForEternitynodeList.find(pnode->addr);
             if(it != mWeAskedForEternitynodeList.end() && GetTime() < (*it).second) {
                 LogPrintf("CEternitynodeMan::DsegUpdate -- we already asked %s for the list; skipping...\n", pnode->addr.ToString());
-                return;
+                return false;
             }
         }
     }
-    
-    pnode->PushMessage(NetMsgType::DSEG, CTxIn());
+
+    if(pnode->nVersion >= MIN_ETERNITYNODE_DSEGDIFF_PROTO_VERSION) {
+        // tell the peer what we have already, it only sends entries we don't know or have an older ping for
+        std::vector<uint64_t> vecDigests;
+        BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+            if(GetListPartition(mn.vin.prevout, nPartitions) != nPartition) continue;
+            vecDigests.push_back(GetListDigest(mn));
+        }
+        pnode->PushMessage(NetMsgType::DSEGDIFF, nPartition, nPartitions, vecDigests);
+        LogPrint("eternitynode", "CEternitynodeMan::DsegUpdate -- asked %s for the list diff, partition %d/%d, digests=%d\n",
+                    pnode->addr.ToString(), nPartition, nPartitions, vecDigests.size());
+    } else {
+        pnode->PushMessage(NetMsgType::DSEG, CTxIn());
+        LogPrint("eternitynode", "CEternitynodeMan::DsegUpdate -- asked %s for the list\n", pnode->addr.ToString());
+    }
     int64_t askAgain = GetTime() + DSEG_UPDATE_SECONDS;
     mWeAskedForEternitynodeList[pnode->addr] = askAgain;
 
-    LogPrint("eternitynode", "CEternitynodeMan::DsegUpdate -- asked %s for the list\n", pnode->addr.ToString());
+    return true;
+}
+
+void CEternitynodeMan::AddToFindIndexes(size_t nIndex)
+{
+    AssertLockHeld(cs);
+    // everything is going to be rebuilt anyway
+    if(fFindIndexesDirty) return;
+
+    const CEternitynode& mn = vEternitynodes[nIndex];
+    // insert() keeps existing entries, so the first eternitynode with a given key wins
+    mapFindByOutpoint.insert(std::make_pair(mn.vin.prevout, nIndex));
+    mapFindByPubKey.insert(std::make_pair(mn.pubKeyEternitynode.GetID(), nIndex));
+    mapFindByCollateral.insert(std::make_pair(mn.pubKeyCollateralAddress.GetID(), nIndex));
+}
+
+void CEternitynodeMan::CheckFindIndexes()
+{
+    AssertLockHeld(cs);
+    if(!fFindIndexesDirty) return;
+
+    mapFindByOutpoint.clear();
+    mapFindByPubKey.clear();
+    mapFindByCollateral.clear();
+    fFindIndexesDirty = false;
+    for(size_t i = 0; i < vEternitynodes.size(); ++i) {
+        AddToFindIndexes(i);
+    }
 }
 
 CEternitynode* CEternitynodeMan::Find(const CScript &payee)
 {
     LOCK(cs);
 
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes)
-    {
-        if(GetScriptForDestination(mn.pubKeyCollateralAddress.GetID()) == payee)
-            return &mn;
+    // eternitynodes are paid to GetScriptForDestination(pubKeyCollateralAddress.GetID()),
+    // which is OP_DUP OP_HASH160 <20 bytes key id> OP_EQUALVERIFY OP_CHECKSIG
+    if(payee.size() != 25 || payee[0] != OP_DUP || payee[1] != OP_HASH160 || payee[2] != 20 ||
+        payee[23] != OP_EQUALVERIFY || payee[24] != OP_CHECKSIG) {
+        return NULL;
     }
-    return NULL;
+    CKeyID keyID(uint160(std::vector<unsigned char>(payee.begin() + 3, payee.begin() + 23)));
+
+    CheckFindIndexes();
+    keyid_index_t::const_iterator it = mapFindByCollateral.find(keyID);
+    if(it == mapFindByCollateral.end()) return NULL;
+    return &vEternitynodes[it->second];
 }
 
 CEternitynode* CEternitynodeMan::Find(const CTxIn &vin)
 {
     LOCK(cs);
 
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes)
-    {
-        if(mn.vin.prevout == vin.prevout)
-            return &mn;
-    }
-    return NULL;
+    CheckFindIndexes();
+    outpoint_index_t::const_iterator it = mapFindByOutpoint.find(vin.prevout);
+    if(it == mapFindByOutpoint.end()) return NULL;
+    return &vEternitynodes[it->second];
 }
 
 CEternitynode* CEternitynodeMan::Find(const CPubKey &pubKeyEternitynode)
 {
     LOCK(cs);
 
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes)
-    {
-        if(mn.pubKeyEternitynode == pubKeyEternitynode)
-            return &mn;
-    }
-    return NULL;
+    CheckFindIndexes();
+    keyid_index_t::const_iterator it = mapFindByPubKey.find(pubKeyEternitynode.GetID());
+    if(it == mapFindByPubKey.end()) return NULL;
+    CEternitynode& mn = vEternitynodes[it->second];
+    // same check as before the index, the full key has to match
+    if(mn.pubKeyEternitynode != pubKeyEternitynode) return NULL;
+    return &mn;
 }
 
 bool CEternitynodeMan::Get(const CPubKey& pubKeyEternitynode, CEternitynode& eternitynode)
@@ -535,6 +734,12 @@ bool CEternitynodeMan::Has(const CTxIn& vin)
     return (pMN != NULL);
 }
 
+bool CEternitynodeMan::HasSeenPing(const uint256& nHash)
+{
+    LOCK(cs);
+    return mapSeenEternitynodePing.count(nHash);
+}
+
 //
 // Deterministically select the oldest/best eternitynode to pay on the network
 //
@@ -553,40 +758,60 @@ CEternitynode* CEternitynodeMan::GetNextEternitynodeInQueueForPayment(int nBlock
     LOCK2(cs_main,cs);
 
     CEternitynode *pBestEternitynode = NULL;
-    std::vector<std::pair<int, CEternitynode*> > vecEternitynodeLastPaid;
+
+    if(setPaymentQueue.size() != vEternitynodes.size()) {
+        RebuildPaymentQueue();
+    }
+
+    // payees which are already in the list (up to 8 entries ahead of current block to allow propagation)
+    std::set<CScript> setScheduledPayees;
+    enpayments.GetScheduledPayees(nBlockHeight, setScheduledPayees);
 
     /*
-        Make a vector with all of the last paid times
+        Walk the queue from the oldest payment to the newest one, count all qualified eternitynodes
+        and keep the oldest 1/10 of them (but at least one) as candidates
     */
 
     int nMnCount = CountEnabled();
-    BOOST_FOREACH(CEternitynode &mn, vEternitynodes)
+    int nTenthNetwork = std::max(1, nMnCount/10);
+    int nMinProtocol = enpayments.GetMinEternitynodePaymentsProto();
+    std::vector<CEternitynode*> vecEternitynodesOldest;
+    // only these many entries are valid for payment, the walk ends after the last one of them
+    int nEligible = CountPaymentQueueEligible(nMinProtocol);
+    int nEligibleSeen = 0;
+    nCount = 0;
+
+    BOOST_FOREACH(const PAIRTYPE(int, CEternitynode*)& s, setPaymentQueue)
     {
+        if(nEligibleSeen >= nEligible) break;
+
+        CEternitynode& mn = *s.second;
+
         if(!mn.IsValidForPayment()) continue;
 
         // //check protocol version
-        if(mn.nProtocolVersion < enpayments.GetMinEternitynodePaymentsProto()) continue;
+        if(mn.nProtocolVersion < nMinProtocol) continue;
 
-        //it's in the list (up to 8 entries ahead of current block to allow propagation) -- so let's skip it
-        if(enpayments.IsScheduled(mn, nBlockHeight)) continue;
+        nEligibleSeen++;
 
         //it's too new, wait for a cycle
         if(fFilterSigTime && mn.sigTime + (nMnCount*2.6*60) > GetAdjustedTime()) continue;
 
+        //it's in the list (up to 8 entries ahead of current block to allow propagation) -- so let's skip it
+        if(!setScheduledPayees.empty() && setScheduledPayees.count(GetScriptForDestination(mn.pubKeyCollateralAddress.GetID()))) continue;
+
         //make sure it has at least as many confirmations as there are eternitynodes
         if(mn.GetCollateralAge() < nMnCount) continue;
 
-        vecEternitynodeLastPaid.push_back(std::make_pair(mn.GetLastPaidBlock(), &mn));
+        nCount++;
+        if((int)vecEternitynodesOldest.size() < nTenthNetwork) {
+            vecEternitynodesOldest.push_back(&mn);
+        }
     }
 
-    nCount = (int)vecEternitynodeLastPaid.size();
-
     //when the network is in the process of upgrading, don't penalize nodes that recently restarted
     if(fFilterSigTime && nCount < nMnCount/3) return GetNextEternitynodeInQueueForPayment(nBlockHeight, false, nCount);
 
-    // Sort them low to high
-    sort(vecEternitynodeLastPaid.begin(), vecEternitynodeLastPaid.end(), CompareLastPaidBlock());
-
     uint256 blockHash;
     if(!GetBlockHash(blockHash, nBlockHeight - 101)) {
         LogPrintf("CEternitynode::GetNextEternitynodeInQueueForPayment -- ERROR: GetBlockHash() failed at nBlockHeight %d\n", nBlockHeight - 101);
@@ -596,21 +821,62 @@ CEternitynode* CEternitynodeMan::GetNextEternitynodeInQueueForPayment(int nBlock
     //  -- This doesn't look at who is being paid in the +8-10 blocks, allowing for double payments very rarely
     //  -- 1/100 payments should be a double payment on mainnet - (1/(3000/10))*2
     //  -- (chance per block * chances before IsScheduled will fire)
-    int nTenthNetwork = nMnCount/10;
-    int nCountTenth = 0;
+    //  -- Candidates above are filtered exactly like the eternitynodes in the payment rank table,
+    //     so scores are taken from there instead of being recalculated for every call
+    const CEternitynodeRankTable& rankTable = GetRankTable(blockHash, nMinProtocol, RANK_FILTER_VALID_FOR_PAYMENT);
     arith_uint256 nHighest = 0;
-    BOOST_FOREACH (PAIRTYPE(int, CEternitynode*)& s, vecEternitynodeLastPaid){
-        arith_uint256 nScore = s.second->CalculateScore(blockHash);
+    BOOST_FOREACH(CEternitynode* pmn, vecEternitynodesOldest) {
+        arith_uint256 nScore;
+        if(!rankTable.GetScore(pmn->vin.prevout, nScore)) {
+            nScore = pmn->CalculateScore(blockHash);
+        }
         if(nScore > nHighest){
             nHighest = nScore;
-            pBestEternitynode = s.second;
+            pBestEternitynode = pmn;
         }
-        nCountTenth++;
-        if(nCountTenth >= nTenthNetwork) break;
     }
     return pBestEternitynode;
 }
 
+void CEternitynodeMan::RebuildPaymentQueue()
+{
+    AssertLockHeld(cs);
+
+    setPaymentQueue.clear();
+    BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+        setPaymentQueue.insert(std::make_pair(mn.GetLastPaidBlock(), &mn));
+    }
+    // count the new entries on next use
+    nPaymentQueueVersion = -1;
+    LogPrint("eternitynode", "CEternitynodeMan::RebuildPaymentQueue -- %d eternitynodes in queue\n", (int)setPaymentQueue.size());
+}
+
+int CEternitynodeMan::CountPaymentQueueEligible(int nMinProtocol)
+{
+    AssertLockHeld(cs);
+
+    // eternitynodes which changed their state bump the list version
+    CheckStateChanges();
+
+    bool fSentinelRequired = sporkManager.IsSporkActive(SPORK_14_REQUIRE_SENTINEL_FLAG);
+    if(nPaymentQueueVersion == nListVersion && nPaymentQueueMinProtocol == nMinProtocol &&
+            fPaymentQueueSentinelRequired == fSentinelRequired) {
+        return nPaymentQueueEligible;
+    }
+
+    nPaymentQueueEligible = 0;
+    BOOST_FOREACH(const PAIRTYPE(int, CEternitynode*)& s, setPaymentQueue) {
+        if(s.second->IsValidForPayment() && s.second->nProtocolVersion >= nMinProtocol) {
+            nPaymentQueueEligible++;
+        }
+    }
+    nPaymentQueueVersion = nListVersion;
+    nPaymentQueueMinProtocol = nMinProtocol;
+    fPaymentQueueSentinelRequired = fSentinelRequired;
+
+    return nPaymentQueueEligible;
+}
+
 CEternitynode* CEternitynodeMan::FindRandomNotInVec(const std::vector<CTxIn> &vecToExclude, int nProtocolVersion)
 {
     LOCK(cs);
@@ -654,107 +920,206 @@ CEternitynode* CEternitynodeMan::FindRandomNotInVec(const std::vector<CTxIn> &ve
     return NULL;
 }
 
-int CEternitynodeMan::GetEternitynodeRank(const CTxIn& vin, int nBlockHeight, int nMinProtocol, bool fOnlyActive)
+const CEternitynodeRankTable& CEternitynodeMan::GetRankTable(const uint256& blockHash, int nMinProtocol, rank_filter_enum_t eFilter)
 {
-    std::vector<std::pair<int64_t, CEternitynode*> > vecEternitynodeScores;
+    AssertLockHeld(cs);
 
-    //make sure we know about this block
-    uint256 blockHash = uint256();
-    if(!GetBlockHash(blockHash, nBlockHeight)) return -1;
+    CheckStateChanges();
 
-    LOCK(cs);
+    // inactive eternitynodes can still be valid for payment depending on this spork,
+    // see CEternitynode::IsValidForPayment()
+    bool fSentinelRequired = sporkManager.IsSporkActive(SPORK_14_REQUIRE_SENTINEL_FLAG);
 
-    // scan for winner
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
-        if(mn.nProtocolVersion < nMinProtocol) continue;
-        if(fOnlyActive) {
-            if(!mn.IsEnabled()) continue;
-        }
-        else {
-            if(!mn.IsValidForPayment()) continue;
+    rank_cache_key_t key = std::make_pair(blockHash, std::make_pair(nMinProtocol, int(eFilter)));
+
+    std::map<rank_cache_key_t, CEternitynodeRankTable>::iterator it = mapRankCache.find(key);
+    if(it != mapRankCache.end()) {
+        if(it->second.nListVersion == nListVersion && it->second.fSentinelRequired == fSentinelRequired) {
+            return it->second;
         }
-        int64_t nScore = mn.CalculateScore(blockHash).GetCompact(false);
+        // the list changed or the spork was switched, all tables are outdated
+        ClearRankCache();
+    }
+
+    std::vector<std::pair<int64_t, CEternitynode*> > vecEternitynodeScores;
+    // full scores, indexed by position in vEternitynodes
+    std::vector<arith_uint256> vecFullScores(vEternitynodes.size());
+
+    for(size_t i = 0; i < vEternitynodes.size(); ++i) {
+        CEternitynode& mn = vEternitynodes[i];
+        if(mn.nProtocolVersion < nMinProtocol) continue;
+        if(eFilter == RANK_FILTER_ENABLED && !mn.IsEnabled()) continue;
+        if(eFilter == RANK_FILTER_VALID_FOR_PAYMENT && !mn.IsValidForPayment()) continue;
+        vecFullScores[i] = mn.CalculateScore(blockHash);
+        int64_t nScore = vecFullScores[i].GetCompact(false);
 
         vecEternitynodeScores.push_back(std::make_pair(nScore, &mn));
     }
 
     sort(vecEternitynodeScores.rbegin(), vecEternitynodeScores.rend(), CompareScoreMN());
 
+    if((int)listRankCacheKeys.size() >= MAX_RANK_CACHE_SIZE) {
+        mapRankCache.erase(listRankCacheKeys.front());
+        listRankCacheKeys.pop_front();
+    }
+    listRankCacheKeys.push_back(key);
+
+    CEternitynodeRankTable& table = mapRankCache[key];
+    table.nListVersion = nListVersion;
+    table.fSentinelRequired = fSentinelRequired;
+    table.vecRanked.reserve(vecEternitynodeScores.size());
+    table.vecScores.reserve(vecEternitynodeScores.size());
+
     int nRank = 0;
     BOOST_FOREACH (PAIRTYPE(int64_t, CEternitynode*)& scorePair, vecEternitynodeScores) {
         nRank++;
-        if(scorePair.second->vin.prevout == vin.prevout) return nRank;
+        table.vecRanked.push_back(scorePair.second->vin.prevout);
+        table.vecScores.push_back(vecFullScores[scorePair.second - &vEternitynodes[0]]);
+        table.mapRanks[scorePair.second->vin.prevout] = nRank;
     }
 
-    return -1;
+    LogPrint("eternitynode", "CEternitynodeMan::GetRankTable -- blockHash=%s, nMinProtocol=%d, eFilter=%d, ranked %d eternitynodes\n",
+                blockHash.ToString(), nMinProtocol, int(eFilter), nRank);
+
+    return table;
 }
 
-std::vector<std::pair<int, CEternitynode> > CEternitynodeMan::GetEternitynodeRanks(int nBlockHeight, int nMinProtocol)
+void CEternitynodeMan::ClearRankCache()
 {
-    std::vector<std::pair<int64_t, CEternitynode*> > vecEternitynodeScores;
-    std::vector<std::pair<int, CEternitynode> > vecEternitynodeRanks;
+    AssertLockHeld(cs);
+    mapRankCache.clear();
+    listRankCacheKeys.clear();
+}
+
+void CEternitynodeMan::CheckStateChanges()
+{
+    AssertLockHeld(cs);
+    LOCK(cs_stateChanged);
+    if(!fStateChanged) return;
+    fStateChanged = false;
+    SetListChanged();
+}
 
+int CEternitynodeMan::GetEternitynodeRank(const CTxIn& vin, int nBlockHeight, int nMinProtocol, bool fOnlyActive)
+{
     //make sure we know about this block
     uint256 blockHash = uint256();
-    if(!GetBlockHash(blockHash, nBlockHeight)) return vecEternitynodeRanks;
+    if(!GetBlockHash(blockHash, nBlockHeight)) return -1;
 
     LOCK(cs);
 
-    // scan for winner
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+    return GetRankTable(blockHash, nMinProtocol, fOnlyActive ? RANK_FILTER_ENABLED : RANK_FILTER_VALID_FOR_PAYMENT).GetRank(vin.prevout);
+}
 
-        if(mn.nProtocolVersion < nMinProtocol || !mn.IsEnabled()) continue;
+std::vector<std::pair<int, eternitynode_ptr_t> > CEternitynodeMan::GetEternitynodeRanks(int nBlockHeight, int nMinProtocol)
+{
+    std::vector<std::pair<int, eternitynode_ptr_t> > vecEternitynodeRanks;
 
-        int64_t nScore = mn.CalculateScore(blockHash).GetCompact(false);
+    //make sure we know about this block
+    uint256 blockHash = uint256();
+    if(!GetBlockHash(blockHash, nBlockHeight)) return vecEternitynodeRanks;
 
-        vecEternitynodeScores.push_back(std::make_pair(nScore, &mn));
-    }
+    LOCK(cs);
 
-    sort(vecEternitynodeScores.rbegin(), vecEternitynodeScores.rend(), CompareScoreMN());
+    // entries of a current snapshot are parallel to vEternitynodes, eternitynodes are only
+    // added and removed by methods which publish a new one but better safe than sorry
+    eternitynode_list_t list = GetEternitynodeList();
+    if(!list || list->size() != vEternitynodes.size()) {
+        PublishEternitynodeList();
+        list = GetEternitynodeList();
+    }
+    const CEternitynodeRankTable& table = GetRankTable(blockHash, nMinProtocol, RANK_FILTER_ENABLED);
 
-    int nRank = 0;
-    BOOST_FOREACH (PAIRTYPE(int64_t, CEternitynode*)& s, vecEternitynodeScores) {
-        nRank++;
-        vecEternitynodeRanks.push_back(std::make_pair(nRank, *s.second));
+    vecEternitynodeRanks.reserve(table.size());
+    for(int i = 0; i < table.size(); ++i) {
+        CEternitynode* pmn = Find(CTxIn(table.vecRanked[i]));
+        if(!pmn) continue;
+        vecEternitynodeRanks.push_back(std::make_pair(i + 1, (*list)[pmn - &vEternitynodes[0]]));
     }
 
     return vecEternitynodeRanks;
 }
 
-CEternitynode* CEternitynodeMan::GetEternitynodeByRank(int nRank, int nBlockHeight, int nMinProtocol, bool fOnlyActive)
+eternitynode_list_t CEternitynodeMan::GetEternitynodeList()
 {
-    std::vector<std::pair<int64_t, CEternitynode*> > vecEternitynodeScores;
+    {
+        LOCK(cs_listSnapshot);
+        if(listSnapshot) return listSnapshot;
+    }
+    // nothing was published yet
+    PublishEternitynodeList();
+    LOCK(cs_listSnapshot);
+    return listSnapshot;
+}
 
+void CEternitynodeMan::PublishEternitynodeList()
+{
     LOCK(cs);
 
-    uint256 blockHash;
-    if(!GetBlockHash(blockHash, nBlockHeight)) {
-        LogPrintf("CEternitynode::GetEternitynodeByRank -- ERROR: GetBlockHash() failed at nBlockHeight %d\n", nBlockHeight);
-        return NULL;
+    fListPublishPending = false;
+
+    // only this thread can replace it while we hold cs
+    const std::vector<eternitynode_ptr_t>* pvecPrev = listSnapshot.get();
+
+    // a check or a message often doesn't change anything and the last snapshot stays as is
+    bool fCopyAll = fListChangedAll || !pvecPrev;
+    if(!fCopyAll && pvecPrev->size() == vEternitynodes.size()) {
+        bool fChanged = false;
+        for(size_t i = 0; i < vEternitynodes.size() && !fChanged; ++i) {
+            fChanged = vEternitynodes[i].IsListChanged();
+        }
+        if(!fChanged) return;
     }
 
-    // Fill scores
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+    // without removals eternitynodes keep their position, new ones are appended and marked as changed
+    boost::shared_ptr<std::vector<eternitynode_ptr_t> > pvecNew(new std::vector<eternitynode_ptr_t>());
+    pvecNew->reserve(vEternitynodes.size());
+    int nCopied = 0;
+    for(size_t i = 0; i < vEternitynodes.size(); ++i) {
+        CEternitynode& mn = vEternitynodes[i];
+        if(!fCopyAll && i < pvecPrev->size() && !mn.IsListChanged()) {
+            pvecNew->push_back((*pvecPrev)[i]);
+        } else {
+            pvecNew->push_back(eternitynode_ptr_t(new CEternitynode(mn)));
+            nCopied++;
+        }
+        mn.ClearListChanged();
+    }
+    fListChangedAll = false;
 
-        if(mn.nProtocolVersion < nMinProtocol) continue;
-        if(fOnlyActive && !mn.IsEnabled()) continue;
+    LogPrint("eternitynode", "CEternitynodeMan::PublishEternitynodeList -- new snapshot of %d eternitynodes, %d copied\n", (int)pvecNew->size(), nCopied);
+
+    {
+        LOCK(cs_listSnapshot);
+        listSnapshot = pvecNew;
+    }
+}
 
-        int64_t nScore = mn.CalculateScore(blockHash).GetCompact(false);
+void CEternitynodeMan::PublishPendingEternitynodeList()
+{
+    LOCK(cs);
+    if(fListPublishPending) {
+        PublishEternitynodeList();
+    }
+}
 
-        vecEternitynodeScores.push_back(std::make_pair(nScore, &mn));
+CEternitynode* CEternitynodeMan::GetEternitynodeByRank(int nRank, int nBlockHeight, int nMinProtocol, bool fOnlyActive)
+{
+    uint256 blockHash;
+    if(!GetBlockHash(blockHash, nBlockHeight)) {
+        LogPrintf("CEternitynode::GetEternitynodeByRank -- ERROR: GetBlockHash() failed at nBlockHeight %d\n", nBlockHeight);
+        return NULL;
     }
 
-    sort(vecEternitynodeScores.rbegin(), vecEternitynodeScores.rend(), CompareScoreMN());
+    LOCK(cs);
 
-    int rank = 0;
-    BOOST_FOREACH (PAIRTYPE(int64_t, CEternitynode*)& s, vecEternitynodeScores){
-        rank++;
-        if(rank == nRank) {
-            return s.second;
-        }
+    const CEternitynodeRankTable& table = GetRankTable(blockHash, nMinProtocol, fOnlyActive ? RANK_FILTER_ENABLED : RANK_FILTER_ALL);
+
+    if(nRank < 1 || nRank > table.size()) {
+        return NULL;
     }
 
-    return NULL;
+    return Find(CTxIn(table.vecRanked[nRank - 1]));
 }
 
 void CEternitynodeMan::ProcessEternitynodeConnections()
@@ -800,8 +1165,48 @@ std::pair<CService, std::set<uint256> > CEternitynodeMan::PopScheduledMnbRequest
 }
 
 
+bool CEternitynodeMan::CheckListRequest(CNode* pfrom)
+{
+    AssertLockHeld(cs);
+
+    //local network
+    bool isLocal = (pfrom->addr.IsRFC1918() || pfrom->addr.IsLocal());
+
+    if(!isLocal && Params().NetworkIDString() == CBaseChainParams::MAIN) {
+        std::map<CNetAddr, int64_t>::iterator i = mAskedUsForEternitynodeList.find(pfrom->addr);
+        if (i != mAskedUsForEternitynodeList.end()){
+            int64_t t = (*i).second;
+            if (GetTime() < t) {
+                Misbehaving(pfrom->GetId(), 34);
+                LogPrintf("CEternitynodeMan::CheckListRequest -- peer already asked me for the list, peer=%d\n", pfrom->id);
+                return false;
+            }
+        }
+        int64_t askAgain = GetTime() + DSEG_UPDATE_SECONDS;
+        mAskedUsForEternitynodeList[pfrom->addr] = askAgain;
+    }
+
+    return true;
+}
+
+void CEternitynodeMan::PushListEntry(CNode* pfrom, CEternitynode& mn)
+{
+    AssertLockHeld(cs);
+
+    LogPrint("eternitynode", "CEternitynodeMan::PushListEntry -- Sending Eternitynode entry: eternitynode=%s  addr=%s\n", mn.vin.prevout.ToStringShort(), mn.addr.ToString());
+    CEternitynodeBroadcast mnb = CEternitynodeBroadcast(mn);
+    uint256 hash = mnb.GetHash();
+    pfrom->PushInventory(CInv(MSG_ETERNITYNODE_ANNOUNCE, hash));
+    pfrom->PushInventory(CInv(MSG_ETERNITYNODE_PING, mn.lastPing.GetHash()));
+
+    if (!mapSeenEternitynodeBroadcast.count(hash)) {
+        mapSeenEternitynodeBroadcast.insert(std::make_pair(hash, std::make_pair(GetTime(), mnb)));
+    }
+}
+
 void CEternitynodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     if(fLiteMode) return; // disable all Eternity specific functionality
     if(!eternitynodeSync.IsBlockchainSynced()) return;
 
@@ -880,22 +1285,7 @@ void CEternitynodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CDa
         LOCK(cs);
 
         if(vin == CTxIn()) { //only should ask for this once
-            //local network
-            bool isLocal = (pfrom->addr.IsRFC1918() || pfrom->addr.IsLocal());
-
-            if(!isLocal && Params().NetworkIDString() == CBaseChainParams::MAIN) {
-                std::map<CNetAddr, int64_t>::iterator i = mAskedUsForEternitynodeList.find(pfrom->addr);
-                if (i != mAskedUsForEternitynodeList.end()){
-                    int64_t t = (*i).second;
-                    if (GetTime() < t) {
-                        Misbehaving(pfrom->GetId(), 34);
-                        LogPrintf("DSEG -- peer already asked me for the list, peer=%d\n", pfrom->id);
-                        return;
-                    }
-                }
-                int64_t askAgain = GetTime() + DSEG_UPDATE_SECONDS;
-                mAskedUsForEternitynodeList[pfrom->addr] = askAgain;
-            }
+            if(!CheckListRequest(pfrom)) return;
         } //else, asking for a specific node which is ok
 
         int nInvCount = 0;
@@ -905,17 +1295,9 @@ void CEternitynodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CDa
             if (mn.addr.IsRFC1918() || mn.addr.IsLocal()) continue; // do not send local network eternitynode
             if (mn.IsUpdateRequired()) continue; // do not send outdated eternitynodes
 
-            LogPrint("eternitynode", "DSEG -- Sending Eternitynode entry: eternitynode=%s  addr=%s\n", mn.vin.prevout.ToStringShort(), mn.addr.ToString());
-            CEternitynodeBroadcast mnb = CEternitynodeBroadcast(mn);
-            uint256 hash = mnb.GetHash();
-            pfrom->PushInventory(CInv(MSG_ETERNITYNODE_ANNOUNCE, hash));
-            pfrom->PushInventory(CInv(MSG_ETERNITYNODE_PING, mn.lastPing.GetHash()));
+            PushListEntry(pfrom, mn);
             nInvCount++;
 
-            if (!mapSeenEternitynodeBroadcast.count(hash)) {
-                mapSeenEternitynodeBroadcast.insert(std::make_pair(hash, std::make_pair(GetTime(), mnb)));
-            }
-
             if (vin == mn.vin) {
                 LogPrintf("DSEG -- Sent 1 Eternitynode inv to peer %d\n", pfrom->id);
                 return;
@@ -930,6 +1312,44 @@ void CEternitynodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CDa
         // smth weird happen - someone asked us for vin we have no idea about?
         LogPrint("eternitynode", "DSEG -- No invs sent to peer %d\n", pfrom->id);
 
+    } else if (strCommand == NetMsgType::DSEGDIFF) { //Get Eternitynode list entries which differ from the ones the peer has
+        // Same as DSEG, don't serve the list until we are fully synced
+        if (!eternitynodeSync.IsSynced()) return;
+
+        int nPartition;
+        int nPartitions;
+        std::vector<uint64_t> vecDigests;
+        vRecv >> nPartition >> nPartitions >> vecDigests;
+
+        if(nPartitions < 1 || nPartitions > DSEGDIFF_MAX_PARTITIONS || nPartition < 0 || nPartition >= nPartitions) {
+            LogPrintf("DSEGDIFF -- invalid partition %d/%d, peer=%d\n", nPartition, nPartitions, pfrom->id);
+            Misbehaving(pfrom->GetId(), 20);
+            return;
+        }
+
+        LOCK(cs);
+
+        if(!CheckListRequest(pfrom)) return;
+
+        std::sort(vecDigests.begin(), vecDigests.end());
+
+        int nInvCount = 0;
+        int nTotal = 0;
+
+        BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+            if (GetListPartition(mn.vin.prevout, nPartitions) != nPartition) continue;
+            if (mn.addr.IsRFC1918() || mn.addr.IsLocal()) continue; // do not send local network eternitynode
+            if (mn.IsUpdateRequired()) continue; // do not send outdated eternitynodes
+            nTotal++;
+            if (std::binary_search(vecDigests.begin(), vecDigests.end(), GetListDigest(mn))) continue; // peer has it already
+
+            PushListEntry(pfrom, mn);
+            nInvCount++;
+        }
+
+        pfrom->PushMessage(NetMsgType::SYNCSTATUSCOUNT, ETERNITYNODE_SYNC_LIST, nInvCount);
+        LogPrintf("DSEGDIFF -- Sent %d of %d Eternitynode invs in partition %d/%d to peer %d\n", nInvCount, nTotal, nPartition, nPartitions, pfrom->id);
+
     } else if (strCommand == NetMsgType::MNVERIFY) { // Eternitynode Verify
 
         // Need LOCK2 here to ensure consistent locking order because the all functions below call GetBlockHash which locks cs_main
@@ -958,7 +1378,7 @@ void CEternitynodeMan::DoFullVerificationStep()
     if(activeEternitynode.vin == CTxIn()) return;
     if(!eternitynodeSync.IsSynced()) return;
 
-    std::vector<std::pair<int, CEternitynode> > vecEternitynodeRanks = GetEternitynodeRanks(pCurrentBlockIndex->nHeight - 1, MIN_POSE_PROTO_VERSION);
+    std::vector<std::pair<int, eternitynode_ptr_t> > vecEternitynodeRanks = GetEternitynodeRanks(pCurrentBlockIndex->nHeight - 1, MIN_POSE_PROTO_VERSION);
 
     // Need LOCK2 here to ensure consistent locking order because the SendVerifyRequest call below locks cs_main
     // through GetHeight() signal in ConnectNode
@@ -970,14 +1390,14 @@ void CEternitynodeMan::DoFullVerificationStep()
     int nRanksTotal = (int)vecEternitynodeRanks.size();
 
     // send verify requests only if we are in top MAX_POSE_RANK
-    std::vector<std::pair<int, CEternitynode> >::iterator it = vecEternitynodeRanks.begin();
+    std::vector<std::pair<int, eternitynode_ptr_t> >::iterator it = vecEternitynodeRanks.begin();
     while(it != vecEternitynodeRanks.end()) {
         if(it->first > MAX_POSE_RANK) {
             LogPrint("eternitynode", "CEternitynodeMan::DoFullVerificationStep -- Must be in top %d to send verify request\n",
                         (int)MAX_POSE_RANK);
             return;
         }
-        if(it->second.vin == activeEternitynode.vin) {
+        if(it->second->vin == activeEternitynode.vin) {
             nMyRank = it->first;
             LogPrint("eternitynode", "CEternitynodeMan::DoFullVerificationStep -- Found self at rank %d/%d, verifying up to %d eternitynodes\n",
                         nMyRank, nRanksTotal, (int)MAX_POSE_CONNECTIONS);
@@ -1003,20 +1423,20 @@ void CEternitynodeMan::DoFullVerificationStep()
 
     it = vecEternitynodeRanks.begin() + nOffset;
     while(it != vecEternitynodeRanks.end()) {
-        if(it->second.IsPoSeVerified() || it->second.IsPoSeBanned()) {
+        if(it->second->IsPoSeVerified() || it->second->IsPoSeBanned()) {
             LogPrint("eternitynode", "CEternitynodeMan::DoFullVerificationStep -- Already %s%s%s eternitynode %s address %s, skipping...\n",
-                        it->second.IsPoSeVerified() ? "verified" : "",
-                        it->second.IsPoSeVerified() && it->second.IsPoSeBanned() ? " and " : "",
-                        it->second.IsPoSeBanned() ? "banned" : "",
-                        it->second.vin.prevout.ToStringShort(), it->second.addr.ToString());
+                        it->second->IsPoSeVerified() ? "verified" : "",
+                        it->second->IsPoSeVerified() && it->second->IsPoSeBanned() ? " and " : "",
+                        it->second->IsPoSeBanned() ? "banned" : "",
+                        it->second->vin.prevout.ToStringShort(), it->second->addr.ToString());
             nOffset += MAX_POSE_CONNECTIONS;
             if(nOffset >= (int)vecEternitynodeRanks.size()) break;
             it += MAX_POSE_CONNECTIONS;
             continue;
         }
         LogPrint("eternitynode", "CEternitynodeMan::DoFullVerificationStep -- Verifying eternitynode %s rank %d/%d address %s\n",
-                    it->second.vin.prevout.ToStringShort(), it->first, nRanksTotal, it->second.addr.ToString());
-        if(SendVerifyRequest((CAddress)it->second.addr, vSortedByAddr)) {
+                    it->second->vin.prevout.ToStringShort(), it->first, nRanksTotal, it->second->addr.ToString());
+        if(SendVerifyRequest((CAddress)it->second->addr, vSortedByAddr)) {
             nCount++;
             if(nCount >= MAX_POSE_CONNECTIONS) break;
         }
@@ -1035,6 +1455,7 @@ void CEternitynodeMan::DoFullVerificationStep()
 
 void CEternitynodeMan::CheckSameAddr()
 {
+    CEternitynodeListUpdate listUpdate(*this);
     if(!eternitynodeSync.IsSynced() || vEternitynodes.empty()) return;
 
     std::vector<CEternitynode*> vBan;
@@ -1080,6 +1501,7 @@ void CEternitynodeMan::CheckSameAddr()
     }
 
     // ban duplicates
+    LOCK(cs);
     BOOST_FOREACH(CEternitynode* pmn, vBan) {
         LogPrintf("CEternitynodeMan::CheckSameAddr -- increasing PoSe ban score for eternitynode %s\n", pmn->vin.prevout.ToStringShort());
         pmn->IncreasePoSeBanScore();
@@ -1378,6 +1800,7 @@ std::string CEternitynodeMan::ToString() const
 
 void CEternitynodeMan::UpdateEternitynodeList(CEternitynodeBroadcast mnb)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     mapSeenEternitynodePing.insert(std::make_pair(mnb.lastPing.GetHash(), mnb.lastPing));
     mapSeenEternitynodeBroadcast.insert(std::make_pair(mnb.GetHash(), std::make_pair(GetTime(), mnb)));
@@ -1392,7 +1815,11 @@ void CEternitynodeMan::UpdateEternitynodeList(CEternitynodeBroadcast mnb)
         }
     } else {
         CEternitynodeBroadcast mnbOld = mapSeenEternitynodeBroadcast[CEternitynodeBroadcast(*pmn).GetHash()].second;
+        CPubKey pubKeyEternitynodePrev = pmn->pubKeyEternitynode;
         if(pmn->UpdateFromNewBroadcast(mnb)) {
+            if(pmn->pubKeyEternitynode != pubKeyEternitynodePrev) {
+                fFindIndexesDirty = true;
+            }
             eternitynodeSync.AddedEternitynodeList();
             mapSeenEternitynodeBroadcast.erase(mnbOld.GetHash());
         }
@@ -1401,6 +1828,7 @@ void CEternitynodeMan::UpdateEternitynodeList(CEternitynodeBroadcast mnb)
 
 bool CEternitynodeMan::CheckMnbAndUpdateEternitynodeList(CNode* pfrom, CEternitynodeBroadcast mnb, int& nDos)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     // Need LOCK2 here to ensure consistent locking order because the SimpleCheck call below locks cs_main
     LOCK2(cs_main, cs);
 
@@ -1452,7 +1880,12 @@ bool CEternitynodeMan::CheckMnbAndUpdateEternitynodeList(CNode* pfrom, CEternity
     CEternitynode* pmn = Find(mnb.vin);
     if(pmn) {
         CEternitynodeBroadcast mnbOld = mapSeenEternitynodeBroadcast[CEternitynodeBroadcast(*pmn).GetHash()].second;
-        if(!mnb.Update(pmn, nDos)) {
+        CPubKey pubKeyEternitynodePrev = pmn->pubKeyEternitynode;
+        bool fUpdated = mnb.Update(pmn, nDos);
+        if(pmn->pubKeyEternitynode != pubKeyEternitynodePrev) {
+            fFindIndexesDirty = true;
+        }
+        if(!fUpdated) {
             LogPrint("eternitynode", "CEternitynodeMan::CheckMnbAndUpdateEternitynodeList -- Update() failed, eternitynode=%s\n", mnb.vin.prevout.ToStringShort());
             return false;
         }
@@ -1490,6 +1923,7 @@ bool CEternitynodeMan::CheckMnbAndUpdateEternitynodeList(CNode* pfrom, CEternity
 
 void CEternitynodeMan::UpdateLastPaid()
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
 
     if(fLiteMode) return;
@@ -1503,14 +1937,65 @@ void CEternitynodeMan::UpdateLastPaid()
     // LogPrint("enpayments", "CEternitynodeMan::UpdateLastPaid -- nHeight=%d, nMaxBlocksToScanBack=%d, IsFirstRun=%s\n",
     //                         pCurrentBlockIndex->nHeight, nMaxBlocksToScanBack, IsFirstRun ? "true" : "false");
 
+    if(!indexPayments.Covers(pCurrentBlockIndex, nMaxBlocksToScanBack)) {
+        // Blocks connected before the cache was loaded (or before a restart) were not indexed,
+        // read the missing ones once here instead of scanning blocks for every eternitynode
+        if(indexPayments.GetLastHeight() < pCurrentBlockIndex->nHeight) {
+            indexPayments.Clear();
+        }
+        int nReadBlocks = 0;
+        const CBlockIndex* pindex = pCurrentBlockIndex;
+        if(indexPayments.GetFirstHeight() >= 0) {
+            pindex = pCurrentBlockIndex->GetAncestor(indexPayments.GetFirstHeight() - 1);
+        }
+        while(pindex && pindex->nHeight > pCurrentBlockIndex->nHeight - nMaxBlocksToScanBack) {
+            CBlock block;
+            if(!ReadBlockFromDisk(block, pindex, Params().GetConsensus())) // shouldn't really happen
+                break;
+            indexPayments.AddBlock(block, pindex);
+            nReadBlocks++;
+            pindex = pindex->pprev;
+        }
+        LogPrint("eternitynode", "CEternitynodeMan::UpdateLastPaid -- read %d blocks, payment index: %d payees, heights %d..%d\n",
+                    nReadBlocks, indexPayments.size(), indexPayments.GetFirstHeight(), indexPayments.GetLastHeight());
+    }
+
+    // only move entries around if the queue matches the list, it's rebuilt from scratch otherwise
+    bool fUpdateQueue = setPaymentQueue.size() == vEternitynodes.size();
+
     BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+        int nBlockLastPaidPrev = mn.GetLastPaidBlock();
         mn.UpdateLastPaid(pCurrentBlockIndex, nMaxBlocksToScanBack);
+        if(fUpdateQueue && mn.GetLastPaidBlock() != nBlockLastPaidPrev) {
+            setPaymentQueue.erase(std::make_pair(nBlockLastPaidPrev, &mn));
+            setPaymentQueue.insert(std::make_pair(mn.GetLastPaidBlock(), &mn));
+        }
     }
 
     // every time is like the first time if winners list is not synced
     IsFirstRun = !eternitynodeSync.IsWinnersListSynced();
 }
 
+void CEternitynodeMan::AddBlockPayments(const CBlock& block, const CBlockIndex* pindex)
+{
+    if(fLiteMode) return;
+
+    LOCK(cs);
+
+    indexPayments.AddBlock(block, pindex);
+
+    // no need to keep payments which are too old to be scanned for anyway
+    if(pindex->nHeight % LAST_PAID_SCAN_BLOCKS == 0) {
+        indexPayments.Prune(pindex->nHeight - enpayments.GetStorageLimit());
+    }
+}
+
+bool CEternitynodeMan::GetLastPayment(const CScript& payee, const CBlockIndex* pindex, int nMaxBlocksToScanBack, CEternitynodeLastPayment& paymentRet)
+{
+    LOCK(cs);
+    return indexPayments.Get(payee, pindex, nMaxBlocksToScanBack, paymentRet);
+}
+
 void CEternitynodeMan::CheckAndRebuildEternitynodeIndex()
 {
     LOCK(cs);
@@ -1539,6 +2024,7 @@ void CEternitynodeMan::CheckAndRebuildEternitynodeIndex()
 
 void CEternitynodeMan::UpdateWatchdogVoteTime(const CTxIn& vin)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     CEternitynode* pMN = Find(vin);
     if(!pMN)  {
@@ -1557,6 +2043,7 @@ bool CEternitynodeMan::IsWatchdogActive()
 
 bool CEternitynodeMan::AddGovernanceVote(const CTxIn& vin, uint256 nGovernanceObjectHash)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     CEternitynode* pMN = Find(vin);
     if(!pMN)  {
@@ -1568,14 +2055,17 @@ bool CEternitynodeMan::AddGovernanceVote(const CTxIn& vin, uint256 nGovernanceOb
 
 void CEternitynodeMan::RemoveGovernanceObject(uint256 nGovernanceObjectHash)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+        if(!mn.mapGovernanceObjectsVotedOn.count(nGovernanceObjectHash)) continue;
         mn.RemoveGovernanceObject(nGovernanceObjectHash);
     }
 }
 
 void CEternitynodeMan::CheckEternitynode(const CTxIn& vin, bool fForce)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     CEternitynode* pMN = Find(vin);
     if(!pMN)  {
@@ -1586,6 +2076,7 @@ void CEternitynodeMan::CheckEternitynode(const CTxIn& vin, bool fForce)
 
 void CEternitynodeMan::CheckEternitynode(const CPubKey& pubKeyEternitynode, bool fForce)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     CEternitynode* pMN = Find(pubKeyEternitynode);
     if(!pMN)  {
@@ -1626,12 +2117,13 @@ bool CEternitynodeMan::IsEternitynodePingedWithin(const CTxIn& vin, int nSeconds
 
 void CEternitynodeMan::SetEternitynodeLastPing(const CTxIn& vin, const CEternitynodePing& mnp)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     LOCK(cs);
     CEternitynode* pMN = Find(vin);
     if(!pMN)  {
         return;
     }
-    pMN->lastPing = mnp;
+    pMN->SetLastPing(mnp);
     mapSeenEternitynodePing.insert(std::make_pair(mnp.GetHash(), mnp));
 
     CEternitynodeBroadcast mnb(*pMN);
@@ -1643,6 +2135,7 @@ void CEternitynodeMan::SetEternitynodeLastPing(const CTxIn& vin, const CEternity
 
 void CEternitynodeMan::UpdatedBlockTip(const CBlockIndex *pindex)
 {
+    CEternitynodeListUpdate listUpdate(*this);
     pCurrentBlockIndex = pindex;
     LogPrint("eternitynode", "CEternitynodeMan::UpdatedBlockTip -- pCurrentBlockIndex->nHeight=%d\n", pCurrentBlockIndex->nHeight);
 
@@ -5,15 +5,27 @@
 #ifndef ETERNITYNODEMAN_H
 #define ETERNITYNODEMAN_H
 
+#include "crypto/common.h"
 #include "eternitynode.h"
+#include "script/standard.h"
 #include "sync.h"
 
+#include <boost/shared_ptr.hpp>
+
 using namespace std;
 
 class CEternitynodeMan;
 
 extern CEternitynodeMan mnodeman;
 
+/// Peers starting with this version can send only the list entries which differ from ours, see DSEGDIFF
+static const int MIN_ETERNITYNODE_DSEGDIFF_PROTO_VERSION = 70208;
+
+/// Immutable copy of an eternitynode, shared by all list snapshots taken while it doesn't change
+typedef boost::shared_ptr<const CEternitynode> eternitynode_ptr_t;
+/// Immutable snapshot of the eternitynode list, see CEternitynodeMan::GetEternitynodeList()
+typedef boost::shared_ptr<const std::vector<eternitynode_ptr_t> > eternitynode_list_t;
+
 /**
  * Provides a forward and reverse index between MN vin's and integers.
  *
@@ -78,6 +90,169 @@ private:
 
 };
 
+/**
+ * Last eternitynode payment to a payee found in the blockchain.
+ */
+class CEternitynodeLastPayment
+{
+public:
+    int nHeight;
+    int64_t nTime;
+    uint256 blockHash;
+
+    CEternitynodeLastPayment()
+        : nHeight(0),
+          nTime(0),
+          blockHash()
+        {}
+
+    CEternitynodeLastPayment(const CBlockIndex* pindex)
+        : nHeight(pindex->nHeight),
+          nTime(pindex->nTime),
+          blockHash(pindex->GetBlockHash())
+        {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(nHeight);
+        READWRITE(nTime);
+        READWRITE(blockHash);
+    }
+};
+
+/**
+ * Index of the latest eternitynode payment for every payee script.
+ *
+ * Filled from the coinbase of every connected block so last paid blocks can be
+ * looked up without reading blocks from disk. Covers a contiguous range of block
+ * heights, blocks below the range are added by scanning back (see CEternitynodeMan::UpdateLastPaid).
+ */
+class CEternitynodePaymentIndex
+{
+public: // Types
+    /// Keyed by the hash of the payee script
+    typedef std::map<CScriptID, CEternitynodeLastPayment> payment_m_t;
+
+    typedef payment_m_t::iterator payment_m_it;
+
+    typedef payment_m_t::const_iterator payment_m_cit;
+
+private:
+    payment_m_t mapLastPayments;
+
+    /// Range of block heights whose eternitynode payments are indexed, -1 if empty
+    int nFirstHeight;
+    int nLastHeight;
+
+public:
+    CEternitynodePaymentIndex();
+
+    /// Index eternitynode payments of a block, either the next block at the tip or the block right below the indexed range
+    void AddBlock(const CBlock& block, const CBlockIndex* pindex);
+
+    /// Get the latest payment to a payee within nMaxBlocksToScanBack blocks of (and in the chain of) pindex
+    bool Get(const CScript& payee, const CBlockIndex* pindex, int nMaxBlocksToScanBack, CEternitynodeLastPayment& paymentRet) const;
+
+    /// Check whether all blocks within nMaxBlocksToScanBack blocks of pindex are indexed
+    bool Covers(const CBlockIndex* pindex, int nMaxBlocksToScanBack) const;
+
+    /// Drop payments below nMinHeight
+    void Prune(int nMinHeight);
+
+    int GetFirstHeight() const { return nFirstHeight; }
+    int GetLastHeight() const { return nLastHeight; }
+    int size() const { return (int)mapLastPayments.size(); }
+
+    void Clear();
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(mapLastPayments);
+        READWRITE(nFirstHeight);
+        READWRITE(nLastHeight);
+    }
+};
+
+/** Hasher for containers keyed by CKeyID, key ids are hashes already */
+class CKeyIDHasher
+{
+public:
+    size_t operator()(const CKeyID& keyID) const {
+        return ReadLE64(keyID.begin());
+    }
+};
+
+/// Eternitynodes which are ranked in a CEternitynodeRankTable
+enum rank_filter_enum_t {
+    /// All eternitynodes (GetEternitynodeByRank with fOnlyActive=false)
+    RANK_FILTER_ALL,
+    /// Enabled eternitynodes only (fOnlyActive=true)
+    RANK_FILTER_ENABLED,
+    /// Eternitynodes valid for payment (GetEternitynodeRank with fOnlyActive=false, payment queue)
+    RANK_FILTER_VALID_FOR_PAYMENT
+};
+
+/**
+ * Eternitynode scores and ranks calculated against a single block.
+ *
+ * A table is built for a specific block hash, minimum protocol version and
+ * filter and stays valid until the eternitynode list changes.
+ */
+class CEternitynodeRankTable
+{
+public: // Types
+    typedef boost::unordered_map<COutPoint, int, COutPointHasher> rank_m_t;
+
+    typedef rank_m_t::const_iterator rank_m_cit;
+
+public:
+    /// Outpoints sorted by rank, vecRanked[0] has rank 1
+    std::vector<COutPoint> vecRanked;
+
+    /// Full scores in the same order as vecRanked
+    std::vector<arith_uint256> vecScores;
+
+    /// Outpoint to rank lookup
+    rank_m_t mapRanks;
+
+    /// CEternitynodeMan list version the table was built for
+    int64_t nListVersion;
+
+    /// Value of SPORK_14_REQUIRE_SENTINEL_FLAG when the table was built
+    bool fSentinelRequired;
+
+    CEternitynodeRankTable()
+        : vecRanked(),
+          vecScores(),
+          mapRanks(),
+          nListVersion(0),
+          fSentinelRequired(false)
+        {}
+
+    /// Get the rank of an eternitynode, -1 if it's not ranked in this table
+    int GetRank(const COutPoint& outpoint) const;
+
+    /// Get the score of an eternitynode, false if it's not ranked in this table
+    bool GetScore(const COutPoint& outpoint, arith_uint256& nScoreRet) const;
+
+    int size() const { return (int)vecRanked.size(); }
+};
+
+struct CompareLastPaidBlock
+{
+    bool operator()(const std::pair<int, CEternitynode*>& t1,
+                    const std::pair<int, CEternitynode*>& t2) const
+    {
+        return (t1.first != t2.first) ? (t1.first < t2.first) : (t1.second->vin < t2.second->vin);
+    }
+};
+
 class CEternitynodeMan
 {
 public:
@@ -96,6 +271,7 @@ private:
     static const std::string SERIALIZATION_VERSION_STRING;
 
     static const int DSEG_UPDATE_SECONDS        = 3 * 60 * 60;
+    static const int DSEGDIFF_MAX_PARTITIONS    = 64;
 
     static const int LAST_PAID_SCAN_BLOCKS      = 100;
 
@@ -110,6 +286,8 @@ private:
     static const int MNB_RECOVERY_WAIT_SECONDS      = 60;
     static const int MNB_RECOVERY_RETRY_SECONDS     = 3 * 60 * 60;
 
+    static const int MAX_RANK_CACHE_SIZE            = 32;
+
 
     // critical section to protect the inner data structures
     mutable CCriticalSection cs;
@@ -139,6 +317,9 @@ private:
 
     CEternitynodeIndex indexEternitynodesOld;
 
+    // latest eternitynode payment per payee
+    CEternitynodePaymentIndex indexPayments;
+
     /// Set when index has been rebuilt, clear when read
     bool fIndexRebuilt;
 
@@ -152,8 +333,76 @@ private:
 
     int64_t nLastWatchdogVoteTime;
 
+    // rank tables keyed by (block hash, (min protocol, rank_filter_enum_t)),
+    // dropped once nListVersion moved past the version they were built for
+    typedef std::pair<uint256, std::pair<int, int> > rank_cache_key_t;
+    std::map<rank_cache_key_t, CEternitynodeRankTable> mapRankCache;
+    // insertion order of mapRankCache keys, oldest first
+    std::list<rank_cache_key_t> listRankCacheKeys;
+
+    // bumped by SetListChanged() whenever eternitynodes are added, removed or change their state
+    int64_t nListVersion;
+
+    // set by eternitynodes whose active state or protocol version changed, they can hold their own
+    // lock so it is guarded by cs_stateChanged, CheckStateChanges() turns it into a list version bump
+    CCriticalSection cs_stateChanged;
+    bool fStateChanged;
+
+    // all eternitynodes ordered by last paid block (oldest payment first), points into vEternitynodes,
+    // cleared when eternitynodes are added or removed and rebuilt on next use
+    typedef std::set<std::pair<int, CEternitynode*>, CompareLastPaidBlock> payment_queue_t;
+    payment_queue_t setPaymentQueue;
+
+    // number of setPaymentQueue entries which are valid for payment with at least nPaymentQueueMinProtocol,
+    // the payment walk stops after the last of them. Only recounted when the list version, the minimum
+    // protocol or the sentinel spork changed
+    int nPaymentQueueEligible;
+    int64_t nPaymentQueueVersion;
+    int nPaymentQueueMinProtocol;
+    bool fPaymentQueueSentinelRequired;
+
+    // last published list snapshot, entries are parallel to vEternitynodes. Replaced by
+    // PublishEternitynodeList() under cs, cs_listSnapshot only guards the pointer itself
+    CCriticalSection cs_listSnapshot;
+    eternitynode_list_t listSnapshot;
+
+    // eternitynodes mark themselves when they change (see CEternitynode::IsListChanged()), only these
+    // are copied into the next snapshot. Set when eternitynodes were removed or the whole list was replaced.
+    bool fListChangedAll;
+    // eternitynodes were changed through pointers returned by Find() since the last snapshot
+    bool fListPublishPending;
+
+    // positions in vEternitynodes by collateral outpoint, eternitynode key and collateral key (payee),
+    // the first eternitynode wins when keys are shared. Extended by Add(), rebuilt on next use
+    // when fFindIndexesDirty is set after eternitynodes were removed or changed their keys
+    typedef boost::unordered_map<COutPoint, size_t, COutPointHasher> outpoint_index_t;
+    typedef boost::unordered_map<CKeyID, size_t, CKeyIDHasher> keyid_index_t;
+    outpoint_index_t mapFindByOutpoint;
+    keyid_index_t mapFindByPubKey;
+    keyid_index_t mapFindByCollateral;
+    bool fFindIndexesDirty;
+
     friend class CEternitynodeSync;
 
+    /// Add vEternitynodes[nIndex] to the Find() indexes, cs must be held
+    void AddToFindIndexes(size_t nIndex);
+    /// Rebuild the Find() indexes if they are outdated, cs must be held
+    void CheckFindIndexes();
+
+    /// Fill setPaymentQueue from vEternitynodes, cs must be held
+    void RebuildPaymentQueue();
+    /// Number of payment queue entries eligible for payment, recounted only after changes, cs must be held
+    int CountPaymentQueueEligible(int nMinProtocol);
+
+    /// Get (or calculate and cache) the rank table for a given block hash, cs must be held
+    const CEternitynodeRankTable& GetRankTable(const uint256& blockHash, int nMinProtocol, rank_filter_enum_t eFilter);
+    /// Drop all cached rank tables, cs must be held
+    void ClearRankCache();
+    /// Outdate all rank tables, cs must be held
+    void SetListChanged() { nListVersion++; }
+    /// Pick up state changes eternitynodes reported with SetStateChanged(), cs must be held
+    void CheckStateChanges();
+
 public:
     // Keep track of all broadcasts I've seen
     std::map<uint256, std::pair<int64_t, CEternitynodeBroadcast> > mapSeenEternitynodeBroadcast;
@@ -191,9 +440,19 @@ public:
         READWRITE(mapSeenEternitynodeBroadcast);
         READWRITE(mapSeenEternitynodePing);
         READWRITE(indexEternitynodes);
+        READWRITE(indexPayments);
+        if(ser_action.ForRead()) {
+            SetListChanged();
+            setPaymentQueue.clear();
+            fFindIndexesDirty = true;
+        }
         if(ser_action.ForRead() && (strVersion != SERIALIZATION_VERSION_STRING)) {
             Clear();
         }
+        if(ser_action.ForRead()) {
+            fListChangedAll = true;
+            PublishEternitynodeList();
+        }
     }
 
     CEternitynodeMan();
@@ -214,6 +473,11 @@ public:
     /// Clear Eternitynode vector
     void Clear();
 
+    /// Check if a peer may ask us for the whole list now, punish it if it asks too often
+    bool CheckListRequest(CNode* pfrom);
+    /// Announce a list entry to a peer which asked for the list
+    void PushListEntry(CNode* pfrom, CEternitynode& mn);
+
     /// Count Eternitynodes filtered by nProtocolVersion.
     /// Eternitynode nProtocolVersion should match or be above the one specified in param here.
     int CountEternitynodes(int nProtocolVersion = -1);
@@ -224,9 +488,16 @@ public:
     /// Count Eternitynodes by network type - NET_IPV4, NET_IPV6, NET_TOR
     // int CountByIP(int nNetworkType);
 
-    void DsegUpdate(CNode* pnode);
+    /// Compact digest of an entry's outpoint and last ping, entries with equal digests don't need to be synced
+    static uint64_t GetListDigest(const CEternitynode& mn);
+    /// Part of the list an outpoint belongs to when the list is split into nPartitions parts
+    static int GetListPartition(const COutPoint& outpoint, int nPartitions);
 
-    /// Find an entry
+    /// Ask a peer for the list. Peers which support it only send the entries of partition nPartition
+    /// which differ from ours. Returns false if we asked this peer recently already.
+    bool DsegUpdate(CNode* pnode, int nPartition = 0, int nPartitions = 1);
+
+    /// Find an entry, these are hash lookups
     CEternitynode* Find(const CScript &payee);
     CEternitynode* Find(const CTxIn& vin);
     CEternitynode* Find(const CPubKey& pubKeyEternitynode);
@@ -280,6 +551,9 @@ public:
 
     bool Has(const CTxIn& vin);
 
+    /// True if the ping with this hash was received already
+    bool HasSeenPing(const uint256& nHash);
+
     eternitynode_info_t GetEternitynodeInfo(const CTxIn& vin);
 
     eternitynode_info_t GetEternitynodeInfo(const CPubKey& pubKeyEternitynode);
@@ -292,9 +566,31 @@ public:
     /// Find a random entry
     CEternitynode* FindRandomNotInVec(const std::vector<CTxIn> &vecToExclude, int nProtocolVersion = -1);
 
-    std::vector<CEternitynode> GetFullEternitynodeVector() { return vEternitynodes; }
+    /**
+     * Get a consistent snapshot of all eternitynodes which can be read without holding cs.
+     * Doesn't take cs and only copies a pointer, the snapshot is published whenever the list
+     * is changed through CEternitynodeMan (changes made through pointers returned by Find()
+     * are picked up by the next PublishEternitynodeList()).
+     */
+    eternitynode_list_t GetEternitynodeList();
 
-    std::vector<std::pair<int, CEternitynode> > GetEternitynodeRanks(int nBlockHeight = -1, int nMinProtocol=0);
+    /**
+     * Publish a new snapshot if any eternitynode changed since the last one. Copies of the other
+     * eternitynodes are shared with the previous snapshot, so only the changed ones are copied again.
+     */
+    void PublishEternitynodeList();
+
+    /// Eternitynodes were changed through pointers returned by Find(), they are published with the next tick
+    void SetListPublishPending() { LOCK(cs); fListPublishPending = true; }
+
+    /// An eternitynode changed its active state or protocol version, rank tables and the payment queue count are outdated
+    void SetStateChanged() { LOCK(cs_stateChanged); fStateChanged = true; }
+    /// Publish a snapshot if SetListPublishPending() was called since the last one, once per tick
+    void PublishPendingEternitynodeList();
+
+    /// Ranks are calculated once per block (see CEternitynodeRankTable). With fOnlyActive=false GetEternitynodeRank
+    /// ranks all eternitynodes valid for payment and GetEternitynodeByRank all eternitynodes
+    std::vector<std::pair<int, eternitynode_ptr_t> > GetEternitynodeRanks(int nBlockHeight = -1, int nMinProtocol=0);
     int GetEternitynodeRank(const CTxIn &vin, int nBlockHeight, int nMinProtocol=0, bool fOnlyActive=true);
     CEternitynode* GetEternitynodeByRank(int nRank, int nBlockHeight, int nMinProtocol=0, bool fOnlyActive=true);
 
@@ -323,6 +619,12 @@ public:
 
     void UpdateLastPaid();
 
+    /// Index eternitynode payments of a connected block
+    void AddBlockPayments(const CBlock& block, const CBlockIndex* pindex);
+
+    /// Get the latest payment to a payee within nMaxBlocksToScanBack blocks of pindex
+    bool GetLastPayment(const CScript& payee, const CBlockIndex* pindex, int nMaxBlocksToScanBack, CEternitynodeLastPayment& paymentRet);
+
     void CheckAndRebuildEternitynodeIndex();
 
     void AddDirtyGovernanceObjectHash(const uint256& nHash)
@@ -9,15 +9,101 @@
 #include "clientversion.h"
 #include "hash.h"
 #include "streams.h"
+#include "sync.h"
 #include "util.h"
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+
 /** 
 *   Generic Dumping and Loading
 *   ---------------------------
 */
 
+/** Stream which writes to a file and hashes everything written */
+class CFlatDBWriter
+{
+private:
+    CAutoFile& fileout;
+    CHash256 ctx;
+
+public:
+    int nType;
+    int nVersion;
+
+    CFlatDBWriter(CAutoFile& fileoutIn) : fileout(fileoutIn), nType(fileoutIn.GetType()), nVersion(fileoutIn.GetVersion()) {}
+
+    int GetType() { return nType; }
+    int GetVersion() { return nVersion; }
+
+    CFlatDBWriter& write(const char *pch, size_t size) {
+        fileout.write(pch, size);
+        ctx.Write((const unsigned char*)pch, size);
+        return (*this);
+    }
+
+    // invalidates the object
+    uint256 GetHash() {
+        uint256 result;
+        ctx.Finalize((unsigned char*)&result);
+        return result;
+    }
+
+    template<typename T>
+    CFlatDBWriter& operator<<(const T& obj) {
+        ::Serialize(*this, obj, nType, nVersion);
+        return (*this);
+    }
+};
+
+/** Stream which reads at most nSize bytes from a file and hashes everything read */
+class CFlatDBReader
+{
+private:
+    CAutoFile& filein;
+    CHash256 ctx;
+    uint64_t nRemaining;
+
+public:
+    int nType;
+    int nVersion;
+
+    CFlatDBReader(CAutoFile& fileinIn, uint64_t nSize) : filein(fileinIn), nRemaining(nSize), nType(fileinIn.GetType()), nVersion(fileinIn.GetVersion()) {}
+
+    int GetType() { return nType; }
+    int GetVersion() { return nVersion; }
+
+    CFlatDBReader& read(char *pch, size_t size) {
+        if (size > nRemaining)
+            throw std::ios_base::failure("CFlatDBReader::read: end of data");
+        filein.read(pch, size);
+        ctx.Write((const unsigned char*)pch, size);
+        nRemaining -= size;
+        return (*this);
+    }
+
+    /** Hash the data which wasn't deserialized */
+    void SkipRemaining() {
+        char buf[4096];
+        while (nRemaining > 0)
+            read(buf, std::min(nRemaining, (uint64_t)sizeof(buf)));
+    }
+
+    // invalidates the object
+    uint256 GetHash() {
+        uint256 result;
+        ctx.Finalize((unsigned char*)&result);
+        return result;
+    }
+
+    template<typename T>
+    CFlatDBReader& operator>>(T& obj) {
+        ::Unserialize(*this, obj, nType, nVersion);
+        return (*this);
+    }
+};
+
 template<typename T>
 class CFlatDB
 {
@@ -34,139 +120,198 @@ private:
     };
 
     boost::filesystem::path pathDB;
+    boost::filesystem::path pathTmp;
     std::string strFilename;
     std::string strMagicMessage;
 
-    bool Write(const T& objToSave)
-    {
-        // LOCK(objToSave.cs);
-
-        int64_t nStart = GetTimeMillis();
-
-        // serialize, checksum data up to that point, then append checksum
-        CDataStream ssObj(SER_DISK, CLIENT_VERSION);
-        ssObj << strMagicMessage; // specific magic message for this type of object
-        ssObj << FLATDATA(Params().MessageStart()); // network specific magic number
-        ssObj << objToSave;
-        uint256 hash = Hash(ssObj.begin(), ssObj.end());
-        ssObj << hash;
+    /** Serializes dumps of T, a snapshot can still be running while shutdown dumps the same file */
+    static CCriticalSection cs_dump;
 
+    /**
+     * Serialize objToSave straight into a temporary file, checksum the data up to
+     * that point, append the checksum and move the file over the previous one.
+     */
+    template<typename Obj>
+    bool Write(const Obj& objToSave)
+    {
         // open output file, and associate with CAutoFile
-        FILE *file = fopen(pathDB.string().c_str(), "wb");
+        FILE *file = fopen(pathTmp.string().c_str(), "wb");
         CAutoFile fileout(file, SER_DISK, CLIENT_VERSION);
         if (fileout.IsNull())
-            return error("%s: Failed to open file %s", __func__, pathDB.string());
+            return error("%s: Failed to open file %s", __func__, pathTmp.string());
 
         // Write and commit header, data
         try {
-            fileout << ssObj;
+            CFlatDBWriter writer(fileout);
+            writer << strMagicMessage; // specific magic message for this type of object
+            writer << FLATDATA(Params().MessageStart()); // network specific magic number
+            writer << objToSave;
+            uint256 hash = writer.GetHash();
+            fileout << hash;
         }
         catch (std::exception &e) {
             return error("%s: Serialize or I/O error - %s", __func__, e.what());
         }
+        FileCommit(fileout.Get());
         fileout.fclose();
 
-        LogPrintf("Written info to %s  %dms\n", strFilename, GetTimeMillis() - nStart);
-        LogPrintf("     %s\n", objToSave.ToString());
+        if (!RenameOver(pathTmp, pathDB))
+            return error("%s: Rename-into-place failed", __func__);
 
         return true;
     }
 
-    ReadResult Read(T& objToLoad, bool fDryRun = false)
+    /**
+     * Verify the checksum of filein, which has to be open at the start of pathDB,
+     * in a first pass and rewind it. nDataSize is set to the size of the data
+     * in front of the checksum.
+     */
+    ReadResult CheckHash(CAutoFile& filein, uint64_t& nDataSize)
     {
-        //LOCK(objToLoad.cs);
-
-        int64_t nStart = GetTimeMillis();
-        // open input file, and associate with CAutoFile
-        FILE *file = fopen(pathDB.string().c_str(), "rb");
-        CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
-        if (filein.IsNull())
+        // data is followed by its checksum
+        uint64_t fileSize = boost::filesystem::file_size(pathDB);
+        if (fileSize < sizeof(uint256))
         {
-            error("%s: Failed to open file %s", __func__, pathDB.string());
-            return FileError;
+            error("%s: File is too small to contain a checksum", __func__);
+            return HashReadError;
         }
+        nDataSize = fileSize - sizeof(uint256);
 
-        // use file size to size memory buffer
-        int fileSize = boost::filesystem::file_size(pathDB);
-        int dataSize = fileSize - sizeof(uint256);
-        // Don't try to resize to a negative number if file is small
-        if (dataSize < 0)
-            dataSize = 0;
-        std::vector<unsigned char> vchData;
-        vchData.resize(dataSize);
+        CFlatDBReader reader(filein, nDataSize);
         uint256 hashIn;
-
-        // read data and checksum from file
         try {
-            filein.read((char *)&vchData[0], dataSize);
+            reader.SkipRemaining();
             filein >> hashIn;
         }
         catch (std::exception &e) {
             error("%s: Deserialize or I/O error - %s", __func__, e.what());
             return HashReadError;
         }
-        filein.fclose();
 
-        CDataStream ssObj(vchData, SER_DISK, CLIENT_VERSION);
-
-        // verify stored checksum matches input data
-        uint256 hashTmp = Hash(ssObj.begin(), ssObj.end());
-        if (hashIn != hashTmp)
+        if (hashIn != reader.GetHash())
         {
             error("%s: Checksum mismatch, data corrupted", __func__);
             return IncorrectHash;
         }
 
+        if (fseek(filein.Get(), 0, SEEK_SET) != 0)
+        {
+            error("%s: Failed to rewind file %s", __func__, pathDB.string());
+            return FileError;
+        }
+
+        return Ok;
+    }
 
+    /** Read the file header and verify it's ours, throws on I/O errors */
+    ReadResult ReadMagic(CFlatDBReader& reader)
+    {
         unsigned char pchMsgTmp[4];
         std::string strMagicMessageTmp;
-        try {
-            // de-serialize file header (file specific magic message) and ..
-            ssObj >> strMagicMessageTmp;
 
-            // ... verify the message matches predefined one
-            if (strMagicMessage != strMagicMessageTmp)
-            {
-                error("%s: Invalid magic message", __func__);
-                return IncorrectMagicMessage;
-            }
+        // de-serialize file header (file specific magic message) and ..
+        reader >> strMagicMessageTmp;
 
+        // ... verify the message matches predefined one
+        if (strMagicMessage != strMagicMessageTmp)
+        {
+            error("%s: Invalid magic message", __func__);
+            return IncorrectMagicMessage;
+        }
 
-            // de-serialize file header (network specific magic number) and ..
-            ssObj >> FLATDATA(pchMsgTmp);
+        // de-serialize file header (network specific magic number) and ..
+        reader >> FLATDATA(pchMsgTmp);
 
-            // ... verify the network matches ours
-            if (memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp)))
-            {
-                error("%s: Invalid network magic number", __func__);
-                return IncorrectMagicNumber;
-            }
+        // ... verify the network matches ours
+        if (memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp)))
+        {
+            error("%s: Invalid network magic number", __func__);
+            return IncorrectMagicNumber;
+        }
+
+        return Ok;
+    }
+
+    ReadResult Read(T& objToLoad)
+    {
+        //LOCK(objToLoad.cs);
+
+        int64_t nStart = GetTimeMillis();
+        // open input file, and associate with CAutoFile
+        FILE *file = fopen(pathDB.string().c_str(), "rb");
+        CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
+        if (filein.IsNull())
+        {
+            error("%s: Failed to open file %s", __func__, pathDB.string());
+            return FileError;
+        }
+
+        // verify the checksum in a first pass, objToLoad is only touched for intact files
+        uint64_t nDataSize = 0;
+        ReadResult result = CheckHash(filein, nDataSize);
+        if (result != Ok)
+            return result;
+
+        // then deserialize straight from the file
+        CFlatDBReader reader(filein, nDataSize);
+        try {
+            result = ReadMagic(reader);
+            if (result != Ok)
+                return result;
 
             // de-serialize data into T object
-            ssObj >> objToLoad;
+            reader >> objToLoad;
         }
         catch (std::exception &e) {
             objToLoad.Clear();
             error("%s: Deserialize or I/O error - %s", __func__, e.what());
             return IncorrectFormat;
         }
+        filein.fclose();
 
         LogPrintf("Loaded info from %s  %dms\n", strFilename, GetTimeMillis() - nStart);
         LogPrintf("     %s\n", objToLoad.ToString());
-        if(!fDryRun) {
-            LogPrintf("%s: Cleaning....\n", __func__);
-            objToLoad.CheckAndRemove();
-            LogPrintf("     %s\n", objToLoad.ToString());
-        }
+        LogPrintf("%s: Cleaning....\n", __func__);
+        objToLoad.CheckAndRemove();
+        LogPrintf("     %s\n", objToLoad.ToString());
 
         return Ok;
     }
 
+    /** Check the checksum and the header of the file without deserializing its data */
+    ReadResult Verify()
+    {
+        FILE *file = fopen(pathDB.string().c_str(), "rb");
+        CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
+        if (filein.IsNull())
+        {
+            error("%s: Failed to open file %s", __func__, pathDB.string());
+            return FileError;
+        }
+
+        uint64_t nDataSize = 0;
+        ReadResult result = CheckHash(filein, nDataSize);
+        if (result != Ok)
+            return result;
+
+        CFlatDBReader reader(filein, nDataSize);
+        try {
+            result = ReadMagic(reader);
+        }
+        catch (std::exception &e) {
+            error("%s: Deserialize or I/O error - %s", __func__, e.what());
+            return IncorrectFormat;
+        }
+
+        return result;
+    }
+
 
 public:
     CFlatDB(std::string strFilenameIn, std::string strMagicMessageIn)
     {
         pathDB = GetDataDir() / strFilenameIn;
+        pathTmp = GetDataDir() / (strFilenameIn + ".new");
         strFilename = strFilenameIn;
         strMagicMessage = strMagicMessageIn;
     }
@@ -195,11 +340,11 @@ public:
 
     bool Dump(T& objToSave)
     {
+        LOCK(cs_dump);
         int64_t nStart = GetTimeMillis();
 
         LogPrintf("Verifying %s format...\n", strFilename);
-        T tmpObjToLoad;
-        ReadResult readResult = Read(tmpObjToLoad, true);
+        ReadResult readResult = Verify();
 
         // there was an error and it was not an error on file opening => do not proceed
         if (readResult == FileError)
@@ -217,13 +362,37 @@ public:
         }
 
         LogPrintf("Writting info to %s...\n", strFilename);
-        Write(objToSave);
+        if (Write(objToSave)) {
+            LogPrintf("Written info to %s  %dms\n", strFilename, GetTimeMillis() - nStart);
+            LogPrintf("     %s\n", objToSave.ToString());
+        }
         LogPrintf("%s dump finished  %dms\n", strFilename, GetTimeMillis() - nStart);
 
         return true;
     }
 
+    /**
+     * Save objToSave without blocking its users for the file commit: it's serialized
+     * straight into the temporary file, so no second copy of it is kept in memory.
+     * T's serialization has to take the locks guarding its data itself, they're only
+     * held while it's serialized, the file is committed and moved into place after that.
+     * Meant for periodic saves from a background thread, the file isn't verified first.
+     */
+    bool DumpSnapshot(T& objToSave)
+    {
+        LOCK(cs_dump);
+        int64_t nStart = GetTimeMillis();
+
+        if (!Write(objToSave))
+            return false;
+
+        LogPrintf("Written snapshot of %s  %dms\n", strFilename, GetTimeMillis() - nStart);
+        return true;
+    }
+
 };
 
+template<typename T>
+CCriticalSection CFlatDB<T>::cs_dump;
 
 #endif
\ No newline at end of file
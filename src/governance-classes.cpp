@@ -99,6 +99,27 @@ CAmount ParsePaymentAmount(const std::string& strAmount)
     return nAmount;
 }
 
+void CTriggerHeightIndex::Add(int nBlockHeight, const uint256& nHash)
+{
+    setTriggerHeights.insert(std::make_pair(nBlockHeight, nHash));
+}
+
+void CTriggerHeightIndex::Remove(int nBlockHeight, const uint256& nHash)
+{
+    setTriggerHeights.erase(std::make_pair(nBlockHeight, nHash));
+}
+
+std::vector<uint256> CTriggerHeightIndex::Get(int nBlockHeight) const
+{
+    std::vector<uint256> vecResults;
+    // the null hash sorts first, so this is the first trigger for nBlockHeight
+    trigger_height_s_t::const_iterator it = setTriggerHeights.lower_bound(std::make_pair(nBlockHeight, uint256()));
+    for(; it != setTriggerHeights.end() && it->first == nBlockHeight; ++it) {
+        vecResults.push_back(it->second);
+    }
+    return vecResults;
+}
+
 /**
 *   Add Governance Object
 */
@@ -141,6 +162,7 @@ bool CGovernanceTriggerManager::AddNewTrigger(uint256 nHash)
 
     DBG( cout << "CGovernanceTriggerManager::AddNewTrigger: Inserting trigger" << endl; );
     mapTrigger.insert(std::make_pair(nHash, pSuperblock));
+    indexTriggerHeights.Add(pSuperblock->GetBlockStart(), nHash);
 
     DBG( cout << "CGovernanceTriggerManager::AddNewTrigger: End" << endl; );
 
@@ -211,6 +233,7 @@ void CGovernanceTriggerManager::CleanAndRemove()
                             LogPrint("gobject", "CGovernanceTriggerManager::CleanAndRemove -- Expiring outdated object: %s\n", pgovobj->GetHash().ToString());
                             pgovobj->fExpired = true;
                             pgovobj->nDeletionTime = GetAdjustedTime();
+                            pgovobj->fDirtyRecord = true;
                         }
                     }
                 }
@@ -232,6 +255,9 @@ void CGovernanceTriggerManager::CleanAndRemove()
                      << endl;
                );
             LogPrint("gobject", "CGovernanceTriggerManager::CleanAndRemove -- Removing trigger object\n");
+            if(pSuperblock) {
+                indexTriggerHeights.Remove(pSuperblock->GetBlockStart(), it->first);
+            }
             mapTrigger.erase(it++);
         }
         else  {
@@ -274,6 +300,28 @@ std::vector<CSuperblock_sptr> CGovernanceTriggerManager::GetActiveTriggers()
     return vecResults;
 }
 
+std::vector<CSuperblock_sptr> CGovernanceTriggerManager::GetActiveTriggers(int nBlockHeight)
+{
+    AssertLockHeld(governance.cs);
+    std::vector<CSuperblock_sptr> vecResults;
+
+    // in hash order like mapTrigger, GetBestSuperblock keeps the first of equally voted triggers
+    std::vector<uint256> vecHashes = indexTriggerHeights.Get(nBlockHeight);
+    BOOST_FOREACH(const uint256& nHash, vecHashes) {
+        trigger_m_it itTrigger = mapTrigger.find(nHash);
+        if(itTrigger == mapTrigger.end()) {
+            continue;
+        }
+        if(governance.FindGovernanceObject(nHash)) {
+            vecResults.push_back(itTrigger->second);
+        }
+    }
+
+    DBG( cout << "GetActiveTriggers: nBlockHeight = " << nBlockHeight << ", vecResults.size() = " << vecResults.size() << endl; );
+
+    return vecResults;
+}
+
 /**
 *   Is Superblock Triggered
 *
@@ -288,8 +336,8 @@ bool CSuperblockManager::IsSuperblockTriggered(int nBlockHeight)
     }
 
     LOCK(governance.cs);
-    // GET ALL ACTIVE TRIGGERS
-    std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers();
+    // GET ALL ACTIVE TRIGGERS FOR THIS HEIGHT
+    std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers(nBlockHeight);
 
     LogPrint("gobject", "CSuperblockManager::IsSuperblockTriggered -- vecTriggers.size() = %d\n", vecTriggers.size());
 
@@ -352,7 +400,7 @@ bool CSuperblockManager::GetBestSuperblock(CSuperblock_sptr& pSuperblockRet, int
     }
 
     AssertLockHeld(governance.cs);
-    std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers();
+    std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers(nBlockHeight);
     int nYesCount = 0;
 
     BOOST_FOREACH(CSuperblock_sptr pSuperblock, vecTriggers) {
@@ -461,13 +509,7 @@ void CSuperblockManager::CreateEvolution( CMutableTransaction& txNewRet, int nBl
     // make sure it's empty, just in case
     voutSuperblockRet.clear();
 			
-	CScript payeeEvo;
-	CPubKey pb;
-
-	CBitcoinAddress address( evolutionManager.getEvolution(nBlockHeight)  );
-
-	//--.
-	payeeEvo = GetScriptForDestination( address.Get() );
+	CScript payeeEvo = evolutionManager.getEvolutionScript( nBlockHeight );
 	
 	CTxOut txout = CTxOut(  blockEvolution, payeeEvo );
 
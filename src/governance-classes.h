@@ -30,6 +30,30 @@ extern CGovernanceTriggerManager triggerman;
 // SPLIT A STRING UP - USED FOR SUPERBLOCK PAYMENTS
 std::vector<std::string> SplitBy(std::string strCommand, std::string strDelimit);
 
+/**
+*   Trigger hashes by superblock height
+*
+*   - Triggers for the same height are kept in hash order, so that ties between
+*     them are broken the same way on every node, whatever order they arrived in
+*/
+
+class CTriggerHeightIndex
+{
+private:
+    typedef std::set<std::pair<int, uint256> > trigger_height_s_t;
+
+    trigger_height_s_t setTriggerHeights;
+
+public:
+    CTriggerHeightIndex() : setTriggerHeights() {}
+
+    void Add(int nBlockHeight, const uint256& nHash);
+    void Remove(int nBlockHeight, const uint256& nHash);
+    /// Hashes of the triggers for nBlockHeight, in hash order
+    std::vector<uint256> Get(int nBlockHeight) const;
+    size_t size() const { return setTriggerHeights.size(); }
+};
+
 /**
 *   Trigger Mananger
 *
@@ -49,12 +73,16 @@ private:
 
     trigger_m_t mapTrigger;
 
+    CTriggerHeightIndex indexTriggerHeights;
+
     std::vector<CSuperblock_sptr> GetActiveTriggers();
+    /// Active triggers for the superblock at nBlockHeight
+    std::vector<CSuperblock_sptr> GetActiveTriggers(int nBlockHeight);
     bool AddNewTrigger(uint256 nHash);
     void CleanAndRemove();
 
 public:
-    CGovernanceTriggerManager() : mapTrigger() {}
+    CGovernanceTriggerManager() : mapTrigger(), indexTriggerHeights() {}
 };
 
 /**
@@ -0,0 +1,212 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "governance-db.h"
+#include "eternitynodeman.h"
+#include "util.h"
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+static const char DB_GOVERNANCE_OBJECT = 'o';
+static const char DB_GOVERNANCE_VOTE = 'v';
+static const char DB_GOVERNANCE_VOTE_INSTANCE = 'i';
+
+typedef std::pair<uint256, std::pair<COutPoint, int> > vote_instance_key_t;
+
+CGovernanceDB* pgovernancedb = NULL;
+
+CGovernanceDB::CGovernanceDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "governance", nCacheSize, fMemory, fWipe)
+{
+}
+
+bool CGovernanceDB::WriteObject(CGovernanceObject& govobj)
+{
+    if(!Write(std::make_pair(DB_GOVERNANCE_OBJECT, govobj.GetHash()), CGovernanceObjectRecord(govobj))) {
+        return false;
+    }
+    govobj.fDirtyRecord = false;
+    return true;
+}
+
+bool CGovernanceDB::WriteObjects(std::map<uint256, CGovernanceObject>& mapObjects, bool fDirtyOnly)
+{
+    CDBBatch batch(&GetObfuscateKey());
+    std::vector<CGovernanceObject*> vecWritten;
+    for(std::map<uint256, CGovernanceObject>::iterator it = mapObjects.begin(); it != mapObjects.end(); ++it) {
+        if(fDirtyOnly && !it->second.fDirtyRecord) {
+            continue;
+        }
+        batch.Write(std::make_pair(DB_GOVERNANCE_OBJECT, it->first), CGovernanceObjectRecord(it->second));
+        vecWritten.push_back(&it->second);
+    }
+    if(vecWritten.empty()) {
+        return true;
+    }
+    if(!WriteBatch(batch, true)) {
+        return false;
+    }
+    for(size_t i = 0; i < vecWritten.size(); ++i) {
+        vecWritten[i]->fDirtyRecord = false;
+    }
+    return true;
+}
+
+bool CGovernanceDB::ImportObjects(std::map<uint256, CGovernanceObject>& mapObjects)
+{
+    CDBBatch batch(&GetObfuscateKey());
+    int nVotes = 0;
+    for(std::map<uint256, CGovernanceObject>::iterator it = mapObjects.begin(); it != mapObjects.end(); ++it) {
+        batch.Write(std::make_pair(DB_GOVERNANCE_OBJECT, it->first), CGovernanceObjectRecord(it->second));
+        // governance.dat was written together with mncache.dat, its indexes are those of the loaded eternitynode list
+        for(CGovernanceObject::vote_m_cit it2 = it->second.mapCurrentMNVotes.begin(); it2 != it->second.mapCurrentMNVotes.end(); ++it2) {
+            bool fIndexRebuilt = false;
+            CTxIn vinEternitynode;
+            if(!mnodeman.Get(it2->first, vinEternitynode, fIndexRebuilt)) {
+                continue;
+            }
+            const vote_instance_m_t& mapInstances = it2->second.mapInstances;
+            for(vote_instance_m_cit it3 = mapInstances.begin(); it3 != mapInstances.end(); ++it3) {
+                batch.Write(std::make_pair(DB_GOVERNANCE_VOTE_INSTANCE, vote_instance_key_t(it->first, std::make_pair(vinEternitynode.prevout, it3->first))), it3->second);
+            }
+        }
+        const CGovernanceObjectVoteFile::vote_l_t& listVotes = it->second.fileVotes.GetVoteList();
+        for(CGovernanceObjectVoteFile::vote_l_cit it2 = listVotes.begin(); it2 != listVotes.end(); ++it2) {
+            batch.Write(std::make_pair(DB_GOVERNANCE_VOTE, std::make_pair(it->first, it2->GetHash())), *it2);
+            ++nVotes;
+        }
+    }
+    if(!WriteBatch(batch, true)) {
+        return false;
+    }
+    LogPrintf("CGovernanceDB::ImportObjects -- imported %d objects, %d votes\n", mapObjects.size(), nVotes);
+    return true;
+}
+
+bool CGovernanceDB::EraseObject(const uint256& nHash)
+{
+    CDBBatch batch(&GetObfuscateKey());
+    batch.Erase(std::make_pair(DB_GOVERNANCE_OBJECT, nHash));
+
+    // votes are keyed by object first, this also finds votes which were dropped from memory
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(std::make_pair(DB_GOVERNANCE_VOTE, std::make_pair(nHash, uint256())));
+    while(pcursor->Valid()) {
+        std::pair<char, std::pair<uint256, uint256> > key;
+        if(!pcursor->GetKey(key) || key.first != DB_GOVERNANCE_VOTE || key.second.first != nHash) {
+            break;
+        }
+        batch.Erase(key);
+        pcursor->Next();
+    }
+    pcursor->Seek(std::make_pair(DB_GOVERNANCE_VOTE_INSTANCE, vote_instance_key_t(nHash, std::make_pair(COutPoint(uint256(), 0), 0))));
+    while(pcursor->Valid()) {
+        std::pair<char, vote_instance_key_t> key;
+        if(!pcursor->GetKey(key) || key.first != DB_GOVERNANCE_VOTE_INSTANCE || key.second.first != nHash) {
+            break;
+        }
+        batch.Erase(key);
+        pcursor->Next();
+    }
+
+    return WriteBatch(batch);
+}
+
+bool CGovernanceDB::WriteVote(const CGovernanceVote& vote, const vote_instance_t& voteInstance)
+{
+    CDBBatch batch(&GetObfuscateKey());
+    vote_instance_key_t keyInstance(vote.GetParentHash(), std::make_pair(vote.GetVinEternitynode().prevout, int(vote.GetSignal())));
+    batch.Write(std::make_pair(DB_GOVERNANCE_VOTE_INSTANCE, keyInstance), voteInstance);
+    batch.Write(std::make_pair(DB_GOVERNANCE_VOTE, std::make_pair(vote.GetParentHash(), vote.GetHash())), vote);
+    return WriteBatch(batch);
+}
+
+bool CGovernanceDB::EraseVotes(const uint256& nParentHash, const std::vector<uint256>& vecVoteHashes, const std::vector<std::pair<COutPoint, int> >& vecInstances)
+{
+    CDBBatch batch(&GetObfuscateKey());
+    for(size_t i = 0; i < vecVoteHashes.size(); ++i) {
+        batch.Erase(std::make_pair(DB_GOVERNANCE_VOTE, std::make_pair(nParentHash, vecVoteHashes[i])));
+    }
+    for(size_t i = 0; i < vecInstances.size(); ++i) {
+        batch.Erase(std::make_pair(DB_GOVERNANCE_VOTE_INSTANCE, vote_instance_key_t(nParentHash, vecInstances[i])));
+    }
+    return WriteBatch(batch);
+}
+
+bool CGovernanceDB::ReadVotes(const uint256& nParentHash, CGovernanceObjectVoteFile& fileVotes)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(std::make_pair(DB_GOVERNANCE_VOTE, std::make_pair(nParentHash, uint256())));
+    while(pcursor->Valid()) {
+        std::pair<char, std::pair<uint256, uint256> > key;
+        if(!pcursor->GetKey(key) || key.first != DB_GOVERNANCE_VOTE || key.second.first != nParentHash) {
+            break;
+        }
+        CGovernanceVote vote;
+        if(!pcursor->GetValue(vote)) {
+            return error("CGovernanceDB::ReadVotes -- failed to read vote %s", key.second.second.ToString());
+        }
+        fileVotes.AddVote(vote);
+        pcursor->Next();
+    }
+    return true;
+}
+
+bool CGovernanceDB::LoadObjects(std::map<uint256, CGovernanceObject>& mapObjects)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    pcursor->Seek(std::make_pair(DB_GOVERNANCE_OBJECT, uint256()));
+    while(pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, uint256> key;
+        if(!pcursor->GetKey(key) || key.first != DB_GOVERNANCE_OBJECT) {
+            break;
+        }
+        CGovernanceObject& govobj = mapObjects[key.second];
+        CGovernanceObjectRecord record(govobj);
+        if(!pcursor->GetValue(record)) {
+            return error("CGovernanceDB::LoadObjects -- failed to read object %s", key.second.ToString());
+        }
+        pcursor->Next();
+    }
+
+    // current votes are keyed by outpoint, the vote maps use the indexes of the loaded eternitynode list
+    CDBBatch batch(&GetObfuscateKey());
+    int nInstances = 0;
+    int nInstancesErased = 0;
+    pcursor->Seek(std::make_pair(DB_GOVERNANCE_VOTE_INSTANCE, vote_instance_key_t(uint256(), std::make_pair(COutPoint(uint256(), 0), 0))));
+    while(pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, vote_instance_key_t> key;
+        if(!pcursor->GetKey(key) || key.first != DB_GOVERNANCE_VOTE_INSTANCE) {
+            break;
+        }
+        std::map<uint256, CGovernanceObject>::iterator it = mapObjects.find(key.second.first);
+        int nMNIndex = mnodeman.GetEternitynodeIndex(CTxIn(key.second.second.first));
+        if(it == mapObjects.end() || nMNIndex < 0) {
+            // ClearEternitynodeVotes can only erase the votes of eternitynodes it still knows
+            batch.Erase(key);
+            ++nInstancesErased;
+            pcursor->Next();
+            continue;
+        }
+        vote_instance_t voteInstance;
+        if(!pcursor->GetValue(voteInstance)) {
+            return error("CGovernanceDB::LoadObjects -- failed to read vote of %s for %s", key.second.second.first.ToStringShort(), key.second.first.ToString());
+        }
+        it->second.mapCurrentMNVotes[nMNIndex].mapInstances[key.second.second.second] = voteInstance;
+        ++nInstances;
+        pcursor->Next();
+    }
+    for(std::map<uint256, CGovernanceObject>::iterator it = mapObjects.begin(); it != mapObjects.end(); ++it) {
+        it->second.RebuildVoteTallies();
+    }
+    if(nInstancesErased > 0 && !WriteBatch(batch)) {
+        return error("CGovernanceDB::LoadObjects -- failed to erase votes of unknown eternitynodes");
+    }
+
+    LogPrintf("CGovernanceDB::LoadObjects -- loaded %d objects, %d current votes, erased %d current votes of unknown eternitynodes\n", mapObjects.size(), nInstances, nInstancesErased);
+    return true;
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef GOVERNANCE_DB_H
+#define GOVERNANCE_DB_H
+
+#include "dbwrapper.h"
+#include "governance-object.h"
+#include "governance-vote.h"
+
+class CGovernanceDB;
+
+extern CGovernanceDB* pgovernancedb;
+
+/// Store governance objects and votes in a database instead of governance.dat by default
+static const bool DEFAULT_GOVERNANCE_DB = false;
+
+/// Cache size of the governance database
+static const size_t GOVERNANCE_DB_CACHE_SIZE = 8 << 20;
+
+/// Votes of an object which weren't used for this long are dropped from memory when the database is enabled
+static const int64_t GOVERNANCE_VOTE_CACHE_TIME = 60*60;
+
+/**
+ * Governance object as stored in the governance database: the network
+ * serialization followed by the local state. The current vote of each
+ * eternitynode is stored under its own key and added by LoadObjects, the
+ * votes themselves are stored separately.
+ */
+class CGovernanceObjectRecord
+{
+private:
+    CGovernanceObject& govobj;
+
+public:
+    CGovernanceObjectRecord(CGovernanceObject& govobjIn)
+        : govobj(govobjIn)
+        {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        // the disk format of the object would include all of its votes
+        ::SerReadWrite(s, govobj, SER_NETWORK, nVersion, ser_action);
+        READWRITE(govobj.nDeletionTime);
+        READWRITE(govobj.fExpired);
+        if(ser_action.ForRead()) {
+            govobj.mapCurrentMNVotes.clear();
+            govobj.RebuildVoteTallies();
+            // votes are read from the database when they are needed
+            govobj.fileVotes = CGovernanceObjectVoteFile();
+            govobj.fVotesLoaded = false;
+            govobj.fDirtyRecord = false;
+        }
+    }
+};
+
+/**
+ * LevelDB backed governance store, enabled with -governancedb.
+ *
+ * Objects are written as they are accepted. Each vote is written in one batch
+ * with the current vote of its eternitynode for that signal, keyed by object,
+ * eternitynode outpoint and signal, so a vote costs the same no matter how
+ * many votes the object already has and the stored tallies always match the
+ * stored votes even if the node doesn't shut down cleanly. Records with
+ * changed local state are refreshed periodically and on shutdown. Startup
+ * only reads the records and current votes and doesn't have to read and hash
+ * one large governance.dat.
+ * Objects and their vote tallies stay in memory, the votes themselves are only
+ * kept for objects which were used recently and are read back from here when
+ * they're needed again. The remaining governance manager state is small and
+ * still lives in governance.dat.
+ */
+class CGovernanceDB : public CDBWrapper
+{
+public:
+    CGovernanceDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+
+private:
+    CGovernanceDB(const CGovernanceDB&);
+    void operator=(const CGovernanceDB&);
+
+public:
+    bool WriteObject(CGovernanceObject& govobj);
+    /// Write the records of all objects, or only of those with changed local state if fDirtyOnly is set
+    bool WriteObjects(std::map<uint256, CGovernanceObject>& mapObjects, bool fDirtyOnly = false);
+    /// Write objects together with all votes they hold in memory, used to move governance.dat into the database
+    bool ImportObjects(std::map<uint256, CGovernanceObject>& mapObjects);
+    /// Erase an object together with all votes stored for it
+    bool EraseObject(const uint256& nHash);
+    /// Write a vote together with the current vote of its eternitynode for the signal
+    bool WriteVote(const CGovernanceVote& vote, const vote_instance_t& voteInstance);
+    /// Erase votes of an object together with the current votes of removed eternitynodes
+    bool EraseVotes(const uint256& nParentHash, const std::vector<uint256>& vecVoteHashes, const std::vector<std::pair<COutPoint, int> >& vecInstances);
+
+    /// Read all votes stored for an object into fileVotes
+    bool ReadVotes(const uint256& nParentHash, CGovernanceObjectVoteFile& fileVotes);
+
+    /// Read the records and current votes of all objects, their votes are left in the database until an object needs them
+    bool LoadObjects(std::map<uint256, CGovernanceObject>& mapObjects);
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "spysend.h"
 #include "governance.h"
 #include "governance-classes.h"
+#include "governance-db.h"
 #include "governance-object.h"
 #include "governance-vote.h"
 #include "eternitynodeman.h"
@@ -34,8 +35,12 @@ CGovernanceObject::CGovernanceObject()
   fExpired(false),
   fUnparsable(false),
   mapCurrentMNVotes(),
+  vecVoteTallies((MAX_SUPPORTED_VOTE_SIGNAL + 1) * VOTE_OUTCOME_COUNT),
   mapOrphanVotes(),
-  fileVotes()
+  fileVotes(),
+  fVotesLoaded(true),
+  nTimeVotesUsed(0),
+  fDirtyRecord(false)
 {
     // PARSE JSON DATA STORAGE (STRDATA)
     LoadData();
@@ -62,8 +67,12 @@ CGovernanceObject::CGovernanceObject(uint256 nHashParentIn, int nRevisionIn, int
   fExpired(false),
   fUnparsable(false),
   mapCurrentMNVotes(),
+  vecVoteTallies((MAX_SUPPORTED_VOTE_SIGNAL + 1) * VOTE_OUTCOME_COUNT),
   mapOrphanVotes(),
-  fileVotes()
+  fileVotes(),
+  fVotesLoaded(true),
+  nTimeVotesUsed(0),
+  fDirtyRecord(false)
 {
     // PARSE JSON DATA STORAGE (STRDATA)
     LoadData();
@@ -90,8 +99,12 @@ CGovernanceObject::CGovernanceObject(const CGovernanceObject& other)
   fExpired(other.fExpired),
   fUnparsable(other.fUnparsable),
   mapCurrentMNVotes(other.mapCurrentMNVotes),
+  vecVoteTallies(other.vecVoteTallies),
   mapOrphanVotes(other.mapOrphanVotes),
-  fileVotes(other.fileVotes)
+  fileVotes(other.fileVotes),
+  fVotesLoaded(other.fVotesLoaded),
+  nTimeVotesUsed(other.nTimeVotesUsed),
+  fDirtyRecord(other.fDirtyRecord)
 {}
 
 bool CGovernanceObject::ProcessVote(CNode* pfrom,
@@ -138,6 +151,7 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
     vote_instance_m_it it2 = recVote.mapInstances.find(int(eSignal));
     if(it2 == recVote.mapInstances.end()) {
         it2 = recVote.mapInstances.insert(vote_instance_m_t::value_type(int(eSignal), vote_instance_t())).first;
+        UpdateVoteTally(int(eSignal), it2->second.eOutcome, 1);
     }
     vote_instance_t& voteInstance = it2->second;
 
@@ -187,14 +201,46 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         exception = CGovernanceException(ostr.str(), GOVERNANCE_EXCEPTION_PERMANENT_ERROR);
         return false;
     }
+    UpdateVoteTally(int(eSignal), voteInstance.eOutcome, -1);
     voteInstance = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
-    if(!fileVotes.HasVote(vote.GetHash())) {
+    UpdateVoteTally(int(eSignal), voteInstance.eOutcome, 1);
+    // don't read all votes of a cold object just to add one
+    if(fVotesLoaded && !fileVotes.HasVote(vote.GetHash())) {
         fileVotes.AddVote(vote);
     }
     fDirtyCache = true;
+    // the current vote is written with the vote, a reloaded tally can't miss a stored vote
+    if(pgovernancedb && !pgovernancedb->WriteVote(vote, voteInstance)) {
+        LogPrintf("CGovernanceObject::ProcessVote -- failed to write vote %s\n", vote.GetHash().ToString());
+    }
     return true;
 }
 
+CGovernanceObjectVoteFile& CGovernanceObject::GetVoteFile()
+{
+    if(!fVotesLoaded) {
+        fileVotes = CGovernanceObjectVoteFile();
+        if(pgovernancedb && pgovernancedb->ReadVotes(GetHash(), fileVotes)) {
+            fVotesLoaded = true;
+        }
+        else {
+            LogPrintf("CGovernanceObject::GetVoteFile -- failed to read votes for %s\n", GetHash().ToString());
+        }
+    }
+    nTimeVotesUsed = GetTime();
+    return fileVotes;
+}
+
+void CGovernanceObject::EvictVotes(int64_t nTimeUnused)
+{
+    if(!pgovernancedb || !fVotesLoaded || nTimeVotesUsed > nTimeUnused) {
+        return;
+    }
+    // every vote in fileVotes was written to the database by ProcessVote
+    fileVotes = CGovernanceObjectVoteFile();
+    fVotesLoaded = false;
+}
+
 void CGovernanceObject::RebuildVoteMap()
 {
     vote_m_t mapMNVotesNew;
@@ -208,31 +254,75 @@ void CGovernanceObject::RebuildVoteMap()
         }
     }
     mapCurrentMNVotes = mapMNVotesNew;
+    RebuildVoteTallies();
+}
+
+void CGovernanceObject::UpdateVoteTally(int nSignal, vote_outcome_enum_t eOutcome, int nDelta)
+{
+    // unsupported signals and outcomes are never counted
+    if(nSignal < 0 || nSignal > MAX_SUPPORTED_VOTE_SIGNAL || int(eOutcome) < 0 || int(eOutcome) >= VOTE_OUTCOME_COUNT) {
+        return;
+    }
+    vecVoteTallies[nSignal * VOTE_OUTCOME_COUNT + int(eOutcome)] += nDelta;
+}
+
+void CGovernanceObject::RebuildVoteTallies()
+{
+    vecVoteTallies.assign((MAX_SUPPORTED_VOTE_SIGNAL + 1) * VOTE_OUTCOME_COUNT, 0);
+    for(vote_m_cit it = mapCurrentMNVotes.begin(); it != mapCurrentMNVotes.end(); ++it) {
+        const vote_rec_t& recVote = it->second;
+        for(vote_instance_m_cit it2 = recVote.mapInstances.begin(); it2 != recVote.mapInstances.end(); ++it2) {
+            UpdateVoteTally(it2->first, it2->second.eOutcome, 1);
+        }
+    }
 }
 
 void CGovernanceObject::ClearEternitynodeVotes()
 {
+    // votes of a cold object are removed from a copy read from the database, it stays cold
+    CGovernanceObjectVoteFile fileVotesStored;
+    if(!fVotesLoaded && pgovernancedb) {
+        pgovernancedb->ReadVotes(GetHash(), fileVotesStored);
+    }
+    CGovernanceObjectVoteFile& fileVotesRemove = fVotesLoaded ? fileVotes : fileVotesStored;
+    std::vector<uint256> vecVoteHashesRemoved;
+    std::vector<std::pair<COutPoint, int> > vecInstancesRemoved;
+
     vote_m_it it = mapCurrentMNVotes.begin();
     while(it != mapCurrentMNVotes.end()) {
         bool fIndexRebuilt = false;
         CTxIn vinEternitynode;
         bool fRemove = true;
-        if(mnodeman.Get(it->first, vinEternitynode, fIndexRebuilt)) {
+        bool fKnown = mnodeman.Get(it->first, vinEternitynode, fIndexRebuilt);
+        if(fKnown) {
             if(mnodeman.Has(vinEternitynode)) {
                 fRemove = false;
             }
             else {
-                fileVotes.RemoveVotesFromEternitynode(vinEternitynode);
+                fileVotesRemove.RemoveVotesFromEternitynode(vinEternitynode, vecVoteHashesRemoved);
             }
         }
 
         if(fRemove) {
+            const vote_rec_t& recVote = it->second;
+            for(vote_instance_m_cit it2 = recVote.mapInstances.begin(); it2 != recVote.mapInstances.end(); ++it2) {
+                UpdateVoteTally(it2->first, it2->second.eOutcome, -1);
+                if(fKnown) {
+                    vecInstancesRemoved.push_back(std::make_pair(vinEternitynode.prevout, it2->first));
+                }
+            }
             mapCurrentMNVotes.erase(it++);
         }
         else {
             ++it;
         }
     }
+
+    // otherwise GetVoteFile would read them back
+    if(pgovernancedb && (!vecVoteHashesRemoved.empty() || !vecInstancesRemoved.empty()) &&
+       !pgovernancedb->EraseVotes(GetHash(), vecVoteHashesRemoved, vecInstancesRemoved)) {
+        LogPrintf("CGovernanceObject::ClearEternitynodeVotes -- failed to erase votes for %s\n", GetHash().ToString());
+    }
 }
 
 std::string CGovernanceObject::GetSignatureMessage() const
@@ -604,19 +694,11 @@ bool CGovernanceObject::IsCollateralValid(std::string& strError)
 
 int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const
 {
-    int nCount = 0;
-    for(vote_m_cit it = mapCurrentMNVotes.begin(); it != mapCurrentMNVotes.end(); ++it) {
-        const vote_rec_t& recVote = it->second;
-        vote_instance_m_cit it2 = recVote.mapInstances.find(eVoteSignalIn);
-        if(it2 == recVote.mapInstances.end()) {
-            continue;
-        }
-        const vote_instance_t& voteInstance = it2->second;
-        if(voteInstance.eOutcome == eVoteOutcomeIn) {
-            ++nCount;
-        }
+    // tallies are maintained by ProcessVote, ClearEternitynodeVotes and RebuildVoteMap
+    if(int(eVoteSignalIn) < 0 || int(eVoteSignalIn) > MAX_SUPPORTED_VOTE_SIGNAL || int(eVoteOutcomeIn) < 0 || int(eVoteOutcomeIn) >= VOTE_OUTCOME_COUNT) {
+        return 0;
     }
-    return nCount;
+    return vecVoteTallies[int(eVoteSignalIn) * VOTE_OUTCOME_COUNT + int(eVoteOutcomeIn)];
 }
 
 /**
@@ -695,6 +777,7 @@ void CGovernanceObject::UpdateSentinelVariables()
         fCachedDelete = true;
         if(nDeletionTime == 0) {
             nDeletionTime = GetAdjustedTime();
+            fDirtyRecord = true;
         }
     }
     if(GetAbsoluteYesCount(VOTE_SIGNAL_ENDORSED) >= nAbsVoteReq) fCachedEndorsed = true;
@@ -108,12 +108,19 @@ struct vote_rec_t {
 *
 */
 
+/// Number of possible vote outcomes, see vote_outcome_enum_t
+static const int VOTE_OUTCOME_COUNT = VOTE_OUTCOME_ABSTAIN + 1;
+
 class CGovernanceObject
 {
     friend class CGovernanceManager;
 
     friend class CGovernanceTriggerManager;
 
+    friend class CGovernanceObjectRecord;
+
+    friend class CGovernanceDB;
+
 public: // Types
     typedef std::map<int, vote_rec_t> vote_m_t;
 
@@ -183,11 +190,24 @@ private:
 
     vote_m_t mapCurrentMNVotes;
 
+    /// Number of vote instances in mapCurrentMNVotes per signal and outcome,
+    /// indexed by signal * VOTE_OUTCOME_COUNT + outcome, kept up to date with mapCurrentMNVotes
+    std::vector<int> vecVoteTallies;
+
     /// Limited map of votes orphaned by MN
     vote_mcache_t mapOrphanVotes;
 
     CGovernanceObjectVoteFile fileVotes;
 
+    /// False while the votes of this object are only stored in the governance database
+    bool fVotesLoaded;
+
+    /// Last time fileVotes was accessed, unused vote files are dropped from memory
+    int64_t nTimeVotesUsed;
+
+    /// Local state changed since the object record was last written to the governance database
+    bool fDirtyRecord;
+
 public:
     CGovernanceObject();
 
@@ -247,8 +267,18 @@ public:
         fDirtyCache = true;
     }
 
-    CGovernanceObjectVoteFile& GetVoteFile() {
-        return fileVotes;
+    /// Get the votes of this object, reading them from the governance database if they were dropped from memory
+    CGovernanceObjectVoteFile& GetVoteFile();
+
+    /// Drop the votes from memory if they are in the governance database and weren't used since nTimeUnused
+    void EvictVotes(int64_t nTimeUnused);
+
+    bool IsSetVotesLoaded() const {
+        return fVotesLoaded;
+    }
+
+    bool IsSetDirtyRecord() const {
+        return fDirtyRecord;
     }
 
     // Signature related functions
@@ -323,6 +353,9 @@ public:
             READWRITE(fExpired);
             READWRITE(mapCurrentMNVotes);
             READWRITE(fileVotes);
+            if(ser_action.ForRead()) {
+                RebuildVoteTallies();
+            }
             LogPrint("gobject", "CGovernanceObject::SerializationOp hash = %s, vote count = %d\n", GetHash().ToString(), fileVotes.GetVoteCount());
         }
 
@@ -346,6 +379,12 @@ private:
 
     void RebuildVoteMap();
 
+    /// Add nDelta to the tally of a single vote instance
+    void UpdateVoteTally(int nSignal, vote_outcome_enum_t eOutcome, int nDelta);
+
+    /// Recount vecVoteTallies from mapCurrentMNVotes
+    void RebuildVoteTallies();
+
     /// Called when MN's which have voted on this object have been removed
     void ClearEternitynodeVotes();
 
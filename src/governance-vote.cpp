@@ -209,7 +209,8 @@ CGovernanceVote::CGovernanceVote()
       nParentHash(),
       nVoteOutcome(int(VOTE_OUTCOME_NONE)),
       nTime(0),
-      vchSig()
+      vchSig(),
+      keyIDVerified()
 {}
 
 CGovernanceVote::CGovernanceVote(CTxIn vinEternitynodeIn, uint256 nParentHashIn, vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn)
@@ -220,7 +221,8 @@ CGovernanceVote::CGovernanceVote(CTxIn vinEternitynodeIn, uint256 nParentHashIn,
       nParentHash(nParentHashIn),
       nVoteOutcome(eVoteOutcomeIn),
       nTime(GetAdjustedTime()),
-      vchSig()
+      vchSig(),
+      keyIDVerified()
 {}
 
 void CGovernanceVote::Relay() const
@@ -239,6 +241,8 @@ bool CGovernanceVote::Sign(CKey& keyEternitynode, CPubKey& pubKeyEternitynode)
     std::string strMessage = vinEternitynode.prevout.ToStringShort() + "|" + nParentHash.ToString() + "|" +
         boost::lexical_cast<std::string>(nVoteSignal) + "|" + boost::lexical_cast<std::string>(nVoteOutcome) + "|" + boost::lexical_cast<std::string>(nTime);
 
+    keyIDVerified.SetNull();
+
     if(!spySendSigner.SignMessage(strMessage, vchSig, keyEternitynode)) {
         LogPrintf("CGovernanceVote::Sign -- SignMessage() failed\n");
         return false;
@@ -281,6 +285,10 @@ bool CGovernanceVote::IsValid(bool fSignatureCheck) const
 
     if(!fSignatureCheck) return true;
 
+    // verified already and the eternitynode key didn't change since then
+    CKeyID keyIDEternitynode = infoMn.pubKeyEternitynode.GetID();
+    if(keyIDVerified == keyIDEternitynode) return true;
+
     std::string strError;
     std::string strMessage = vinEternitynode.prevout.ToStringShort() + "|" + nParentHash.ToString() + "|" +
         boost::lexical_cast<std::string>(nVoteSignal) + "|" + boost::lexical_cast<std::string>(nVoteOutcome) + "|" + boost::lexical_cast<std::string>(nTime);
@@ -290,6 +298,7 @@ bool CGovernanceVote::IsValid(bool fSignatureCheck) const
         return false;
     }
 
+    keyIDVerified = keyIDEternitynode;
     return true;
 }
 
@@ -100,6 +100,10 @@ private:
     int64_t nTime;
     std::vector<unsigned char> vchSig;
 
+    // memory only: eternitynode key the signature was last verified with,
+    // signature checks are skipped while the eternitynode still uses this key
+    mutable CKeyID keyIDVerified;
+
 public:
     CGovernanceVote();
     CGovernanceVote(CTxIn vinEternitynodeIn, uint256 nParentHashIn, vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn);
@@ -116,9 +120,9 @@ public:
 
     const uint256& GetParentHash() const { return nParentHash; }
 
-    void SetTime(int64_t nTimeIn) { nTime = nTimeIn; }
+    void SetTime(int64_t nTimeIn) { nTime = nTimeIn; keyIDVerified.SetNull(); }
 
-    void SetSignature(const std::vector<unsigned char>& vchSigIn) { vchSig = vchSigIn; }
+    void SetSignature(const std::vector<unsigned char>& vchSigIn) { vchSig = vchSigIn; keyIDVerified.SetNull(); }
 
     bool Sign(CKey& keyEternitynode, CPubKey& pubKeyEternitynode);
     bool IsValid(bool fSignatureCheck) const;
@@ -197,6 +201,10 @@ public:
         READWRITE(nVoteSignal);
         READWRITE(nTime);
         READWRITE(vchSig);
+        if(ser_action.ForRead()) {
+            // the verified signature belonged to the vote this one was before
+            keyIDVerified.SetNull();
+        }
     }
 
 };
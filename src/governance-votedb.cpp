@@ -53,11 +53,12 @@ std::vector<CGovernanceVote> CGovernanceObjectVoteFile::GetVotes() const
     return vecResult;
 }
 
-void CGovernanceObjectVoteFile::RemoveVotesFromEternitynode(const CTxIn& vinEternitynode)
+void CGovernanceObjectVoteFile::RemoveVotesFromEternitynode(const CTxIn& vinEternitynode, std::vector<uint256>& vecVoteHashesRemoved)
 {
     vote_l_it it = listVotes.begin();
     while(it != listVotes.end()) {
         if(it->GetVinEternitynode() == vinEternitynode) {
+            vecVoteHashesRemoved.push_back(it->GetHash());
             --nMemoryVotes;
             mapVoteIndex.erase(it->GetHash());
             listVotes.erase(it++);
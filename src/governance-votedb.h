@@ -7,6 +7,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #include "governance-vote.h"
 #include "serialize.h"
@@ -18,7 +19,8 @@
  * which older votes a flushed to a disk file.
  *
  * Note: This is a stub implementation that doesn't limit the number of votes held
- * in memory and doesn't flush to disk.
+ * in memory and doesn't flush to disk. With -governancedb CGovernanceObject drops
+ * whole vote files which weren't used for a while and reads them back when needed.
  */
 class CGovernanceObjectVoteFile
 {
@@ -70,9 +72,19 @@ public:
 
     std::vector<CGovernanceVote> GetVotes() const;
 
+    /**
+     * Access the votes held in memory without copying them
+     */
+    const vote_l_t& GetVoteList() const {
+        return listVotes;
+    }
+
     CGovernanceObjectVoteFile& operator=(const CGovernanceObjectVoteFile& other);
 
-    void RemoveVotesFromEternitynode(const CTxIn& vinEternitynode);
+    /**
+     * Remove all votes of an eternitynode, their hashes are added to vecVoteHashesRemoved
+     */
+    void RemoveVotesFromEternitynode(const CTxIn& vinEternitynode, std::vector<uint256>& vecVoteHashesRemoved);
 
     ADD_SERIALIZE_METHODS;
 
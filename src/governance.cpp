@@ -20,6 +20,11 @@ int nSubmittedFinalBudget;
 
 const std::string CGovernanceManager::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-11";
 
+std::string CGovernanceManager::GetSerializationVersion()
+{
+    return pgovernancedb ? SERIALIZATION_VERSION_STRING + "-DB" : SERIALIZATION_VERSION_STRING;
+}
+
 CGovernanceManager::CGovernanceManager()
     : pCurrentBlockIndex(NULL),
       nTimeLastDiff(0),
@@ -31,6 +36,7 @@ CGovernanceManager::CGovernanceManager()
       nHashWatchdogCurrent(),
       nTimeWatchdogCurrent(0),
       mapVoteToObject(MAX_CACHE_SIZE),
+      mapObjectToVotes(),
       mapInvalidVotes(MAX_CACHE_SIZE),
       mapOrphanVotes(MAX_CACHE_SIZE),
       mapLastEternitynodeObject(),
@@ -360,7 +366,10 @@ bool CGovernanceManager::AddGovernanceObject(CGovernanceObject& govobj, bool& fA
     }
 
     // INSERT INTO OUR GOVERNANCE OBJECT MEMORY
-    mapObjects.insert(std::make_pair(nHash, govobj));
+    object_m_it itNew = mapObjects.insert(std::make_pair(nHash, govobj)).first;
+    if(pgovernancedb) {
+        pgovernancedb->WriteObject(itNew->second);
+    }
 
     // SHOULD WE ADD THIS OBJECT TO ANY OTHER MANANGERS?
 
@@ -408,6 +417,7 @@ bool CGovernanceManager::UpdateCurrentWatchdog(CGovernanceObject& watchdogNew)
         if(it != mapObjects.end()) {
             LogPrint("gobject", "CGovernanceManager::UpdateCurrentWatchdog -- Expiring previous current watchdog, hash = %s\n", nHashWatchdogCurrent.ToString());
             it->second.fExpired = true;
+            it->second.fDirtyRecord = true;
             if(it->second.nDeletionTime == 0) {
                 it->second.nDeletionTime = nNow;
             }
@@ -443,6 +453,7 @@ void CGovernanceManager::UpdateCachesAndClean()
                 if(it2 != mapObjects.end()) {
                     LogPrint("gobject", "CGovernanceManager::UpdateCachesAndClean -- Expiring watchdog: %s, expiration time = %d\n", it->first.ToString(), it->second);
                     it2->second.fExpired = true;
+                    it2->second.fDirtyRecord = true;
                     if(it2->second.nDeletionTime == 0) {
                         it2->second.nDeletionTime = nNow;
                     }
@@ -520,27 +531,34 @@ void CGovernanceManager::UpdateCachesAndClean()
             mnodeman.RemoveGovernanceObject(pObj->GetHash());
 
             // Remove vote references
-            const object_ref_cache_t::list_t& listItems = mapVoteToObject.GetItemList();
-            object_ref_cache_t::list_cit lit = listItems.begin();
-            while(lit != listItems.end()) {
-                if(lit->value == pObj) {
-                    uint256 nKey = lit->key;
-                    ++lit;
-                    mapVoteToObject.Erase(nKey);
-                }
-                else {
-                    ++lit;
+            hash_s_m_it itVotes = mapObjectToVotes.find(nHash);
+            if(itVotes != mapObjectToVotes.end()) {
+                for(hash_s_cit itVote = itVotes->second.begin(); itVote != itVotes->second.end(); ++itVote) {
+                    CGovernanceObject* pObjRef = NULL;
+                    if(mapVoteToObject.Get(*itVote, pObjRef) && pObjRef == pObj) {
+                        mapVoteToObject.Erase(*itVote);
+                    }
                 }
+                mapObjectToVotes.erase(itVotes);
             }
             if(pObj->nObjectType == GOVERNANCE_OBJECT_WATCHDOG) {
                 mapWatchdogObjects.erase(it->first);
             }
+            if(pgovernancedb) {
+                pgovernancedb->EraseObject(nHash);
+            }
             mapObjects.erase(it++);
         } else {
+            pObj->EvictVotes(GetTime() - GOVERNANCE_VOTE_CACHE_TIME);
             ++it;
         }
     }
 
+    // votes are written as they arrive, this only catches expired or deleted objects
+    if(pgovernancedb && !pgovernancedb->WriteObjects(mapObjects, true)) {
+        LogPrintf("CGovernanceManager::UpdateCachesAndClean -- failed to write governance objects\n");
+    }
+
     fRateChecksEnabled = true;
 }
 
@@ -581,10 +599,10 @@ std::vector<CGovernanceVote> CGovernanceManager::GetCurrentVotes(const uint256&
     // Compile a list of Eternitynode collateral outpoints for which to get votes
     std::vector<CTxIn> vecMNTxIn;
     if (mnCollateralOutpointFilter == CTxIn()) {
-        std::vector<CEternitynode> mnlist = mnodeman.GetFullEternitynodeVector();
-        for (std::vector<CEternitynode>::iterator it = mnlist.begin(); it != mnlist.end(); ++it)
+        eternitynode_list_t mnlist = mnodeman.GetEternitynodeList();
+        for (std::vector<eternitynode_ptr_t>::const_iterator it = mnlist->begin(); it != mnlist->end(); ++it)
         {
-            vecMNTxIn.push_back(it->vin);
+            vecMNTxIn.push_back((*it)->vin);
         }
     }
     else {
@@ -753,7 +771,8 @@ void CGovernanceManager::Sync(CNode* pfrom, const uint256& nProp, const CBloomFi
     LogPrint("gobject", "CGovernanceManager::Sync -- syncing to peer=%d, nProp = %s\n", pfrom->id, nProp.ToString());
 
     {
-        LOCK2(cs_main, cs);
+        // votes are verified against the eternitynode list only, cs_main is not needed
+        LOCK(cs);
 
         if(nProp == uint256()) {
             // all valid objects, no votes
@@ -797,15 +816,22 @@ void CGovernanceManager::Sync(CNode* pfrom, const uint256& nProp, const CBloomFi
             pfrom->PushInventory(CInv(MSG_GOVERNANCE_OBJECT, it->first));
             ++nObjCount;
 
-            std::vector<CGovernanceVote> vecVotes = govobj.GetVoteFile().GetVotes();
-            for(size_t i = 0; i < vecVotes.size(); ++i) {
-                if(!vecVotes[i].IsValid(true)) {
+            // votes read back from the governance database must be found when the peer requests them
+            if(pgovernancedb && !govobj.IsSetVotesLoaded()) {
+                AddVoteReferences(govobj);
+            }
+
+            // signatures are only verified again if the eternitynode changed its key
+            const CGovernanceObjectVoteFile::vote_l_t& listVotes = govobj.GetVoteFile().GetVoteList();
+            for(CGovernanceObjectVoteFile::vote_l_cit itVote = listVotes.begin(); itVote != listVotes.end(); ++itVote) {
+                uint256 nVoteHash = itVote->GetHash();
+                if(filter.contains(nVoteHash)) {
                     continue;
                 }
-                if(filter.contains(vecVotes[i].GetHash())) {
+                if(!itVote->IsValid(true)) {
                     continue;
                 }
-                pfrom->PushInventory(CInv(MSG_GOVERNANCE_OBJECT_VOTE, vecVotes[i].GetHash()));
+                pfrom->PushInventory(CInv(MSG_GOVERNANCE_OBJECT_VOTE, nVoteHash));
                 ++nVoteCount;
             }
         }
@@ -981,6 +1007,7 @@ bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote,
     bool fOk = govobj.ProcessVote(pfrom, vote, exception);
     if(fOk) {
         mapVoteToObject.Insert(nHashVote, &govobj);
+        mapObjectToVotes[nHashGovobj].insert(nHashVote);
 
         if(govobj.GetObjectType() == GOVERNANCE_OBJECT_WATCHDOG) {
             mnodeman.UpdateWatchdogVoteTime(vote.GetVinEternitynode());
@@ -1062,6 +1089,9 @@ void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nH
 
         if(pObj) {
             filter = CBloomFilter(Params().GetConsensus().nGovernanceFilterElements, GOVERNANCE_FILTER_FP_RATE, GetRandInt(999999), BLOOM_UPDATE_ALL);
+            if(pgovernancedb && !pObj->IsSetVotesLoaded()) {
+                AddVoteReferences(*pObj);
+            }
             std::vector<CGovernanceVote> vecVotes = pObj->GetVoteFile().GetVotes();
             for(size_t i = 0; i < vecVotes.size(); ++i) {
                 filter.insert(vecVotes[i].GetHash());
@@ -1209,15 +1239,27 @@ bool CGovernanceManager::AcceptMessage(const uint256& nHash, hash_s_t& setHash)
 void CGovernanceManager::RebuildIndexes()
 {
     mapVoteToObject.Clear();
+    mapObjectToVotes.clear();
     for(object_m_it it = mapObjects.begin(); it != mapObjects.end(); ++it) {
         CGovernanceObject& govobj = it->second;
-        std::vector<CGovernanceVote> vecVotes = govobj.GetVoteFile().GetVotes();
-        for(size_t i = 0; i < vecVotes.size(); ++i) {
-            mapVoteToObject.Insert(vecVotes[i].GetHash(), &govobj);
+        // votes still in the governance database are indexed once they are read
+        if(govobj.IsSetVotesLoaded()) {
+            AddVoteReferences(govobj);
         }
     }
 }
 
+void CGovernanceManager::AddVoteReferences(CGovernanceObject& govobj)
+{
+    hash_s_t& setVotes = mapObjectToVotes[govobj.GetHash()];
+    const CGovernanceObjectVoteFile::vote_l_t& listVotes = govobj.GetVoteFile().GetVoteList();
+    for(CGovernanceObjectVoteFile::vote_l_cit it = listVotes.begin(); it != listVotes.end(); ++it) {
+        uint256 nVoteHash = it->GetHash();
+        mapVoteToObject.Insert(nVoteHash, &govobj);
+        setVotes.insert(nVoteHash);
+    }
+}
+
 int CGovernanceManager::GetEternitynodeIndex(const CTxIn& eternitynodeVin)
 {
     LOCK(cs);
@@ -1256,6 +1298,38 @@ void CGovernanceManager::AddCachedTriggers()
     }
 }
 
+bool CGovernanceManager::LoadObjectsFromDB()
+{
+    if(!pgovernancedb) {
+        return true;
+    }
+    LOCK(cs);
+    int64_t nStart = GetTimeMillis();
+    if(!mapObjectsToImport.empty()) {
+        LogPrintf("CGovernanceManager::LoadObjectsFromDB -- importing %d objects from governance.dat\n", mapObjectsToImport.size());
+        if(!pgovernancedb->ImportObjects(mapObjectsToImport)) {
+            return false;
+        }
+        mapObjectsToImport.clear();
+    }
+    if(!pgovernancedb->LoadObjects(mapObjects)) {
+        return false;
+    }
+    LogPrintf("Governance objects loaded from database  %dms\n", GetTimeMillis() - nStart);
+    return true;
+}
+
+void CGovernanceManager::WriteObjectsToDB()
+{
+    if(!pgovernancedb) {
+        return;
+    }
+    LOCK(cs);
+    if(!pgovernancedb->WriteObjects(mapObjects)) {
+        LogPrintf("CGovernanceManager::WriteObjectsToDB -- failed to write governance objects\n");
+    }
+}
+
 void CGovernanceManager::InitOnLoad()
 {
     LOCK(cs);
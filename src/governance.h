@@ -11,6 +11,7 @@
 #include "cachemap.h"
 #include "cachemultimap.h"
 #include "chain.h"
+#include "governance-db.h"
 #include "governance-exceptions.h"
 #include "governance-object.h"
 #include "governance-vote.h"
@@ -209,6 +210,10 @@ public: // Types
 
     typedef hash_s_t::const_iterator hash_s_cit;
 
+    typedef std::map<uint256, hash_s_t> hash_s_m_t;
+
+    typedef hash_s_m_t::iterator hash_s_m_it;
+
     typedef std::map<uint256, object_time_pair_t> object_time_m_t;
 
     typedef object_time_m_t::iterator object_time_m_it;
@@ -226,6 +231,9 @@ private:
 
     static const std::string SERIALIZATION_VERSION_STRING;
 
+    /// governance.dat has a different format when objects are stored in the governance database
+    static std::string GetSerializationVersion();
+
     // Keep track of current block index
     const CBlockIndex *pCurrentBlockIndex;
 
@@ -247,12 +255,19 @@ private:
 
     object_ref_cache_t mapVoteToObject;
 
+    // reverse index of mapVoteToObject: vote hashes by object hash, used to drop the
+    // references of a deleted object. Hashes pruned from mapVoteToObject may be left over
+    hash_s_m_t mapObjectToVotes;
+
     vote_cache_t mapInvalidVotes;
 
     vote_mcache_t mapOrphanVotes;
 
     txout_m_t mapLastEternitynodeObject;
 
+    /// Objects read from a governance.dat written without the governance database, moved into it by LoadObjectsFromDB
+    object_m_t mapObjectsToImport;
+
     hash_s_t setRequestedObjects;
 
     hash_s_t setRequestedVotes;
@@ -313,9 +328,11 @@ public:
         nHashWatchdogCurrent = uint256();
         nTimeWatchdogCurrent = 0;
         mapVoteToObject.Clear();
+        mapObjectToVotes.clear();
         mapInvalidVotes.Clear();
         mapOrphanVotes.Clear();
         mapLastEternitynodeObject.clear();
+        mapObjectsToImport.clear();
     }
 
     std::string ToString() const;
@@ -330,23 +347,38 @@ public:
             READWRITE(strVersion);
         }
         else {
-            strVersion = SERIALIZATION_VERSION_STRING;
+            strVersion = GetSerializationVersion();
             READWRITE(strVersion);
         }
         READWRITE(mapSeenGovernanceObjects);
         READWRITE(mapInvalidVotes);
         READWRITE(mapOrphanVotes);
-        READWRITE(mapObjects);
+        // objects and their votes are kept in the governance database when it's enabled,
+        // a file written before it was enabled still has them and they are imported
+        bool fImport = ser_action.ForRead() && pgovernancedb && (strVersion == SERIALIZATION_VERSION_STRING);
+        if(fImport) {
+            READWRITE(mapObjectsToImport);
+        }
+        else if(!pgovernancedb) {
+            READWRITE(mapObjects);
+        }
         READWRITE(mapWatchdogObjects);
         READWRITE(nHashWatchdogCurrent);
         READWRITE(nTimeWatchdogCurrent);
         READWRITE(mapLastEternitynodeObject);
-        if(ser_action.ForRead() && (strVersion != SERIALIZATION_VERSION_STRING)) {
+        if(ser_action.ForRead() && !fImport && (strVersion != GetSerializationVersion())) {
             Clear();
             return;
         }
     }
 
+    /// Add the objects stored in the governance database, call after governance.dat was loaded.
+    /// Objects of a governance.dat written without the database are imported first.
+    bool LoadObjectsFromDB();
+
+    /// Store the current local state of every object in the governance database
+    void WriteObjectsToDB();
+
     void UpdatedBlockTip(const CBlockIndex *pindex);
     int64_t GetLastDiffTime() { return nTimeLastDiff; }
     void UpdateLastDiffTime(int64_t nTimeIn) { nTimeLastDiff = nTimeIn; }
@@ -421,6 +453,9 @@ private:
 
     void RebuildIndexes();
 
+    /// Index the votes of an object by hash, reading them from the governance database if needed
+    void AddVoteReferences(CGovernanceObject& govobj);
+
     /// Returns MN index, handling the case of index rebuilds
     int GetEternitynodeIndex(const CTxIn& eternitynodeVin);
 
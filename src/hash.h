@@ -25,6 +25,7 @@
 #include "crypto/sph_shavite.h"
 #include "crypto/sph_simd.h"
 #include "crypto/sph_echo.h"
+#include "crypto/x11.h"
 
 #include <vector>
 
@@ -291,9 +292,7 @@ inline uint256 HashX11(const T1 pbegin, const T1 pend)
     sph_skein512_context     ctx_skein;
     sph_luffa512_context     ctx_luffa;
     sph_cubehash512_context  ctx_cubehash;
-    sph_shavite512_context   ctx_shavite;
     sph_simd512_context      ctx_simd;
-    sph_echo512_context      ctx_echo;
     static unsigned char pblank[1];
 
     uint512 hash[11];
@@ -330,17 +329,13 @@ inline uint256 HashX11(const T1 pbegin, const T1 pend)
     sph_cubehash512 (&ctx_cubehash, static_cast<const void*>(&hash[6]), 64);
     sph_cubehash512_close(&ctx_cubehash, static_cast<void*>(&hash[7]));
 
-    sph_shavite512_init(&ctx_shavite);
-    sph_shavite512(&ctx_shavite, static_cast<const void*>(&hash[7]), 64);
-    sph_shavite512_close(&ctx_shavite, static_cast<void*>(&hash[8]));
+    X11Shavite512_64(static_cast<const void*>(&hash[7]), static_cast<void*>(&hash[8]));
 
     sph_simd512_init(&ctx_simd);
     sph_simd512 (&ctx_simd, static_cast<const void*>(&hash[8]), 64);
     sph_simd512_close(&ctx_simd, static_cast<void*>(&hash[9]));
 
-    sph_echo512_init(&ctx_echo);
-    sph_echo512 (&ctx_echo, static_cast<const void*>(&hash[9]), 64);
-    sph_echo512_close(&ctx_echo, static_cast<void*>(&hash[10]));
+    X11Echo512_64(static_cast<const void*>(&hash[9]), static_cast<void*>(&hash[10]));
 
     return hash[10].trim256();
 }
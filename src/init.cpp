@@ -17,6 +17,7 @@
 #include "checkpoints.h"
 #include "compat/sanity.h"
 #include "consensus/validation.h"
+#include "crypto/x11.h"
 #include "httpserver.h"
 #include "httprpc.h"
 #include "key.h"
@@ -45,6 +46,7 @@
 
 #include "activeeternitynode.h"
 #include "spysend.h"
+#include "spysend-sigcheck.h"
 #include "dsnotificationinterface.h"
 #include "flat-database.h"
 #include "governance.h"
@@ -94,6 +96,7 @@ static const bool DEFAULT_PROXYRANDOMIZE = true;
 static const bool DEFAULT_REST_ENABLE = false;
 static const bool DEFAULT_DISABLE_SAFEMODE = false;
 static const bool DEFAULT_STOPAFTERBLOCKIMPORT = false;
+static const unsigned int DEFAULT_CACHE_SAVE_INTERVAL = 0;
 
 #if ENABLE_ZMQ
 static CZMQNotificationInterface* pzmqNotificationInterface = NULL;
@@ -229,6 +232,7 @@ void PrepareShutdown()
     flatdb1.Dump(mnodeman);
     CFlatDB<CEternitynodePayments> flatdb2("enpayments.dat", "magicEternitynodePaymentsCache");
     flatdb2.Dump(enpayments);
+    governance.WriteObjectsToDB();
     CFlatDB<CGovernanceManager> flatdb3("governance.dat", "magicGovernanceCache");
     flatdb3.Dump(governance);
     CFlatDB<CNetFulfilledRequestManager> flatdb4("netfulfilled.dat", "magicFulfilledCache");
@@ -261,6 +265,8 @@ void PrepareShutdown()
         delete pblocktree;
         pblocktree = NULL;
     }
+    delete pgovernancedb;
+    pgovernancedb = NULL;
 #ifdef ENABLE_WALLET
     if (pwalletMain)
         pwalletMain->Flush(true);
@@ -546,6 +552,7 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-limitfreerelay=<n>", strprintf("Continuously rate-limit free transactions to <n>*1000 bytes per minute (default: %u)", DEFAULT_LIMITFREERELAY));
         strUsage += HelpMessageOpt("-relaypriority", strprintf("Require high priority for relaying free or low-fee transactions (default: %u)", DEFAULT_RELAYPRIORITY));
         strUsage += HelpMessageOpt("-maxsigcachesize=<n>", strprintf("Limit size of signature cache to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE));
+        strUsage += HelpMessageOpt("-msgsigcachesize=<n>", strprintf("Limit size of eternitynode, InstantSend and governance message signature cache to <n> MiB (default: %u)", DEFAULT_MAX_MSG_SIG_CACHE_SIZE));
     }
     strUsage += HelpMessageOpt("-minrelaytxfee=<amt>", strprintf(_("Fees (in %s/kB) smaller than this are considered zero fee for relaying, mining and transaction creation (default: %s)"),
         CURRENCY_UNIT, FormatMoney(DEFAULT_MIN_RELAY_TX_FEE)));
@@ -567,6 +574,8 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-mnconf=<file>", strprintf(_("Specify eternitynode configuration file (default: %s)"), "eternitynode.conf"));
     strUsage += HelpMessageOpt("-mnconflock=<n>", strprintf(_("Lock eternitynodes from eternitynode configuration file (default: %u)"), 1));
     strUsage += HelpMessageOpt("-eternitynodeprivkey=<n>", _("Set the eternitynode private key"));
+    strUsage += HelpMessageOpt("-cachesaveinterval=<n>", strprintf(_("Save eternitynode, payment, governance and fulfilled request caches every <n> minutes in the background, 0 saves them on shutdown only (default: %u)"), DEFAULT_CACHE_SAVE_INTERVAL));
+    strUsage += HelpMessageOpt("-governancedb=<n>", strprintf(_("Store governance objects and votes in a database instead of governance.dat (0-1, default: %u)"), DEFAULT_GOVERNANCE_DB));
 
     strUsage += HelpMessageGroup(_("SpySend options:"));
     strUsage += HelpMessageOpt("-enablespysend=<n>", strprintf(_("Enable use of automated SpySend for funds stored in this wallet (0-1, default: %u)"), 0));
@@ -641,6 +650,22 @@ static void BlockNotifyCallback(bool initialSync, const CBlockIndex *pBlockIndex
     boost::thread t(runCommand, strCmd); // thread runs free
 }
 
+/** Save the Eternity caches from the scheduler thread, see -cachesaveinterval */
+static void SaveCacheSnapshots()
+{
+    // PrepareShutdown dumps them anyway
+    if (ShutdownRequested())
+        return;
+    CFlatDB<CEternitynodeMan> flatdb1("mncache.dat", "magicEternitynodeCache");
+    flatdb1.DumpSnapshot(mnodeman);
+    CFlatDB<CEternitynodePayments> flatdb2("enpayments.dat", "magicEternitynodePaymentsCache");
+    flatdb2.DumpSnapshot(enpayments);
+    CFlatDB<CGovernanceManager> flatdb3("governance.dat", "magicGovernanceCache");
+    flatdb3.DumpSnapshot(governance);
+    CFlatDB<CNetFulfilledRequestManager> flatdb4("netfulfilled.dat", "magicFulfilledCache");
+    flatdb4.DumpSnapshot(netfulfilledman);
+}
+
 struct CImportingNow
 {
     CImportingNow() {
@@ -1167,6 +1192,10 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     // Initialize fast PRNG
     seed_insecure_rand(false);
 
+    // Select X11 implementation
+    std::string strX11Impl = X11AutoDetect();
+    LogPrintf("Using X11 implementation: %s\n", strX11Impl);
+
     // Initialize elliptic curve code
     ECC_Start();
     globalVerifyHandle.reset(new ECCVerifyHandle());
@@ -1217,8 +1246,10 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
 
     LogPrintf("Using %u threads for script verification\n", nScriptCheckThreads);
     if (nScriptCheckThreads) {
-        for (int i=0; i<nScriptCheckThreads-1; i++)
+        for (int i=0; i<nScriptCheckThreads-1; i++) {
             threadGroup.create_thread(&ThreadScriptCheck);
+            threadGroup.create_thread(&ThreadSignedMessageCheck);
+        }
     }
 
     if (mapArgs.count("-sporkkey")) // spork priv key
@@ -1746,6 +1777,7 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
             }
         }
         pwalletMain->SetBroadcastTransactions(GetBoolArg("-walletbroadcast", DEFAULT_WALLETBROADCAST));
+        pwalletMain->PruneSpySendRounds();
     } // (!fDisableWallet)
 #else // ENABLE_WALLET
     LogPrintf("No wallet support compiled in!\n");
@@ -1868,6 +1900,10 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
 
     // ********************************************************* Step 11b: Load cache data
 
+    if(GetBoolArg("-governancedb", DEFAULT_GOVERNANCE_DB)) {
+        pgovernancedb = new CGovernanceDB(GOVERNANCE_DB_CACHE_SIZE);
+    }
+
     // LOAD SERIALIZED DAT FILES INTO DATA CACHES FOR INTERNAL USE
 
     uiInterface.InitMessage(_("Loading eternitynode cache..."));
@@ -1888,6 +1924,9 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
         if(!flatdb3.Load(governance)) {
             return InitError("Failed to load governance cache from governance.dat");
         }
+        if(!governance.LoadObjectsFromDB()) {
+            return InitError("Failed to load governance objects from the governance database");
+        }
         governance.InitOnLoad();
     } else {
         uiInterface.InitMessage(_("Eternitynode cache is empty, skipping payments and governance cache..."));
@@ -1899,6 +1938,11 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
         return InitError("Failed to load fulfilled requests cache from netfulfilled.dat");
     }
 
+    int nCacheSaveInterval = GetArg("-cachesaveinterval", DEFAULT_CACHE_SAVE_INTERVAL);
+    if(nCacheSaveInterval > 0) {
+        scheduler.scheduleEvery(&SaveCacheSnapshots, nCacheSaveInterval * 60);
+    }
+
     // ********************************************************* Step 11c: update block tip in Eternity modules
 
     // force UpdatedBlockTip to initialize pCurrentBlockIndex for DS, MN payments and budgets
@@ -3,10 +3,12 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "activeeternitynode.h"
+#include "core_memusage.h"
 #include "spysend.h"
 #include "instantx.h"
 #include "key.h"
 #include "main.h"
+#include "memusage.h"
 #include "eternitynode-sync.h"
 #include "eternitynodeman.h"
 #include "net.h"
@@ -62,7 +64,7 @@ void CInstantSend::ProcessMessage(CNode* pfrom, std::string& strCommand, CDataSt
         uint256 nVoteHash = vote.GetHash();
 
         if(mapTxLockVotes.count(nVoteHash)) return;
-        mapTxLockVotes.insert(std::make_pair(nVoteHash, vote));
+        AddTxLockVote(vote);
 
         ProcessTxLockVote(pfrom, vote);
 
@@ -110,10 +112,10 @@ bool CInstantSend::ProcessTxLockRequest(const CTxLockRequest& txLockRequest)
     }
     LogPrintf("CInstantSend::ProcessTxLockRequest -- accepted, txid=%s\n", txHash.ToString());
 
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     CTxLockCandidate& txLockCandidate = itLockCandidate->second;
     Vote(txLockCandidate);
-    ProcessOrphanTxLockVotes();
+    ProcessOrphanTxLockVotes(txHash);
 
     // Eternitynodes will sometimes propagate votes before the transaction is known to the client.
     // If this just happened - lock inputs, resolve conflicting locks, update transaction status
@@ -132,7 +134,7 @@ bool CInstantSend::CreateTxLockCandidate(const CTxLockRequest& txLockRequest)
 
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     if(itLockCandidate == mapTxLockCandidates.end()) {
         LogPrintf("CInstantSend::CreateTxLockCandidate -- new, txid=%s\n", txHash.ToString());
 
@@ -193,7 +195,7 @@ void CInstantSend::Vote(CTxLockCandidate& txLockCandidate)
         bool fAlreadyVoted = false;
         if(itVoted != mapVotedOutpoints.end()) {
             BOOST_FOREACH(const uint256& hash, itVoted->second) {
-                std::map<uint256, CTxLockCandidate>::iterator it2 = mapTxLockCandidates.find(hash);
+                candidate_m_t::iterator it2 = mapTxLockCandidates.find(hash);
                 if(it2->second.HasEternitynodeVoted(itOutpointLock->first, activeEternitynode.vin.prevout)) {
                     // we already voted for this outpoint to be included either in the same tx or in a competing one,
                     // skip it anyway
@@ -223,7 +225,7 @@ void CInstantSend::Vote(CTxLockCandidate& txLockCandidate)
 
         // vote constructed sucessfully, let's store and relay it
         uint256 nVoteHash = vote.GetHash();
-        mapTxLockVotes.insert(std::make_pair(nVoteHash, vote));
+        AddTxLockVote(vote);
         if(itOutpointLock->second.AddVote(vote)) {
             LogPrintf("CInstantSend::Vote -- Vote created successfully, relaying: txHash=%s, outpoint=%s, vote=%s\n",
                     txHash.ToString(), itOutpointLock->first.ToStringShort(), nVoteHash.ToString());
@@ -264,14 +266,14 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
     // Eternitynodes will sometimes propagate votes before the transaction is known to the client,
     // will actually process only after the lock request itself has arrived
 
-    std::map<uint256, CTxLockCandidate>::iterator it = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator it = mapTxLockCandidates.find(txHash);
     if(it == mapTxLockCandidates.end()) {
         if(!mapTxLockVotesOrphan.count(vote.GetHash())) {
-            mapTxLockVotesOrphan[vote.GetHash()] = vote;
+            AddOrphanTxLockVote(vote);
             LogPrint("instantsend", "CInstantSend::ProcessTxLockVote -- Orphan vote: txid=%s  eternitynode=%s new\n",
                     txHash.ToString(), vote.GetEternitynodeOutpoint().ToStringShort());
             bool fReprocess = true;
-            std::map<uint256, CTxLockRequest>::iterator itLockRequest = mapLockRequestAccepted.find(txHash);
+            lock_request_m_t::iterator itLockRequest = mapLockRequestAccepted.find(txHash);
             if(itLockRequest == mapLockRequestAccepted.end()) {
                 itLockRequest = mapLockRequestRejected.find(txHash);
                 if(itLockRequest == mapLockRequestRejected.end()) {
@@ -295,10 +297,9 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
         // TODO: make sure this works good enough for multi-quorum
 
         int nEternitynodeOrphanExpireTime = GetTime() + 60*10; // keep time data for 10 minutes
-        if(!mapEternitynodeOrphanVotes.count(vote.GetEternitynodeOutpoint())) {
-            mapEternitynodeOrphanVotes[vote.GetEternitynodeOutpoint()] = nEternitynodeOrphanExpireTime;
-        } else {
-            int64_t nPrevOrphanVote = mapEternitynodeOrphanVotes[vote.GetEternitynodeOutpoint()];
+        boost::unordered_map<COutPoint, int64_t, COutPointHasher>::iterator itMnOrphan = mapEternitynodeOrphanVotes.find(vote.GetEternitynodeOutpoint());
+        if(itMnOrphan != mapEternitynodeOrphanVotes.end()) {
+            int64_t nPrevOrphanVote = itMnOrphan->second;
             if(nPrevOrphanVote > GetTime() && nPrevOrphanVote > GetAverageEternitynodeOrphanVoteTime()) {
                 LogPrint("instantsend", "CInstantSend::ProcessTxLockVote -- eternitynode is spamming orphan Transaction Lock Votes: txid=%s  eternitynode=%s\n",
                         txHash.ToString(), vote.GetEternitynodeOutpoint().ToStringShort());
@@ -306,13 +307,28 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
                 return false;
             }
             // not spamming, refresh
-            mapEternitynodeOrphanVotes[vote.GetEternitynodeOutpoint()] = nEternitynodeOrphanExpireTime;
         }
+        SetEternitynodeOrphanVoteTime(vote.GetEternitynodeOutpoint(), nEternitynodeOrphanExpireTime);
 
         return true;
     }
 
-    LogPrint("instantsend", "CInstantSend::ProcessTxLockVote -- Transaction Lock Vote, txid=%s\n", txHash.ToString());
+    return ProcessValidTxLockVote(vote);
+}
+
+bool CInstantSend::ProcessValidTxLockVote(const CTxLockVote& vote)
+{
+    LOCK2(cs_main, cs_instantsend);
+
+    uint256 txHash = vote.GetTxHash();
+
+    candidate_m_t::iterator it = mapTxLockCandidates.find(txHash);
+    if(it == mapTxLockCandidates.end()) {
+        // should never happen, callers make sure there is a candidate
+        return false;
+    }
+
+    LogPrint("instantsend", "CInstantSend::ProcessValidTxLockVote -- Transaction Lock Vote, txid=%s\n", txHash.ToString());
 
     std::map<COutPoint, std::set<uint256> >::iterator it1 = mapVotedOutpoints.find(vote.GetOutpoint());
     if(it1 != mapVotedOutpoints.end()) {
@@ -320,7 +336,7 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
             if(hash != txHash) {
                 // same outpoint was already voted to be locked by another tx lock request,
                 // find out if the same mn voted on this outpoint before
-                std::map<uint256, CTxLockCandidate>::iterator it2 = mapTxLockCandidates.find(hash);
+                candidate_m_t::iterator it2 = mapTxLockCandidates.find(hash);
                 if(it2->second.HasEternitynodeVoted(vote.GetOutpoint(), vote.GetEternitynodeOutpoint())) {
                     // yes, it did, refuse to accept a vote to include the same outpoint in another tx
                     // from the same eternitynode.
@@ -328,7 +344,7 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
                     // NOTE: if we decide to apply pose ban score here, this vote must be relayed further
                     // to let all other nodes know about this node's misbehaviour and let them apply
                     // pose ban score too.
-                    LogPrintf("CInstantSend::ProcessTxLockVote -- eternitynode sent conflicting votes! %s\n", vote.GetEternitynodeOutpoint().ToStringShort());
+                    LogPrintf("CInstantSend::ProcessValidTxLockVote -- eternitynode sent conflicting votes! %s\n", vote.GetEternitynodeOutpoint().ToStringShort());
                     return false;
                 }
             }
@@ -350,7 +366,7 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
 
     int nSignatures = txLockCandidate.CountVotes();
     int nSignaturesMax = txLockCandidate.txLockRequest.GetMaxSignatures();
-    LogPrint("instantsend", "CInstantSend::ProcessTxLockVote -- Transaction Lock signatures count: %d/%d, vote hash=%s\n",
+    LogPrint("instantsend", "CInstantSend::ProcessValidTxLockVote -- Transaction Lock signatures count: %d/%d, vote hash=%s\n",
             nSignatures, nSignaturesMax, vote.GetHash().ToString());
 
     TryToFinalizeLockCandidate(txLockCandidate);
@@ -360,17 +376,60 @@ bool CInstantSend::ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote)
     return true;
 }
 
-void CInstantSend::ProcessOrphanTxLockVotes()
+void CInstantSend::ProcessOrphanTxLockVotes(const uint256& txHash)
 {
     LOCK2(cs_main, cs_instantsend);
-    std::map<uint256, CTxLockVote>::iterator it = mapTxLockVotesOrphan.begin();
-    while(it != mapTxLockVotesOrphan.end()) {
-        if(ProcessTxLockVote(NULL, it->second)) {
-            mapTxLockVotesOrphan.erase(it++);
-        } else {
-            ++it;
+
+    orphan_votes_m_t::iterator itTx = mapTxLockVotesOrphanByTx.find(txHash);
+    if(itTx == mapTxLockVotesOrphanByTx.end()) return;
+
+    // Orphan votes were fully validated when they arrived (see ProcessTxLockVote),
+    // only votes for this tx can be promoted and there is no need to check them again.
+    std::vector<CTxLockVote> vecVotes;
+    std::map<COutPoint, std::set<uint256> >::iterator itOutpoint = itTx->second.begin();
+    while(itOutpoint != itTx->second.end()) {
+        BOOST_FOREACH(const uint256& hash, itOutpoint->second) {
+            vote_m_t::iterator itVote = mapTxLockVotesOrphan.find(hash);
+            if(itVote == mapTxLockVotesOrphan.end()) continue;
+            vecVotes.push_back(itVote->second);
+            mapTxLockVotesOrphan.erase(itVote);
+        }
+        ++itOutpoint;
+    }
+    mapTxLockVotesOrphanByTx.erase(itTx);
+
+    BOOST_FOREACH(const CTxLockVote& vote, vecVotes) {
+        ProcessValidTxLockVote(vote);
+    }
+}
+
+void CInstantSend::AddOrphanTxLockVote(const CTxLockVote& vote)
+{
+    AssertLockHeld(cs_instantsend);
+
+    uint256 nVoteHash = vote.GetHash();
+    mapTxLockVotesOrphan[nVoteHash] = vote;
+    mapTxLockVotesOrphanByTx[vote.GetTxHash()][vote.GetOutpoint()].insert(nVoteHash);
+    mapTxLockVotesOrphanByTime.insert(std::make_pair(vote.GetTimeCreated(), nVoteHash));
+}
+
+void CInstantSend::RemoveOrphanTxLockVote(const CTxLockVote& vote)
+{
+    AssertLockHeld(cs_instantsend);
+
+    orphan_votes_m_t::iterator itTx = mapTxLockVotesOrphanByTx.find(vote.GetTxHash());
+    if(itTx == mapTxLockVotesOrphanByTx.end()) return;
+
+    std::map<COutPoint, std::set<uint256> >::iterator itOutpoint = itTx->second.find(vote.GetOutpoint());
+    if(itOutpoint != itTx->second.end()) {
+        itOutpoint->second.erase(vote.GetHash());
+        if(itOutpoint->second.empty()) {
+            itTx->second.erase(itOutpoint);
         }
     }
+    if(itTx->second.empty()) {
+        mapTxLockVotesOrphanByTx.erase(itTx);
+    }
 }
 
 bool CInstantSend::IsEnoughOrphanVotesForTx(const CTxLockRequest& txLockRequest)
@@ -388,20 +447,13 @@ bool CInstantSend::IsEnoughOrphanVotesForTx(const CTxLockRequest& txLockRequest)
 
 bool CInstantSend::IsEnoughOrphanVotesForTxAndOutPoint(const uint256& txHash, const COutPoint& outpoint)
 {
-    // Scan orphan votes to check if this outpoint has enough orphan votes to be locked in some tx.
+    // Check if this outpoint has enough orphan votes to be locked in some tx.
     LOCK2(cs_main, cs_instantsend);
-    int nCountVotes = 0;
-    std::map<uint256, CTxLockVote>::iterator it = mapTxLockVotesOrphan.begin();
-    while(it != mapTxLockVotesOrphan.end()) {
-        if(it->second.GetTxHash() == txHash && it->second.GetOutpoint() == outpoint) {
-            nCountVotes++;
-            if(nCountVotes >= COutPointLock::SIGNATURES_REQUIRED) {
-                return true;
-            }
-        }
-        ++it;
-    }
-    return false;
+    orphan_votes_m_t::iterator itTx = mapTxLockVotesOrphanByTx.find(txHash);
+    if(itTx == mapTxLockVotesOrphanByTx.end()) return false;
+    std::map<COutPoint, std::set<uint256> >::iterator itOutpoint = itTx->second.find(outpoint);
+    if(itOutpoint == itTx->second.end()) return false;
+    return (int)itOutpoint->second.size() >= COutPointLock::SIGNATURES_REQUIRED;
 }
 
 void CInstantSend::TryToFinalizeLockCandidate(const CTxLockCandidate& txLockCandidate)
@@ -560,86 +612,162 @@ bool CInstantSend::ResolveConflicts(const CTxLockCandidate& txLockCandidate, int
     return true;
 }
 
+void CInstantSend::SetEternitynodeOrphanVoteTime(const COutPoint& outpointEternitynode, int64_t nTime)
+{
+    AssertLockHeld(cs_instantsend);
+
+    std::pair<boost::unordered_map<COutPoint, int64_t, COutPointHasher>::iterator, bool> ret =
+            mapEternitynodeOrphanVotes.insert(std::make_pair(outpointEternitynode, nTime));
+    if(!ret.second) {
+        nEternitynodeOrphanVoteTimeTotal -= ret.first->second;
+        ret.first->second = nTime;
+    }
+    nEternitynodeOrphanVoteTimeTotal += nTime;
+    mapEternitynodeOrphanVotesByTime.insert(std::make_pair(nTime, outpointEternitynode));
+}
+
 int64_t CInstantSend::GetAverageEternitynodeOrphanVoteTime()
 {
     LOCK(cs_instantsend);
     // NOTE: should never actually call this function when mapEternitynodeOrphanVotes is empty
     if(mapEternitynodeOrphanVotes.empty()) return 0;
 
-    std::map<COutPoint, int64_t>::iterator it = mapEternitynodeOrphanVotes.begin();
-    int64_t total = 0;
+    return nEternitynodeOrphanVoteTimeTotal / mapEternitynodeOrphanVotes.size();
+}
 
-    while(it != mapEternitynodeOrphanVotes.end()) {
-        total+= it->second;
-        ++it;
-    }
+void CInstantSend::AddTxLockVote(const CTxLockVote& vote)
+{
+    AssertLockHeld(cs_instantsend);
 
-    return total / mapEternitynodeOrphanVotes.size();
+    uint256 nVoteHash = vote.GetHash();
+    mapTxLockVotes.insert(std::make_pair(nVoteHash, vote));
+    mapTxLockVotesByTx[vote.GetTxHash()].insert(nVoteHash);
 }
 
-void CInstantSend::CheckAndRemove()
+void CInstantSend::RemoveTxLockVote(const uint256& nVoteHash)
 {
-    if(!pCurrentBlockIndex) return;
+    AssertLockHeld(cs_instantsend);
 
-    LOCK(cs_instantsend);
+    vote_m_t::iterator itVote = mapTxLockVotes.find(nVoteHash);
+    if(itVote == mapTxLockVotes.end()) return;
 
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.begin();
+    tx_votes_m_t::iterator itTx = mapTxLockVotesByTx.find(itVote->second.GetTxHash());
+    if(itTx != mapTxLockVotesByTx.end()) {
+        itTx->second.erase(nVoteHash);
+        if(itTx->second.empty()) {
+            mapTxLockVotesByTx.erase(itTx);
+        }
+    }
+    mapTxLockVotes.erase(itVote);
+}
 
-    // remove expired candidates
-    while(itLockCandidate != mapTxLockCandidates.end()) {
-        CTxLockCandidate &txLockCandidate = itLockCandidate->second;
-        uint256 txHash = txLockCandidate.GetHash();
-        if(txLockCandidate.IsExpired(pCurrentBlockIndex->nHeight)) {
-            LogPrintf("CInstantSend::CheckAndRemove -- Removing expired Transaction Lock Candidate: txid=%s\n", txHash.ToString());
-            std::map<COutPoint, COutPointLock>::iterator itOutpointLock = txLockCandidate.mapOutPointLocks.begin();
-            while(itOutpointLock != txLockCandidate.mapOutPointLocks.end()) {
-                mapLockedOutpoints.erase(itOutpointLock->first);
-                mapVotedOutpoints.erase(itOutpointLock->first);
-                ++itOutpointLock;
+void CInstantSend::SetLockTxConfirmedHeight(const uint256& txHash, int nHeight)
+{
+    AssertLockHeld(cs_instantsend);
+
+    boost::unordered_map<uint256, int, CCoinsKeyHasher>::iterator it = mapLockTxConfirmedHeight.find(txHash);
+    if(it != mapLockTxConfirmedHeight.end()) {
+        std::map<int, std::set<uint256> >::iterator itHeight = mapLockTxHashesByHeight.find(it->second);
+        if(itHeight != mapLockTxHashesByHeight.end()) {
+            itHeight->second.erase(txHash);
+            if(itHeight->second.empty()) {
+                mapLockTxHashesByHeight.erase(itHeight);
             }
-            mapLockRequestAccepted.erase(txHash);
-            mapLockRequestRejected.erase(txHash);
-            mapTxLockCandidates.erase(itLockCandidate++);
-        } else {
-            ++itLockCandidate;
         }
+        mapLockTxConfirmedHeight.erase(it);
     }
 
-    // remove expired votes
-    std::map<uint256, CTxLockVote>::iterator itVote = mapTxLockVotes.begin();
-    while(itVote != mapTxLockVotes.end()) {
-        if(itVote->second.IsExpired(pCurrentBlockIndex->nHeight)) {
-            LogPrint("instantsend", "CInstantSend::CheckAndRemove -- Removing expired vote: txid=%s  eternitynode=%s\n",
-                    itVote->second.GetTxHash().ToString(), itVote->second.GetEternitynodeOutpoint().ToStringShort());
-            mapTxLockVotes.erase(itVote++);
-        } else {
-            ++itVote;
+    // 0-confirmed or conflicted txes never expire
+    if(nHeight == -1) return;
+
+    mapLockTxConfirmedHeight.insert(std::make_pair(txHash, nHeight));
+    mapLockTxHashesByHeight[nHeight].insert(txHash);
+}
+
+void CInstantSend::RemoveExpiredLockTx(const uint256& txHash)
+{
+    AssertLockHeld(cs_instantsend);
+
+    mapLockTxConfirmedHeight.erase(txHash);
+
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    if(itLockCandidate != mapTxLockCandidates.end()) {
+        CTxLockCandidate &txLockCandidate = itLockCandidate->second;
+        LogPrintf("CInstantSend::RemoveExpiredLockTx -- Removing expired Transaction Lock Candidate: txid=%s\n", txHash.ToString());
+        std::map<COutPoint, COutPointLock>::iterator itOutpointLock = txLockCandidate.mapOutPointLocks.begin();
+        while(itOutpointLock != txLockCandidate.mapOutPointLocks.end()) {
+            mapLockedOutpoints.erase(itOutpointLock->first);
+            mapVotedOutpoints.erase(itOutpointLock->first);
+            ++itOutpointLock;
         }
+        mapLockRequestAccepted.erase(txHash);
+        mapLockRequestRejected.erase(txHash);
+        mapTxLockCandidates.erase(itLockCandidate);
     }
 
+    tx_votes_m_t::iterator itTx = mapTxLockVotesByTx.find(txHash);
+    if(itTx == mapTxLockVotesByTx.end()) return;
+
+    BOOST_FOREACH(const uint256& nVoteHash, itTx->second) {
+        vote_m_t::iterator itVote = mapTxLockVotes.find(nVoteHash);
+        if(itVote == mapTxLockVotes.end()) continue;
+        LogPrint("instantsend", "CInstantSend::RemoveExpiredLockTx -- Removing expired vote: txid=%s  eternitynode=%s\n",
+                txHash.ToString(), itVote->second.GetEternitynodeOutpoint().ToStringShort());
+        vote_m_t::iterator itOrphanVote = mapTxLockVotesOrphan.find(nVoteHash);
+        if(itOrphanVote != mapTxLockVotesOrphan.end()) {
+            RemoveOrphanTxLockVote(itOrphanVote->second);
+            mapTxLockVotesOrphan.erase(itOrphanVote);
+        }
+        mapTxLockVotes.erase(itVote);
+    }
+    mapTxLockVotesByTx.erase(itTx);
+}
+
+void CInstantSend::CheckAndRemove()
+{
+    if(!pCurrentBlockIndex) return;
+
+    LOCK(cs_instantsend);
+
+    // remove expired candidates and votes, only the oldest buckets need to be looked at
+    int nKeepLock = Params().GetConsensus().nInstantSendKeepLock;
+    std::map<int, std::set<uint256> >::iterator itHeight = mapLockTxHashesByHeight.begin();
+    while(itHeight != mapLockTxHashesByHeight.end() && pCurrentBlockIndex->nHeight - itHeight->first > nKeepLock) {
+        BOOST_FOREACH(const uint256& txHash, itHeight->second) {
+            RemoveExpiredLockTx(txHash);
+        }
+        mapLockTxHashesByHeight.erase(itHeight++);
+    }
+
+    int64_t nNow = GetTime();
+
     // remove expired orphan votes
-    std::map<uint256, CTxLockVote>::iterator itOrphanVote = mapTxLockVotesOrphan.begin();
-    while(itOrphanVote != mapTxLockVotesOrphan.end()) {
-        if(GetTime() - itOrphanVote->second.GetTimeCreated() > ORPHAN_VOTE_SECONDS) {
+    std::multimap<int64_t, uint256>::iterator itOrphanTime = mapTxLockVotesOrphanByTime.begin();
+    while(itOrphanTime != mapTxLockVotesOrphanByTime.end() && nNow - itOrphanTime->first > ORPHAN_VOTE_SECONDS) {
+        vote_m_t::iterator itOrphanVote = mapTxLockVotesOrphan.find(itOrphanTime->second);
+        // skip votes which were promoted or expired together with their tx already
+        if(itOrphanVote != mapTxLockVotesOrphan.end() && itOrphanVote->second.GetTimeCreated() == itOrphanTime->first) {
             LogPrint("instantsend", "CInstantSend::CheckAndRemove -- Removing expired orphan vote: txid=%s  eternitynode=%s\n",
                     itOrphanVote->second.GetTxHash().ToString(), itOrphanVote->second.GetEternitynodeOutpoint().ToStringShort());
-            mapTxLockVotes.erase(itOrphanVote->first);
-            mapTxLockVotesOrphan.erase(itOrphanVote++);
-        } else {
-            ++itOrphanVote;
+            RemoveTxLockVote(itOrphanVote->first);
+            RemoveOrphanTxLockVote(itOrphanVote->second);
+            mapTxLockVotesOrphan.erase(itOrphanVote);
         }
+        mapTxLockVotesOrphanByTime.erase(itOrphanTime++);
     }
 
     // remove expired eternitynode orphan votes (DOS protection)
-    std::map<COutPoint, int64_t>::iterator itEternitynodeOrphan = mapEternitynodeOrphanVotes.begin();
-    while(itEternitynodeOrphan != mapEternitynodeOrphanVotes.end()) {
-        if(itEternitynodeOrphan->second < GetTime()) {
+    std::multimap<int64_t, COutPoint>::iterator itEternitynodeOrphan = mapEternitynodeOrphanVotesByTime.begin();
+    while(itEternitynodeOrphan != mapEternitynodeOrphanVotesByTime.end() && itEternitynodeOrphan->first < nNow) {
+        boost::unordered_map<COutPoint, int64_t, COutPointHasher>::iterator it = mapEternitynodeOrphanVotes.find(itEternitynodeOrphan->second);
+        // entries which were refreshed since have a newer time
+        if(it != mapEternitynodeOrphanVotes.end() && it->second == itEternitynodeOrphan->first) {
             LogPrint("instantsend", "CInstantSend::CheckAndRemove -- Removing expired orphan eternitynode vote: eternitynode=%s\n",
-                    itEternitynodeOrphan->first.ToStringShort());
-            mapEternitynodeOrphanVotes.erase(itEternitynodeOrphan++);
-        } else {
-            ++itEternitynodeOrphan;
+                    it->first.ToStringShort());
+            nEternitynodeOrphanVoteTimeTotal -= it->second;
+            mapEternitynodeOrphanVotes.erase(it);
         }
+        mapEternitynodeOrphanVotesByTime.erase(itEternitynodeOrphan++);
     }
 }
 
@@ -673,7 +801,7 @@ bool CInstantSend::GetTxLockRequest(const uint256& txHash, CTxLockRequest& txLoc
 {
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockCandidate>::iterator it = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator it = mapTxLockCandidates.find(txHash);
     if(it == mapTxLockCandidates.end()) return false;
     txLockRequestRet = it->second.txLockRequest;
 
@@ -684,7 +812,7 @@ bool CInstantSend::GetTxLockVote(const uint256& hash, CTxLockVote& txLockVoteRet
 {
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockVote>::iterator it = mapTxLockVotes.find(hash);
+    vote_m_t::iterator it = mapTxLockVotes.find(hash);
     if(it == mapTxLockVotes.end()) return false;
     txLockVoteRet = it->second;
 
@@ -699,7 +827,7 @@ bool CInstantSend::IsInstantSendReadyToLock(const uint256& txHash)
     LOCK(cs_instantsend);
     // There must be a successfully verified lock request
     // and all outputs must be locked (i.e. have enough signatures)
-    std::map<uint256, CTxLockCandidate>::iterator it = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator it = mapTxLockCandidates.find(txHash);
     return it != mapTxLockCandidates.end() && it->second.IsAllOutPointsReady();
 }
 
@@ -711,7 +839,7 @@ bool CInstantSend::IsLockedInstantSendTransaction(const uint256& txHash)
     LOCK(cs_instantsend);
 
     // there must be a lock candidate
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     if(itLockCandidate == mapTxLockCandidates.end()) return false;
 
     // which should have outpoints
@@ -736,7 +864,7 @@ int CInstantSend::GetTransactionLockSignatures(const uint256& txHash)
 
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     if(itLockCandidate != mapTxLockCandidates.end()) {
         return itLockCandidate->second.CountVotes();
     }
@@ -750,7 +878,7 @@ bool CInstantSend::IsTxLockRequestTimedOut(const uint256& txHash)
 
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     if (itLockCandidate != mapTxLockCandidates.end()) {
         return !itLockCandidate->second.IsAllOutPointsReady() &&
                 itLockCandidate->second.txLockRequest.IsTimedOut();
@@ -763,7 +891,7 @@ void CInstantSend::Relay(const uint256& txHash)
 {
     LOCK(cs_instantsend);
 
-    std::map<uint256, CTxLockCandidate>::const_iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::const_iterator itLockCandidate = mapTxLockCandidates.find(txHash);
     if (itLockCandidate != mapTxLockCandidates.end()) {
         itLockCandidate->second.Relay();
     }
@@ -792,44 +920,92 @@ void CInstantSend::SyncTransaction(const CTransaction& tx, const CBlock* pblock)
     LogPrint("instantsend", "CInstantSend::SyncTransaction -- txid=%s nHeightNew=%d\n", txHash.ToString(), nHeightNew);
 
     // Check lock candidates
-    std::map<uint256, CTxLockCandidate>::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    candidate_m_t::iterator itLockCandidate = mapTxLockCandidates.find(txHash);
+    tx_votes_m_t::iterator itTxVotes = mapTxLockVotesByTx.find(txHash);
+    if(itLockCandidate == mapTxLockCandidates.end() && itTxVotes == mapTxLockVotesByTx.end()) return;
+
+    SetLockTxConfirmedHeight(txHash, nHeightNew);
+
     if(itLockCandidate != mapTxLockCandidates.end()) {
         LogPrint("instantsend", "CInstantSend::SyncTransaction -- txid=%s nHeightNew=%d lock candidate updated\n",
                 txHash.ToString(), nHeightNew);
         itLockCandidate->second.SetConfirmedHeight(nHeightNew);
-        // Loop through outpoint locks
-        std::map<COutPoint, COutPointLock>::iterator itOutpointLock = itLockCandidate->second.mapOutPointLocks.begin();
-        while(itOutpointLock != itLockCandidate->second.mapOutPointLocks.end()) {
-            // Check corresponding lock votes
-            std::vector<CTxLockVote> vVotes = itOutpointLock->second.GetVotes();
-            std::vector<CTxLockVote>::iterator itVote = vVotes.begin();
-            std::map<uint256, CTxLockVote>::iterator it;
-            while(itVote != vVotes.end()) {
-                uint256 nVoteHash = itVote->GetHash();
-                LogPrint("instantsend", "CInstantSend::SyncTransaction -- txid=%s nHeightNew=%d vote %s updated\n",
-                        txHash.ToString(), nHeightNew, nVoteHash.ToString());
-                it = mapTxLockVotes.find(nVoteHash);
-                if(it != mapTxLockVotes.end()) {
-                    it->second.SetConfirmedHeight(nHeightNew);
-                }
-                ++itVote;
-            }
-            ++itOutpointLock;
-        }
     }
 
-    // check orphan votes
-    std::map<uint256, CTxLockVote>::iterator itOrphanVote = mapTxLockVotesOrphan.begin();
-    while(itOrphanVote != mapTxLockVotesOrphan.end()) {
-        if(itOrphanVote->second.GetTxHash() == txHash) {
+    // Check lock votes, including the orphan ones
+    if(itTxVotes != mapTxLockVotesByTx.end()) {
+        BOOST_FOREACH(const uint256& nVoteHash, itTxVotes->second) {
             LogPrint("instantsend", "CInstantSend::SyncTransaction -- txid=%s nHeightNew=%d vote %s updated\n",
-                    txHash.ToString(), nHeightNew, itOrphanVote->first.ToString());
-            mapTxLockVotes[itOrphanVote->first].SetConfirmedHeight(nHeightNew);
+                    txHash.ToString(), nHeightNew, nVoteHash.ToString());
+            vote_m_t::iterator it = mapTxLockVotes.find(nVoteHash);
+            if(it != mapTxLockVotes.end()) {
+                it->second.SetConfirmedHeight(nHeightNew);
+            }
         }
-        ++itOrphanVote;
     }
 }
 
+int CInstantSend::GetLockCandidateCount()
+{
+    LOCK(cs_instantsend);
+    return mapTxLockCandidates.size();
+}
+
+int CInstantSend::GetVoteCount()
+{
+    LOCK(cs_instantsend);
+    return mapTxLockVotes.size();
+}
+
+int CInstantSend::GetOrphanVoteCount()
+{
+    LOCK(cs_instantsend);
+    return mapTxLockVotesOrphan.size();
+}
+
+size_t CInstantSend::GetMemoryUsage()
+{
+    LOCK(cs_instantsend);
+
+    size_t nUsage = memusage::DynamicUsage(mapLockRequestAccepted) +
+                    memusage::DynamicUsage(mapLockRequestRejected) +
+                    memusage::DynamicUsage(mapTxLockVotes) +
+                    memusage::DynamicUsage(mapTxLockVotesOrphan) +
+                    memusage::DynamicUsage(mapTxLockVotesOrphanByTx) +
+                    memusage::DynamicUsage(mapTxLockCandidates) +
+                    memusage::DynamicUsage(mapVotedOutpoints) +
+                    memusage::DynamicUsage(mapLockedOutpoints) +
+                    memusage::DynamicUsage(mapTxLockVotesByTx) +
+                    memusage::DynamicUsage(mapLockTxConfirmedHeight) +
+                    memusage::DynamicUsage(mapLockTxHashesByHeight) +
+                    memusage::DynamicUsage(mapTxLockVotesOrphanByTime) +
+                    memusage::DynamicUsage(mapEternitynodeOrphanVotes) +
+                    memusage::DynamicUsage(mapEternitynodeOrphanVotesByTime);
+
+    for(lock_request_m_t::iterator it = mapLockRequestAccepted.begin(); it != mapLockRequestAccepted.end(); ++it) {
+        nUsage += RecursiveDynamicUsage(it->second);
+    }
+    for(lock_request_m_t::iterator it = mapLockRequestRejected.begin(); it != mapLockRequestRejected.end(); ++it) {
+        nUsage += RecursiveDynamicUsage(it->second);
+    }
+    for(candidate_m_t::iterator it = mapTxLockCandidates.begin(); it != mapTxLockCandidates.end(); ++it) {
+        // every outpoint lock keeps a copy of its votes
+        nUsage += RecursiveDynamicUsage(it->second.txLockRequest) + memusage::DynamicUsage(it->second.mapOutPointLocks) +
+                  it->second.CountVotes() * memusage::MallocUsage(sizeof(CTxLockVote) + 3 * sizeof(void*));
+    }
+    for(vote_m_t::iterator it = mapTxLockVotes.begin(); it != mapTxLockVotes.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second.GetSignature());
+    }
+    for(tx_votes_m_t::iterator it = mapTxLockVotesByTx.begin(); it != mapTxLockVotesByTx.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second);
+    }
+    for(std::map<int, std::set<uint256> >::iterator it = mapLockTxHashesByHeight.begin(); it != mapLockTxHashesByHeight.end(); ++it) {
+        nUsage += memusage::DynamicUsage(it->second);
+    }
+
+    return nUsage;
+}
+
 //
 // CTxLockRequest
 //
@@ -958,20 +1134,24 @@ bool CTxLockVote::IsValid(CNode* pnode) const
         LogPrint("instantsend", "CTxLockVote::IsValid -- Failed to find UTXO %s\n", outpoint.ToStringShort());
         // Validating utxo set is not enough, votes can arrive after outpoint was already spent,
         // if lock request was mined. We should process them too to count them later if they are legit.
-        CTransaction txOutpointCreated;
-        uint256 nHashOutpointConfirmed;
-        if(!GetTransaction(outpoint.hash, txOutpointCreated, Params().GetConsensus(), nHashOutpointConfirmed, true) || nHashOutpointConfirmed == uint256()) {
-            LogPrint("instantsend", "CTxLockVote::IsValid -- Failed to find outpoint %s\n", outpoint.ToStringShort());
-            return false;
-        }
-        LOCK(cs_main);
-        BlockMap::iterator mi = mapBlockIndex.find(nHashOutpointConfirmed);
-        if(mi == mapBlockIndex.end() || !mi->second) {
-            // not on this chain?
-            LogPrint("instantsend", "CTxLockVote::IsValid -- Failed to find block %s for outpoint %s\n", nHashOutpointConfirmed.ToString(), outpoint.ToStringShort());
-            return false;
+        nPrevoutHeight = GetSpentOutputHeight(outpoint);
+        if(nPrevoutHeight == -1) {
+            // not spent recently or spent before a restart, slow path via txindex/disk
+            CTransaction txOutpointCreated;
+            uint256 nHashOutpointConfirmed;
+            if(!GetTransaction(outpoint.hash, txOutpointCreated, Params().GetConsensus(), nHashOutpointConfirmed, true) || nHashOutpointConfirmed == uint256()) {
+                LogPrint("instantsend", "CTxLockVote::IsValid -- Failed to find outpoint %s\n", outpoint.ToStringShort());
+                return false;
+            }
+            LOCK(cs_main);
+            BlockMap::iterator mi = mapBlockIndex.find(nHashOutpointConfirmed);
+            if(mi == mapBlockIndex.end() || !mi->second) {
+                // not on this chain?
+                LogPrint("instantsend", "CTxLockVote::IsValid -- Failed to find block %s for outpoint %s\n", nHashOutpointConfirmed.ToString(), outpoint.ToStringShort());
+                return false;
+            }
+            nPrevoutHeight = mi->second->nHeight;
         }
-        nPrevoutHeight = mi->second->nHeight;
     }
 
     int nLockInputHeight = nPrevoutHeight + 4;
@@ -1009,10 +1189,15 @@ uint256 CTxLockVote::GetHash() const
     return ss.GetHash();
 }
 
+std::string CTxLockVote::GetSignatureMessage() const
+{
+    return txHash.ToString() + outpoint.ToStringShort();
+}
+
 bool CTxLockVote::CheckSignature() const
 {
     std::string strError;
-    std::string strMessage = txHash.ToString() + outpoint.ToStringShort();
+    std::string strMessage = GetSignatureMessage();
 
     eternitynode_info_t infoMn = mnodeman.GetEternitynodeInfo(CTxIn(outpointEternitynode));
 
@@ -1032,7 +1217,7 @@ bool CTxLockVote::CheckSignature() const
 bool CTxLockVote::Sign()
 {
     std::string strError;
-    std::string strMessage = txHash.ToString() + outpoint.ToStringShort();
+    std::string strMessage = GetSignatureMessage();
 
     if(!spySendSigner.SignMessage(strMessage, vchEternitynodeSignature, activeEternitynode.keyEternitynode)) {
         LogPrintf("CTxLockVote::Sign -- SignMessage() failed\n");
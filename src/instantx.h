@@ -4,9 +4,12 @@
 #ifndef INSTANTX_H
 #define INSTANTX_H
 
+#include "coins.h"
 #include "net.h"
 #include "primitives/transaction.h"
 
+#include <boost/unordered_map.hpp>
+
 class CTxLockVote;
 class COutPointLock;
 class CTxLockRequest;
@@ -36,35 +39,62 @@ extern int nCompleteTXLocks;
 class CInstantSend
 {
 private:
+    typedef boost::unordered_map<uint256, CTxLockRequest, CCoinsKeyHasher> lock_request_m_t;
+    typedef boost::unordered_map<uint256, CTxLockVote, CCoinsKeyHasher> vote_m_t;
+    typedef boost::unordered_map<uint256, CTxLockCandidate, CCoinsKeyHasher> candidate_m_t;
+    typedef boost::unordered_map<uint256, std::set<uint256>, CCoinsKeyHasher> tx_votes_m_t;
+    typedef boost::unordered_map<uint256, std::map<COutPoint, std::set<uint256> >, CCoinsKeyHasher> orphan_votes_m_t;
+
     static const int ORPHAN_VOTE_SECONDS            = 60;
 
     // Keep track of current block index
     const CBlockIndex *pCurrentBlockIndex;
 
     // maps for AlreadyHave
-    std::map<uint256, CTxLockRequest> mapLockRequestAccepted; // tx hash - tx
-    std::map<uint256, CTxLockRequest> mapLockRequestRejected; // tx hash - tx
-    std::map<uint256, CTxLockVote> mapTxLockVotes; // vote hash - vote
-    std::map<uint256, CTxLockVote> mapTxLockVotesOrphan; // vote hash - vote
+    lock_request_m_t mapLockRequestAccepted; // tx hash - tx
+    lock_request_m_t mapLockRequestRejected; // tx hash - tx
+    vote_m_t mapTxLockVotes; // vote hash - vote
+    vote_m_t mapTxLockVotesOrphan; // vote hash - vote
+    orphan_votes_m_t mapTxLockVotesOrphanByTx; // tx hash - utxo - orphan vote hashes
 
-    std::map<uint256, CTxLockCandidate> mapTxLockCandidates; // tx hash - lock candidate
+    candidate_m_t mapTxLockCandidates; // tx hash - lock candidate
 
     std::map<COutPoint, std::set<uint256> > mapVotedOutpoints; // utxo - tx hash set
     std::map<COutPoint, uint256> mapLockedOutpoints; // utxo - tx hash
 
+    // expiry: candidates and votes go away nInstantSendKeepLock blocks after their tx was included into a block
+    tx_votes_m_t mapTxLockVotesByTx; // tx hash - hashes of all votes in mapTxLockVotes for it
+    boost::unordered_map<uint256, int, CCoinsKeyHasher> mapLockTxConfirmedHeight; // tx hash - height
+    std::map<int, std::set<uint256> > mapLockTxHashesByHeight; // height - tx hashes
+    std::multimap<int64_t, uint256> mapTxLockVotesOrphanByTime; // creation time - orphan vote hash
+
     //track eternitynodes who voted with no txreq (for DOS protection)
-    std::map<COutPoint, int64_t> mapEternitynodeOrphanVotes; // mn outpoint - time
+    boost::unordered_map<COutPoint, int64_t, COutPointHasher> mapEternitynodeOrphanVotes; // mn outpoint - time
+    std::multimap<int64_t, COutPoint> mapEternitynodeOrphanVotesByTime; // time - mn outpoint, can have outdated entries
+    int64_t nEternitynodeOrphanVoteTimeTotal; // sum of all times in mapEternitynodeOrphanVotes
 
     bool CreateTxLockCandidate(const CTxLockRequest& txLockRequest);
     void Vote(CTxLockCandidate& txLockCandidate);
 
     //process consensus vote message
     bool ProcessTxLockVote(CNode* pfrom, CTxLockVote& vote);
-    void ProcessOrphanTxLockVotes();
+    // add a vote which already passed CTxLockVote::IsValid() to its lock candidate
+    bool ProcessValidTxLockVote(const CTxLockVote& vote);
+    void ProcessOrphanTxLockVotes(const uint256& txHash);
+    void AddOrphanTxLockVote(const CTxLockVote& vote);
+    void RemoveOrphanTxLockVote(const CTxLockVote& vote);
     bool IsEnoughOrphanVotesForTx(const CTxLockRequest& txLockRequest);
     bool IsEnoughOrphanVotesForTxAndOutPoint(const uint256& txHash, const COutPoint& outpoint);
+    void SetEternitynodeOrphanVoteTime(const COutPoint& outpointEternitynode, int64_t nTime);
     int64_t GetAverageEternitynodeOrphanVoteTime();
 
+    void AddTxLockVote(const CTxLockVote& vote);
+    void RemoveTxLockVote(const uint256& nVoteHash);
+    // move a tx to the expiry bucket of the block it was included into, -1 if it's not in a block
+    void SetLockTxConfirmedHeight(const uint256& txHash, int nHeight);
+    // remove the lock candidate and all votes of an expired tx
+    void RemoveExpiredLockTx(const uint256& txHash);
+
     void TryToFinalizeLockCandidate(const CTxLockCandidate& txLockCandidate);
     void LockTransactionInputs(const CTxLockCandidate& txLockCandidate);
     //update UI and notify external script if any
@@ -76,6 +106,11 @@ private:
 public:
     CCriticalSection cs_instantsend;
 
+    CInstantSend() :
+        pCurrentBlockIndex(NULL),
+        nEternitynodeOrphanVoteTimeTotal(0)
+        {}
+
     void ProcessMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv);
 
     bool ProcessTxLockRequest(const CTxLockRequest& txLockRequest);
@@ -103,6 +138,12 @@ public:
 
     void Relay(const uint256& txHash);
 
+    int GetLockCandidateCount();
+    int GetVoteCount();
+    int GetOrphanVoteCount();
+    /// Approximate memory used by lock candidates and votes in bytes
+    size_t GetMemoryUsage();
+
     void UpdatedBlockTip(const CBlockIndex *pindex);
     void SyncTransaction(const CTransaction& tx, const CBlock* pblock);
 };
@@ -178,12 +219,15 @@ public:
     uint256 GetTxHash() const { return txHash; }
     COutPoint GetOutpoint() const { return outpoint; }
     COutPoint GetEternitynodeOutpoint() const { return outpointEternitynode; }
+    std::vector<unsigned char> GetSignature() const { return vchEternitynodeSignature; }
     int64_t GetTimeCreated() const { return nTimeCreated; }
 
     bool IsValid(CNode* pnode) const;
     void SetConfirmedHeight(int nConfirmedHeightIn) { nConfirmedHeight = nConfirmedHeightIn; }
     bool IsExpired(int nHeight) const;
 
+    /// The message covered by vchEternitynodeSignature
+    std::string GetSignatureMessage() const;
     bool Sign();
     bool CheckSignature() const;
 
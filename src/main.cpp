@@ -39,6 +39,7 @@
 #include "versionbits.h"
 
 #include "spysend.h"
+#include "spysend-sigcheck.h"
 #include "governance.h"
 #include "instantx.h"
 #include "eternitynode-payments.h"
@@ -53,6 +54,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/math/distributions/poisson.hpp>
 #include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
 
 using namespace std;
 
@@ -574,8 +576,88 @@ bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats) {
     return true;
 }
 
+namespace {
+
+typedef void (*NetMsgHandlerFunc)(CNode* pfrom, std::string& strCommand, CDataStream& vRecv);
+
+/** Extension message handler and statistics of the messages routed to it */
+struct CNetMsgHandler
+{
+    NetMsgHandlerFunc func;
+    CNetMsgHandlerStats stats;
+};
+
+typedef boost::unordered_map<std::string, CNetMsgHandler> net_msg_handler_m_t;
+
+/** Owner of every eternitynode/governance message type, filled once by RegisterNodeSignals */
+net_msg_handler_m_t mapNetMsgHandlers;
+/** Protects handler stats */
+CCriticalSection cs_mapNetMsgHandlers;
+
+void ProcessSpySendMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { spySendPool.ProcessMessage(pfrom, strCommand, vRecv); }
+void ProcessEternitynodeMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { mnodeman.ProcessMessage(pfrom, strCommand, vRecv); }
+void ProcessPaymentsMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { enpayments.ProcessMessage(pfrom, strCommand, vRecv); }
+void ProcessInstantSendMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { instantsend.ProcessMessage(pfrom, strCommand, vRecv); }
+void ProcessSporkMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { sporkManager.ProcessSpork(pfrom, strCommand, vRecv); }
+void ProcessSyncMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { eternitynodeSync.ProcessMessage(pfrom, strCommand, vRecv); }
+void ProcessGovernanceMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv) { governance.ProcessMessage(pfrom, strCommand, vRecv); }
+
+void RegisterNetMsgHandler(const char* pszCommand, NetMsgHandlerFunc func)
+{
+    CNetMsgHandler handler;
+    handler.func = func;
+    mapNetMsgHandlers[pszCommand] = handler;
+}
+
+void RegisterNetMsgHandlers()
+{
+    if (!mapNetMsgHandlers.empty())
+        return;
+
+    RegisterNetMsgHandler(NetMsgType::DSACCEPT, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSQUEUE, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSVIN, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSSTATUSUPDATE, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSSIGNFINALTX, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSFINALTX, &ProcessSpySendMessage);
+    RegisterNetMsgHandler(NetMsgType::DSCOMPLETE, &ProcessSpySendMessage);
+
+    RegisterNetMsgHandler(NetMsgType::MNANNOUNCE, &ProcessEternitynodeMessage);
+    RegisterNetMsgHandler(NetMsgType::MNPING, &ProcessEternitynodeMessage);
+    RegisterNetMsgHandler(NetMsgType::DSEG, &ProcessEternitynodeMessage);
+    RegisterNetMsgHandler(NetMsgType::DSEGDIFF, &ProcessEternitynodeMessage);
+    RegisterNetMsgHandler(NetMsgType::MNVERIFY, &ProcessEternitynodeMessage);
+
+    RegisterNetMsgHandler(NetMsgType::ETERNITYNODEPAYMENTSYNC, &ProcessPaymentsMessage);
+    RegisterNetMsgHandler(NetMsgType::ETERNITYNODEPAYMENTVOTE, &ProcessPaymentsMessage);
+
+    RegisterNetMsgHandler(NetMsgType::TXLOCKVOTE, &ProcessInstantSendMessage);
+
+    RegisterNetMsgHandler(NetMsgType::SPORK, &ProcessSporkMessage);
+    RegisterNetMsgHandler(NetMsgType::GETSPORKS, &ProcessSporkMessage);
+
+    RegisterNetMsgHandler(NetMsgType::SYNCSTATUSCOUNT, &ProcessSyncMessage);
+
+    RegisterNetMsgHandler(NetMsgType::MNGOVERNANCESYNC, &ProcessGovernanceMessage);
+    RegisterNetMsgHandler(NetMsgType::MNGOVERNANCEOBJECT, &ProcessGovernanceMessage);
+    RegisterNetMsgHandler(NetMsgType::MNGOVERNANCEOBJECTVOTE, &ProcessGovernanceMessage);
+}
+
+} // anon namespace
+
+void GetNetMsgHandlerStats(std::map<std::string, CNetMsgHandlerStats>& mapStatsRet)
+{
+    LOCK(cs_mapNetMsgHandlers);
+    mapStatsRet.clear();
+    for (net_msg_handler_m_t::const_iterator it = mapNetMsgHandlers.begin(); it != mapNetMsgHandlers.end(); ++it) {
+        mapStatsRet[it->first] = it->second.stats;
+    }
+}
+
 void RegisterNodeSignals(CNodeSignals& nodeSignals)
 {
+    RegisterNetMsgHandlers();
+
     nodeSignals.GetHeight.connect(&GetHeight);
     nodeSignals.ProcessMessages.connect(&ProcessMessages);
     nodeSignals.SendMessages.connect(&SendMessages);
@@ -941,20 +1023,85 @@ unsigned int GetP2SHSigOpCount(const CTransaction& tx, const CCoinsViewCache& in
     return nSigOps;
 }
 
+namespace {
+
+/**
+ * Outputs spent by the last SPENT_OUTPUT_HEIGHT_BLOCKS connected blocks and the heights
+ * they were created at, so that InstantSend votes which arrive after the lock request
+ * was mined can be checked without reading the transaction from disk.
+ * Protected by cs_main.
+ */
+boost::unordered_map<COutPoint, int, COutPointHasher> mapSpentOutputHeights;
+/** Outputs in mapSpentOutputHeights by the height of the block which spent them */
+std::map<int, std::vector<COutPoint> > mapSpentOutputsByBlock;
+
+void AddSpentOutputHeights(int nBlockHeight, const std::vector<std::pair<COutPoint, int> >& vSpent)
+{
+    AssertLockHeld(cs_main);
+
+    std::vector<COutPoint>& vOutpoints = mapSpentOutputsByBlock[nBlockHeight];
+    for (size_t i = 0; i < vSpent.size(); i++) {
+        mapSpentOutputHeights[vSpent[i].first] = vSpent[i].second;
+        vOutpoints.push_back(vSpent[i].first);
+    }
+
+    // forget blocks which are too old
+    std::map<int, std::vector<COutPoint> >::iterator it = mapSpentOutputsByBlock.begin();
+    while (it != mapSpentOutputsByBlock.end() && it->first <= nBlockHeight - SPENT_OUTPUT_HEIGHT_BLOCKS) {
+        BOOST_FOREACH(const COutPoint& outpoint, it->second) {
+            mapSpentOutputHeights.erase(outpoint);
+        }
+        mapSpentOutputsByBlock.erase(it++);
+    }
+}
+
+void RemoveSpentOutputHeights(int nBlockHeight)
+{
+    AssertLockHeld(cs_main);
+
+    // outputs spent by a disconnected block are unspent again (or gone with their own tx)
+    std::map<int, std::vector<COutPoint> >::iterator it = mapSpentOutputsByBlock.find(nBlockHeight);
+    if (it == mapSpentOutputsByBlock.end())
+        return;
+    BOOST_FOREACH(const COutPoint& outpoint, it->second) {
+        mapSpentOutputHeights.erase(outpoint);
+    }
+    mapSpentOutputsByBlock.erase(it);
+}
+
+} // anon namespace
+
 int GetUTXOHeight(const COutPoint& outpoint)
 {
     LOCK(cs_main);
-    CCoins coins;
-    if(!pcoinsTip->GetCoins(outpoint.hash, coins) ||
-       (unsigned int)outpoint.n>=coins.vout.size() ||
-       coins.vout[outpoint.n].IsNull()) {
+    int nHeight;
+    if(!pcoinsTip->GetUnspentOutputHeight(outpoint, nHeight)) {
         return -1;
     }
-    return coins.nHeight;
+    return nHeight;
+}
+
+int GetSpentOutputHeight(const COutPoint& outpoint)
+{
+    LOCK(cs_main);
+    boost::unordered_map<COutPoint, int, COutPointHasher>::const_iterator it = mapSpentOutputHeights.find(outpoint);
+    if(it == mapSpentOutputHeights.end()) {
+        return -1;
+    }
+    return it->second;
 }
 
 int GetInputAge(const CTxIn &txin)
 {
+    {
+        // confirmed and unspent, no need to build a mempool view
+        LOCK(cs_main);
+        int nHeight;
+        if (pcoinsTip->GetUnspentOutputHeight(txin.prevout, nHeight)) {
+            return chainActive.Height() - nHeight + 1;
+        }
+    }
+
     CCoinsView viewDummy;
     CCoinsViewCache view(&viewDummy);
     {
@@ -1679,7 +1826,7 @@ bool WriteBlockToDisk(const CBlock& block, CDiskBlockPos& pos, const CMessageHea
     return true;
 }
 
-bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus::Params& consensusParams)
+static bool ReadBlockFromDiskUnchecked(CBlock& block, const CDiskBlockPos& pos)
 {
     block.SetNull();
 
@@ -1696,6 +1843,14 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus:
         return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
     }
 
+    return true;
+}
+
+bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus::Params& consensusParams)
+{
+    if (!ReadBlockFromDiskUnchecked(block, pos))
+        return false;
+
     // Check the header
     if (!CheckProofOfWork(block.GetHash(), block.nBits, consensusParams))
         return error("ReadBlockFromDisk: Errors in block header at %s", pos.ToString());
@@ -1705,9 +1860,14 @@ bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus:
 
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams)
 {
-    if (!ReadBlockFromDisk(block, pindex->GetBlockPos(), consensusParams))
+    if (!ReadBlockFromDiskUnchecked(block, pindex->GetBlockPos()))
         return false;
-    if (block.GetHash() != pindex->GetBlockHash())
+
+    // X11 is expensive, hash once for both checks
+    uint256 hash = block.GetHash();
+    if (!CheckProofOfWork(hash, block.nBits, consensusParams))
+        return error("ReadBlockFromDisk: Errors in block header at %s", pindex->GetBlockPos().ToString());
+    if (hash != pindex->GetBlockHash())
         return error("ReadBlockFromDisk(CBlock&, CBlockIndex*): GetHash() doesn't match index for %s at %s",
                 pindex->ToString(), pindex->GetBlockPos().ToString());
     return true;
@@ -2505,7 +2665,7 @@ static int64_t nTimeIndex = 0;
 static int64_t nTimeCallbacks = 0;
 static int64_t nTimeTotal = 0;
 
-bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, bool fJustCheck)
+bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, bool fJustCheck, std::vector<std::pair<COutPoint, int> >* pvSpentOutputHeights)
 {
     const CChainParams& chainparams = Params();
     AssertLockHeld(cs_main);
@@ -2522,7 +2682,7 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
 
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
-    if (block.GetHash() == chainparams.GetConsensus().hashGenesisBlock) {
+    if (pindex->GetBlockHash() == chainparams.GetConsensus().hashGenesisBlock) {
         if (!fJustCheck)
             view.SetBestBlock(pindex->GetBlockHash());
         return true;
@@ -2616,6 +2776,7 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
     std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
     std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
     std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
+    std::vector<std::pair<COutPoint, int> > vSpentOutputHeights;
 
     for (unsigned int i = 0; i < block.vtx.size(); i++)
     {
@@ -2640,6 +2801,7 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
             prevheights.resize(tx.vin.size());
             for (size_t j = 0; j < tx.vin.size(); j++) {
                 prevheights[j] = view.AccessCoins(tx.vin[j].prevout.hash)->nHeight;
+                vSpentOutputHeights.push_back(std::make_pair(tx.vin[j].prevout, prevheights[j]));
             }
 
             if (!SequenceLocks(tx, nLockTimeFlags, &prevheights, *pindex)) {
@@ -2763,14 +2925,14 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
     }
 
     if (!IsBlockPayeeValid(block.vtx[0], pindex->nHeight, blockReward)) {
-        mapRejectedBlocks.insert(make_pair(block.GetHash(), GetTime()));
+        mapRejectedBlocks.insert(make_pair(pindex->GetBlockHash(), GetTime()));
         return state.DoS(0, error("ConnectBlock(ETERNITY): couldn't find eternitynode or superblock payments"),
                                 REJECT_INVALID, "bad-cb-payee");
     }
     
 	if( eternitynodeSync.IsBlockchainSynced() && pindex->nHeight>sporkManager.GetSporkValue(SPORK_7_EVOLUTION_PAYMENTS_ENFORCEMENT) ){	
 		if( !evolutionManager.IsTransactionValid( block.vtx[0], pindex->nHeight, blockCurrEvolution )  ){
-			mapRejectedBlocks.insert(make_pair(block.GetHash(), GetTime()));
+			mapRejectedBlocks.insert(make_pair(pindex->GetBlockHash(), GetTime()));
 			return state.DoS(0, error("ConnectBlock(BEENODE): couldn't find beenode evolution payments"),
 								REJECT_INVALID, "bad-cb-payee");
 		}
@@ -2829,6 +2991,9 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
 
+    if (pvSpentOutputHeights)
+        pvSpentOutputHeights->swap(vSpentOutputHeights);
+
     int64_t nTime5 = GetTimeMicros(); nTimeIndex += nTime5 - nTime4;
     LogPrint("bench", "    - Index writing: %.2fms [%.2fs]\n", 0.001 * (nTime5 - nTime4), nTimeIndex * 0.000001);
 
@@ -2837,6 +3002,9 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
     GetMainSignals().UpdatedTransaction(hashPrevBestCoinBase);
     hashPrevBestCoinBase = block.vtx[0].GetHash();
 
+    // ETERNITY : remember who was paid by this block
+    mnodeman.AddBlockPayments(block, pindex);
+
     int64_t nTime6 = GetTimeMicros(); nTimeCallbacks += nTime6 - nTime5;
     LogPrint("bench", "    - Callbacks: %.2fms [%.2fs]\n", 0.001 * (nTime6 - nTime5), nTimeCallbacks * 0.000001);
 
@@ -3039,6 +3207,7 @@ bool static DisconnectTip(CValidationState& state, const Consensus::Params& cons
             return error("DisconnectTip(): DisconnectBlock %s failed", pindexDelete->GetBlockHash().ToString());
         assert(view.Flush());
     }
+    RemoveSpentOutputHeights(pindexDelete->nHeight);
     LogPrint("bench", "- Disconnect block: %.2fms\n", (GetTimeMicros() - nStart) * 0.001);
     // Write the chain state to disk, if necessary.
     if (!FlushStateToDisk(state, FLUSH_STATE_IF_NEEDED))
@@ -3096,9 +3265,10 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
     int64_t nTime2 = GetTimeMicros(); nTimeReadFromDisk += nTime2 - nTime1;
     int64_t nTime3;
     LogPrint("bench", "  - Load block from disk: %.2fms [%.2fs]\n", (nTime2 - nTime1) * 0.001, nTimeReadFromDisk * 0.000001);
+    std::vector<std::pair<COutPoint, int> > vSpentOutputHeights;
     {
         CCoinsViewCache view(pcoinsTip);
-        bool rv = ConnectBlock(*pblock, state, pindexNew, view);
+        bool rv = ConnectBlock(*pblock, state, pindexNew, view, false, &vSpentOutputHeights);
         GetMainSignals().BlockChecked(*pblock, state);
         if (!rv) {
             if (state.IsInvalid())
@@ -3110,6 +3280,7 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
         LogPrint("bench", "  - Connect total: %.2fms [%.2fs]\n", (nTime3 - nTime2) * 0.001, nTimeConnectTotal * 0.000001);
         assert(view.Flush());
     }
+    AddSpentOutputHeights(pindexNew->nHeight, vSpentOutputHeights);
     int64_t nTime4 = GetTimeMicros(); nTimeFlush += nTime4 - nTime3;
     LogPrint("bench", "  - Flush: %.2fms [%.2fs]\n", (nTime4 - nTime3) * 0.001, nTimeFlush * 0.000001);
     // Write the chain state to disk, if necessary.
@@ -3335,6 +3506,10 @@ static bool ActivateBestChainStep(CValidationState& state, const CChainParams& c
  * that is already loaded (to avoid loading it again from disk).
  */
 bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams, const CBlock *pblock) {
+    return ActivateBestChain(state, chainparams, pblock, pblock ? pblock->GetHash() : uint256());
+}
+
+bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams, const CBlock *pblock, const uint256& hashBlock) {
     CBlockIndex *pindexMostWork = NULL;
     do {
         boost::this_thread::interruption_point();
@@ -3353,7 +3528,7 @@ bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams,
             if (pindexMostWork == NULL || pindexMostWork == chainActive.Tip())
                 return true;
 
-            if (!ActivateBestChainStep(state, chainparams, pindexMostWork, pblock && pblock->GetHash() == pindexMostWork->GetBlockHash() ? pblock : NULL))
+            if (!ActivateBestChainStep(state, chainparams, pindexMostWork, pblock && hashBlock == pindexMostWork->GetBlockHash() ? pblock : NULL))
                 return false;
 
             pindexNewTip = chainActive.Tip();
@@ -3483,10 +3658,9 @@ bool ReconsiderBlock(CValidationState& state, CBlockIndex *pindex) {
     return true;
 }
 
-CBlockIndex* AddToBlockIndex(const CBlockHeader& block)
+CBlockIndex* AddToBlockIndex(const CBlockHeader& block, const uint256& hash)
 {
     // Check for duplicate
-    uint256 hash = block.GetHash();
     BlockMap::iterator it = mapBlockIndex.find(hash);
     if (it != mapBlockIndex.end())
         return it->second;
@@ -3652,9 +3826,15 @@ bool FindUndoPos(CValidationState &state, int nFile, CDiskBlockPos &pos, unsigne
 }
 
 bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, bool fCheckPOW)
+{
+    // the hash is only needed for the proof of work
+    return CheckBlockHeader(block, fCheckPOW ? block.GetHash() : uint256(), state, fCheckPOW);
+}
+
+bool CheckBlockHeader(const CBlockHeader& block, const uint256& hash, CValidationState& state, bool fCheckPOW)
 {
     // Check proof of work matches claimed amount
-    if (fCheckPOW && !CheckProofOfWork(block.GetHash(), block.nBits, Params().GetConsensus()))
+    if (fCheckPOW && !CheckProofOfWork(hash, block.nBits, Params().GetConsensus()))
         return state.DoS(50, error("CheckBlockHeader(): proof of work failed"),
                          REJECT_INVALID, "high-hash");
 
@@ -3667,6 +3847,14 @@ bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, bool f
 }
 
 bool CheckBlock(const CBlock& block, CValidationState& state, bool fCheckPOW, bool fCheckMerkleRoot)
+{
+    if (block.fChecked)
+        return true;
+
+    return CheckBlock(block, fCheckPOW ? block.GetHash() : uint256(), state, fCheckPOW, fCheckMerkleRoot);
+}
+
+bool CheckBlock(const CBlock& block, const uint256& hash, CValidationState& state, bool fCheckPOW, bool fCheckMerkleRoot)
 {
     // These are checks that are independent of context.
 
@@ -3675,7 +3863,7 @@ bool CheckBlock(const CBlock& block, CValidationState& state, bool fCheckPOW, bo
 
     // Check that the header is valid (particularly PoW).  This is mostly
     // redundant with the call in AcceptBlockHeader.
-    if (!CheckBlockHeader(block, state, fCheckPOW))
+    if (!CheckBlockHeader(block, hash, state, fCheckPOW))
         return false;
 
     // Check the merkle root.
@@ -3732,7 +3920,7 @@ bool CheckBlock(const CBlock& block, CValidationState& state, bool fCheckPOW, bo
                     // to let other nodes complete the lock.
                     instantsend.Relay(hashLocked);
                     LOCK(cs_main);
-                    mapRejectedBlocks.insert(make_pair(block.GetHash(), GetTime()));
+                    mapRejectedBlocks.insert(make_pair(hash, GetTime()));
                     return state.DoS(0, error("CheckBlock(ETERNITY): transaction %s conflicts with transaction lock %s",
                                                 tx.GetHash().ToString(), hashLocked.ToString()),
                                      REJECT_INVALID, "conflict-tx-lock");
@@ -3860,11 +4048,10 @@ bool ContextualCheckBlock(const CBlock& block, CValidationState& state, CBlockIn
     return true;
 }
 
-static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex=NULL)
+static bool AcceptBlockHeader(const CBlockHeader& block, const uint256& hash, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex=NULL)
 {
     AssertLockHeld(cs_main);
     // Check for duplicate
-    uint256 hash = block.GetHash();
     BlockMap::iterator miSelf = mapBlockIndex.find(hash);
     CBlockIndex *pindex = NULL;
 
@@ -3881,7 +4068,7 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
             return true;
         }
 
-        if (!CheckBlockHeader(block, state))
+        if (!CheckBlockHeader(block, hash, state))
             return false;
 
         // Get prev block index
@@ -3901,7 +4088,7 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
             return false;
     }
     if (pindex == NULL)
-        pindex = AddToBlockIndex(block);
+        pindex = AddToBlockIndex(block, hash);
 
     if (ppindex)
         *ppindex = pindex;
@@ -3910,13 +4097,13 @@ static bool AcceptBlockHeader(const CBlockHeader& block, CValidationState& state
 }
 
 /** Store block on disk. If dbp is non-NULL, the file is known to already reside on disk */
-static bool AcceptBlock(const CBlock& block, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, CDiskBlockPos* dbp)
+static bool AcceptBlock(const CBlock& block, const uint256& hash, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, CDiskBlockPos* dbp)
 {
     AssertLockHeld(cs_main);
 
     CBlockIndex *&pindex = *ppindex;
 
-    if (!AcceptBlockHeader(block, state, chainparams, &pindex))
+    if (!AcceptBlockHeader(block, hash, state, chainparams, &pindex))
         return false;
 
     // Try to process all requested blocks that we don't have, but only
@@ -3940,7 +4127,7 @@ static bool AcceptBlock(const CBlock& block, CValidationState& state, const CCha
         if (fTooFarAhead) return true;      // Block height is too high
     }
 
-    if ((!CheckBlock(block, state)) || !ContextualCheckBlock(block, state, pindex->pprev)) {
+    if ((!CheckBlock(block, hash, state)) || !ContextualCheckBlock(block, state, pindex->pprev)) {
         if (state.IsInvalid() && !state.CorruptionPossible()) {
             pindex->nStatus |= BLOCK_FAILED_VALID;
             setDirtyBlockIndex.insert(pindex);
@@ -3987,13 +4174,19 @@ static bool IsSuperMajority(int minVersion, const CBlockIndex* pstart, unsigned
 
 
 bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, const CNode* pfrom, const CBlock* pblock, bool fForceProcessing, CDiskBlockPos* dbp)
+{
+    // X11 is expensive, hash the block once for all checks
+    return ProcessNewBlock(state, chainparams, pfrom, pblock, pblock->GetHash(), fForceProcessing, dbp);
+}
+
+bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, const CNode* pfrom, const CBlock* pblock, const uint256& hash, bool fForceProcessing, CDiskBlockPos* dbp)
 {
     // Preliminary checks
-    bool checked = CheckBlock(*pblock, state);
+    bool checked = CheckBlock(*pblock, hash, state);
 
     {
         LOCK(cs_main);
-        bool fRequested = MarkBlockAsReceived(pblock->GetHash());
+        bool fRequested = MarkBlockAsReceived(hash);
         fRequested |= fForceProcessing;
         if (!checked) {
             return error("%s: CheckBlock FAILED", __func__);
@@ -4001,7 +4194,7 @@ bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, c
 
         // Store to disk
         CBlockIndex *pindex = NULL;
-        bool ret = AcceptBlock(*pblock, state, chainparams, &pindex, fRequested, dbp);
+        bool ret = AcceptBlock(*pblock, hash, state, chainparams, &pindex, fRequested, dbp);
         if (pindex && pfrom) {
             mapBlockSource[pindex->GetBlockHash()] = pfrom->GetId();
         }
@@ -4010,7 +4203,7 @@ bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, c
             return error("%s: AcceptBlock FAILED", __func__);
     }
 
-    if (!ActivateBestChain(state, chainparams, pblock))
+    if (!ActivateBestChain(state, chainparams, pblock, hash))
         return error("%s: ActivateBestChain failed", __func__);
 
     eternitynodeSync.IsBlockchainSynced(true);
@@ -4509,10 +4702,10 @@ bool InitBlockIndex(const CChainParams& chainparams)
                 return error("LoadBlockIndex(): FindBlockPos failed");
             if (!WriteBlockToDisk(block, blockPos, chainparams.MessageStart()))
                 return error("LoadBlockIndex(): writing genesis block to disk failed");
-            CBlockIndex *pindex = AddToBlockIndex(block);
+            CBlockIndex *pindex = AddToBlockIndex(block, block.GetHash());
             if (!ReceivedBlockTransactions(block, state, pindex, blockPos))
                 return error("LoadBlockIndex(): genesis block not accepted");
-            if (!ActivateBestChain(state, chainparams, &block))
+            if (!ActivateBestChain(state, chainparams, &block, pindex->GetBlockHash()))
                 return error("LoadBlockIndex(): genesis block cannot be activated");
             // Force a chainstate write so that when we VerifyDB in a moment, it doesn't check stale data
             return FlushStateToDisk(state, FLUSH_STATE_ALWAYS);
@@ -4582,7 +4775,7 @@ bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskB
                 // process in case the block isn't known yet
                 if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
                     CValidationState state;
-                    if (ProcessNewBlock(state, chainparams, NULL, &block, true, dbp))
+                    if (ProcessNewBlock(state, chainparams, NULL, &block, hash, true, dbp))
                         nLoaded++;
                     if (state.IsError())
                         break;
@@ -4601,13 +4794,14 @@ bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskB
                         std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
                         if (ReadBlockFromDisk(block, it->second, chainparams.GetConsensus()))
                         {
-                            LogPrintf("%s: Processing out of order child %s of %s\n", __func__, block.GetHash().ToString(),
+                            uint256 hashChild = block.GetHash();
+                            LogPrintf("%s: Processing out of order child %s of %s\n", __func__, hashChild.ToString(),
                                     head.ToString());
                             CValidationState dummy;
-                            if (ProcessNewBlock(dummy, chainparams, NULL, &block, true, &it->second))
+                            if (ProcessNewBlock(dummy, chainparams, NULL, &block, hashChild, true, &it->second))
                             {
                                 nLoaded++;
-                                queue.push_back(block.GetHash());
+                                queue.push_back(hashChild);
                             }
                         }
                         range.first++;
@@ -5541,6 +5735,7 @@ bool static ProcessMessage(CNode* pfrom, string strCommand, CDataStream& vRecv,
 
             bool fAlreadyHave = AlreadyHave(inv);
             LogPrint("net", "got inv: %s  %s peer=%d\n", inv.ToString(), fAlreadyHave ? "have" : "new", pfrom->id);
+            eternitynodeSync.AddedEternitynodeListInv(pfrom->id, inv);
 
             if (inv.type == MSG_BLOCK) {
                 UpdateBlockAvailability(pfrom->GetId(), inv.hash);
@@ -5769,7 +5964,8 @@ bool static ProcessMessage(CNode* pfrom, string strCommand, CDataStream& vRecv,
 
             LogPrintf("DSTX -- Got Eternitynode transaction %s\n", hashTx.ToString());
             mempool.PrioritiseTransaction(hashTx, hashTx.ToString(), 1000, 0.1*COIN);
-            pmn->fAllowMixingTx = false;
+            pmn->SetAllowMixingTx(false);
+            mnodeman.SetListPublishPending();
         }
 
         LOCK(cs_main);
@@ -5946,12 +6142,13 @@ bool static ProcessMessage(CNode* pfrom, string strCommand, CDataStream& vRecv,
                 Misbehaving(pfrom->GetId(), 20);
                 return error("non-continuous headers sequence");
             }
-            if (!AcceptBlockHeader(header, state, chainparams, &pindexLast)) {
+            uint256 hash = header.GetHash();
+            if (!AcceptBlockHeader(header, hash, state, chainparams, &pindexLast)) {
                 int nDoS;
                 if (state.IsInvalid(nDoS)) {
                     if (nDoS > 0)
                         Misbehaving(pfrom->GetId(), nDoS);
-                    std::string strError = "invalid header received " + header.GetHash().ToString();
+                    std::string strError = "invalid header received " + hash.ToString();
                     return error(strError.c_str());
                 }
             }
@@ -6034,7 +6231,7 @@ bool static ProcessMessage(CNode* pfrom, string strCommand, CDataStream& vRecv,
         // Such an unrequested block may still be processed, subject to the
         // conditions in AcceptBlock().
         bool forceProcessing = pfrom->fWhitelisted && !IsInitialBlockDownload();
-        ProcessNewBlock(state, chainparams, pfrom, &block, forceProcessing, NULL);
+        ProcessNewBlock(state, chainparams, pfrom, &block, inv.hash, forceProcessing, NULL);
         int nDoS;
         if (state.IsInvalid(nDoS)) {
             assert (state.GetRejectCode() < REJECT_INTERNAL); // Blocks are never rejected with internal reject codes
@@ -6283,27 +6480,18 @@ bool static ProcessMessage(CNode* pfrom, string strCommand, CDataStream& vRecv,
     }
     else
     {
-        bool found = false;
-        const std::vector<std::string> &allMessages = getAllNetMessageTypes();
-        BOOST_FOREACH(const std::string msg, allMessages) {
-            if(msg == strCommand) {
-                found = true;
-                break;
-            }
-        }
-
-        if (found)
+        // route extension messages to their owner
+        net_msg_handler_m_t::iterator it = mapNetMsgHandlers.find(strCommand);
+        if (it != mapNetMsgHandlers.end())
         {
-            //probably one the extensions
-            spySendPool.ProcessMessage(pfrom, strCommand, vRecv);
-            mnodeman.ProcessMessage(pfrom, strCommand, vRecv);
-            enpayments.ProcessMessage(pfrom, strCommand, vRecv);
-            instantsend.ProcessMessage(pfrom, strCommand, vRecv);
-            sporkManager.ProcessSpork(pfrom, strCommand, vRecv);
-            eternitynodeSync.ProcessMessage(pfrom, strCommand, vRecv);
-            governance.ProcessMessage(pfrom, strCommand, vRecv);
+            {
+                LOCK(cs_mapNetMsgHandlers);
+                it->second.stats.nCount++;
+                it->second.stats.nBytes += vRecv.size();
+            }
+            it->second.func(pfrom, strCommand, vRecv);
         }
-        else
+        else if (std::find(getAllNetMessageTypes().begin(), getAllNetMessageTypes().end(), strCommand) == getAllNetMessageTypes().end())
         {
             // Ignore unknown commands for extensibility
             LogPrint("net", "Unknown command \"%s\" from peer=%d\n", SanitizeString(strCommand), pfrom->id);
@@ -6336,6 +6524,9 @@ bool ProcessMessages(CNode* pfrom)
     // this maintains the order of responses
     if (!pfrom->vRecvGetData.empty()) return fOk;
 
+    // recover signers of queued eternitynode messages on all cores at once
+    PrefetchMessageSignatures(pfrom);
+
     std::deque<CNetMessage>::iterator it = pfrom->vRecvMsg.begin();
     while (!pfrom->fDisconnect && it != pfrom->vRecvMsg.end()) {
         // Don't bother if send buffer is too full to respond anyway
@@ -6428,8 +6619,12 @@ bool ProcessMessages(CNode* pfrom)
     }
 
     // In case the connection got shut down, its receive buffer was wiped
-    if (!pfrom->fDisconnect)
+    if (!pfrom->fDisconnect) {
+        // signers recovered for processed messages which their handlers didn't need won't be asked for anymore
+        for (std::deque<CNetMessage>::iterator itDone = pfrom->vRecvMsg.begin(); itDone != it; ++itDone)
+            ForgetPrefetchedSigners(itDone->vSigPrefetchKeys);
         pfrom->vRecvMsg.erase(pfrom->vRecvMsg.begin(), it);
+    }
 
     return fOk;
 }
@@ -42,6 +42,7 @@ class CValidationInterface;
 class CValidationState;
 
 struct CNodeStateStats;
+struct CNetMsgHandlerStats;
 struct LockPoints;
 
 /** Default for accepting alerts from the P2P network. */
@@ -206,6 +207,8 @@ void UnregisterNodeSignals(CNodeSignals& nodeSignals);
  * @return True if state.IsValid()
  */
 bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, const CNode* pfrom, const CBlock* pblock, bool fForceProcessing, CDiskBlockPos* dbp);
+/** Process an incoming block the caller already hashed, hash must be pblock->GetHash() */
+bool ProcessNewBlock(CValidationState& state, const CChainParams& chainparams, const CNode* pfrom, const CBlock* pblock, const uint256& hash, bool fForceProcessing, CDiskBlockPos* dbp);
 /** Check whether enough disk space is available for an incoming block */
 bool CheckDiskSpace(uint64_t nAdditionalBytes = 0);
 /** Open a block file (blk?????.dat) */
@@ -249,6 +252,8 @@ std::string GetWarnings(const std::string& strFor);
 bool GetTransaction(const uint256 &hash, CTransaction &tx, const Consensus::Params& params, uint256 &hashBlock, bool fAllowSlow = false);
 /** Find the best known block, and make it the tip of the block chain */
 bool ActivateBestChain(CValidationState& state, const CChainParams& chainparams, const CBlock* pblock = NULL);
+/** Find the best known block, and make it the tip of the block chain; hashBlock must be pblock->GetHash() */
+bool ActivateBestChain(CValidationState& state, const CChainParams& chainparams, const CBlock* pblock, const uint256& hashBlock);
 
 double ConvertBitsToDouble(unsigned int nBits);
 CAmount GetBlockSubsidy(int nBits, int nHeight, const Consensus::Params& consensusParams, bool fSuperblockPartOnly = false);
@@ -280,6 +285,8 @@ void UnlinkPrunedFiles(std::set<int>& setFilesToPrune);
 CBlockIndex * InsertBlockIndex(uint256 hash);
 /** Get statistics from node state */
 bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats);
+/** Get number of messages and bytes routed to each eternitynode/governance message handler */
+void GetNetMsgHandlerStats(std::map<std::string, CNetMsgHandlerStats>& mapStatsRet);
 /** Increase a node's misbehavior score. */
 void Misbehaving(NodeId nodeid, int howmuch);
 /** Flush all state, indexes and buffers to disk. */
@@ -291,7 +298,13 @@ void PruneAndFlush();
 bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState &state, const CTransaction &tx, bool fLimitFree,
                         bool* pfMissingInputs, bool fOverrideMempoolLimit=false, bool fRejectAbsurdFee=false, bool fDryRun=false);
 
+/** Number of blocks GetSpentOutputHeight() remembers spent outputs for */
+static const int SPENT_OUTPUT_HEIGHT_BLOCKS = 24;
+
+/** Height of the block which created an unspent output, -1 if it's unknown or spent */
 int GetUTXOHeight(const COutPoint& outpoint);
+/** Height of the block which created an output spent in the last SPENT_OUTPUT_HEIGHT_BLOCKS blocks connected since startup, -1 if there is no such output */
+int GetSpentOutputHeight(const COutPoint& outpoint);
 int GetInputAge(const CTxIn &txin);
 int GetInputAgeIX(const uint256 &nTXHash, const CTxIn &txin);
 int GetIXConfirmations(const uint256 &nTXHash);
@@ -302,6 +315,13 @@ std::string FormatStateMessage(const CValidationState &state);
 /** Get the BIP9 state for a given deployment at the current tip. */
 ThresholdState VersionBitsTipState(const Consensus::Params& params, Consensus::DeploymentPos pos);
 
+struct CNetMsgHandlerStats {
+    uint64_t nCount;
+    uint64_t nBytes;
+
+    CNetMsgHandlerStats() : nCount(0), nBytes(0) {}
+};
+
 struct CNodeStateStats {
     int nMisbehavior;
     int nSyncHeight;
@@ -737,12 +757,16 @@ bool DisconnectBlock(const CBlock& block, CValidationState& state, const CBlockI
 bool DisconnectBlocks(int blocks);
 void ReprocessBlocks(int nBlocks);
 
-/** Apply the effects of this block (with given index) on the UTXO set represented by coins */
-bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& coins, bool fJustCheck = false);
+/** Apply the effects of this block (with given index) on the UTXO set represented by coins,
+ *  pvSpentOutputHeights receives the outputs it spends with the heights they were created at */
+bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& coins, bool fJustCheck = false, std::vector<std::pair<COutPoint, int> >* pvSpentOutputHeights = NULL);
 
 /** Context-independent validity checks */
 bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, bool fCheckPOW = true);
 bool CheckBlock(const CBlock& block, CValidationState& state, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
+/** The same checks for callers which already know the (X11) hash of the block */
+bool CheckBlockHeader(const CBlockHeader& block, const uint256& hash, CValidationState& state, bool fCheckPOW = true);
+bool CheckBlock(const CBlock& block, const uint256& hash, CValidationState& state, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
 
 /** Context-dependent validity checks */
 bool ContextualCheckBlockHeader(const CBlockHeader& block, CValidationState& state, CBlockIndex *pindexPrev);
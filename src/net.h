@@ -227,12 +227,16 @@ public:
 
     int64_t nTime;                  // time (in microseconds) of message receipt.
 
+    bool fSigPrefetched;            // seen by PrefetchMessageSignatures
+    std::vector<uint256> vSigPrefetchKeys; // signers recovered for this message by PrefetchMessageSignatures
+
     CNetMessage(const CMessageHeader::MessageStartChars& pchMessageStartIn, int nTypeIn, int nVersionIn) : hdrbuf(nTypeIn, nVersionIn), hdr(pchMessageStartIn), vRecv(nTypeIn, nVersionIn) {
         hdrbuf.resize(24);
         in_data = false;
         nHdrPos = 0;
         nDataPos = 0;
         nTime = 0;
+        fSigPrefetched = false;
     }
 
     bool complete() const
@@ -263,10 +263,11 @@ void EternitynodeList::updateNodeList()
     ui->tableWidgetEternitynodes->setSortingEnabled(false);
     ui->tableWidgetEternitynodes->clearContents();
     ui->tableWidgetEternitynodes->setRowCount(0);
-    std::vector<CEternitynode> vEternitynodes = mnodeman.GetFullEternitynodeVector();
+    eternitynode_list_t listEternitynodes = mnodeman.GetEternitynodeList();
 
-    BOOST_FOREACH(CEternitynode& mn, vEternitynodes)
+    BOOST_FOREACH(const eternitynode_ptr_t& pmn, *listEternitynodes)
     {
+        const CEternitynode& mn = *pmn;
         // populate list
         // Address, Protocol, Status, Active Seconds, Last Seen, Pub Key
         QTableWidgetItem *addressItem = new QTableWidgetItem(QString::fromStdString(mn.addr.ToString()));
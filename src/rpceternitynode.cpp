@@ -5,6 +5,7 @@
 #include "activeeternitynode.h"
 #include "spysend.h"
 #include "init.h"
+#include "instantx.h"
 #include "main.h"
 #include "eternitynode-payments.h"
 #include "eternitynode-sync.h"
@@ -88,6 +89,33 @@ UniValue getpoolinfo(const UniValue& params, bool fHelp)
     return obj;
 }
 
+UniValue getinstantsendinfo(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 0)
+        throw std::runtime_error(
+            "getinstantsendinfo\n"
+            "Returns an object containing InstantSend related information.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"candidates\": xxxx,     (numeric) Transaction lock candidates\n"
+            "  \"votes\": xxxx,          (numeric) Transaction lock votes, including orphan ones\n"
+            "  \"orphanvotes\": xxxx,    (numeric) Votes for transactions we haven't seen lock requests for yet\n"
+            "  \"memoryusage\": xxxx,    (numeric) Approximate memory used by candidates and votes in bytes\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getinstantsendinfo", "")
+            + HelpExampleRpc("getinstantsendinfo", "")
+        );
+
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("candidates",        instantsend.GetLockCandidateCount()));
+    obj.push_back(Pair("votes",             instantsend.GetVoteCount()));
+    obj.push_back(Pair("orphanvotes",       instantsend.GetOrphanVoteCount()));
+    obj.push_back(Pair("memoryusage",       (uint64_t)instantsend.GetMemoryUsage()));
+
+    return obj;
+}
+
 
 UniValue eternitynode(const UniValue& params, bool fHelp)
 {
@@ -110,7 +138,7 @@ UniValue eternitynode(const UniValue& params, bool fHelp)
                 "\nArguments:\n"
                 "1. \"command\"        (string or set of strings, required) The command to execute\n"
                 "\nAvailable commands:\n"
-                "  count        - Print number of all known eternitynodes (optional: 'ps', 'enabled', 'all', 'qualify')\n"
+                "  count        - Print number of all known eternitynodes (optional: 'ps', 'enabled', 'all', 'qualify', 'memory')\n"
                 "  current      - Print info on current eternitynode winner to be paid the next block (calculated locally)\n"
                 "  debug        - Print eternitynode status\n"
                 "  genkey       - Generate new eternitynodeprivkey\n"
@@ -167,6 +195,14 @@ UniValue eternitynode(const UniValue& params, bool fHelp)
         if (strMode == "enabled")
             return mnodeman.CountEnabled();
 
+        if (strMode == "memory") {
+            UniValue obj(UniValue::VOBJ);
+            obj.push_back(Pair("paymentvotes", enpayments.GetVoteCount()));
+            obj.push_back(Pair("paymentblocks", enpayments.GetBlockCount()));
+            obj.push_back(Pair("paymentbytes", (uint64_t)enpayments.GetMemoryUsage()));
+            return obj;
+        }
+
         int nCount;
         mnodeman.GetNextEternitynodeInQueueForPayment(true, nCount);
 
@@ -484,15 +520,16 @@ UniValue eternitynodelist(const UniValue& params, bool fHelp)
 
     UniValue obj(UniValue::VOBJ);
     if (strMode == "rank") {
-        std::vector<std::pair<int, CEternitynode> > vEternitynodeRanks = mnodeman.GetEternitynodeRanks();
-        BOOST_FOREACH(PAIRTYPE(int, CEternitynode)& s, vEternitynodeRanks) {
-            std::string strOutpoint = s.second.vin.prevout.ToStringShort();
+        std::vector<std::pair<int, eternitynode_ptr_t> > vEternitynodeRanks = mnodeman.GetEternitynodeRanks();
+        BOOST_FOREACH(PAIRTYPE(int, eternitynode_ptr_t)& s, vEternitynodeRanks) {
+            std::string strOutpoint = s.second->vin.prevout.ToStringShort();
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) continue;
             obj.push_back(Pair(strOutpoint, s.first));
         }
     } else {
-        std::vector<CEternitynode> vEternitynodes = mnodeman.GetFullEternitynodeVector();
-        BOOST_FOREACH(CEternitynode& mn, vEternitynodes) {
+        eternitynode_list_t listEternitynodes = mnodeman.GetEternitynodeList();
+        BOOST_FOREACH(const eternitynode_ptr_t& pmn, *listEternitynodes) {
+            const CEternitynode& mn = *pmn;
             std::string strOutpoint = mn.vin.prevout.ToStringShort();
             if (strMode == "activeseconds") {
                 if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) continue;
@@ -380,6 +380,13 @@ UniValue getnettotals(const UniValue& params, bool fHelp)
             "    \"serve_historical_blocks\": true|false,  (boolean) True if serving historical blocks\n"
             "    \"bytes_left_in_cycle\": t,               (numeric) Bytes left in current time cycle\n"
             "    \"time_left_in_cycle\": t                 (numeric) Seconds left in current time cycle\n"
+            "  },\n"
+            "  \"messages\":                (json object) Eternitynode, governance and other extension messages received\n"
+            "  {\n"
+            "    \"command\": {                          (json object) Message type\n"
+            "      \"count\": n,                         (numeric) Number of messages received\n"
+            "      \"bytes\": n                          (numeric) Total size of message payloads\n"
+            "    }, ...\n"
             "  }\n"
             "}\n"
             "\nExamples:\n"
@@ -400,6 +407,17 @@ UniValue getnettotals(const UniValue& params, bool fHelp)
     outboundLimit.push_back(Pair("bytes_left_in_cycle", CNode::GetOutboundTargetBytesLeft()));
     outboundLimit.push_back(Pair("time_left_in_cycle", CNode::GetMaxOutboundTimeLeftInCycle()));
     obj.push_back(Pair("uploadtarget", outboundLimit));
+
+    std::map<std::string, CNetMsgHandlerStats> mapMsgStats;
+    GetNetMsgHandlerStats(mapMsgStats);
+    UniValue messages(UniValue::VOBJ);
+    for (std::map<std::string, CNetMsgHandlerStats>::const_iterator it = mapMsgStats.begin(); it != mapMsgStats.end(); ++it) {
+        UniValue msgStats(UniValue::VOBJ);
+        msgStats.push_back(Pair("count", it->second.nCount));
+        msgStats.push_back(Pair("bytes", it->second.nBytes));
+        messages.push_back(Pair(it->first, msgStats));
+    }
+    obj.push_back(Pair("messages", messages));
     return obj;
 }
 
@@ -353,6 +353,7 @@ static const CRPCCommand vRPCCommands[] =
     { "eternity",               "ensync",                 &ensync,                 true  },
     { "eternity",               "spork",                  &spork,                  true  },
     { "eternity",               "getpoolinfo",            &getpoolinfo,            true  },
+    { "eternity",               "getinstantsendinfo",     &getinstantsendinfo,     true  },
 #ifdef ENABLE_WALLET
     { "eternity",               "spysend",            &spysend,            false },
 
@@ -267,6 +267,7 @@ extern UniValue verifytxoutproof(const UniValue& params, bool fHelp);
 
 extern UniValue spysend(const UniValue& params, bool fHelp);
 extern UniValue getpoolinfo(const UniValue& params, bool fHelp);
+extern UniValue getinstantsendinfo(const UniValue& params, bool fHelp);
 extern UniValue spork(const UniValue& params, bool fHelp);
 extern UniValue eternitynode(const UniValue& params, bool fHelp);
 extern UniValue eternitynodelist(const UniValue& params, bool fHelp);
@@ -315,15 +315,27 @@ void CSporkMessage::Relay()
     RelayInv(inv);
 }
 
+CEvolutionPayee::CEvolutionPayee( const std::string &strAddressIn )
+	: strAddress(strAddressIn),
+	  fValid(false),
+	  dest(CNoDestination()),
+	  scriptPubKey()
+{
+	CBitcoinAddress address( strAddress );
+	if( address.IsValid() ){
+		fValid = true;
+		dest = address.Get();
+		scriptPubKey = GetScriptForDestination( dest );
+	}
+}
+
 void CEvolutionManager::setNewEvolutions( const std::string &sEvol )
 {
-	LOCK( cs_mapEvolution );
-	
 	unsigned long bComplete = 0;
-	unsigned long uCountEvolution = 0;
 	unsigned long uStart = 0;
 	
-	mapEvolution.clear();
+	// decode the addresses before taking the lock
+	std::vector<CEvolutionPayee> vecEvolutionNew;
 
 	for( unsigned int i = 0; i < sEvol.size() ; i++ )
 	{
@@ -333,43 +345,65 @@ void CEvolutionManager::setNewEvolutions( const std::string &sEvol )
 		}
 
 		if( (sEvol.c_str()[i] == ',') && (bComplete == 1)  ){
-			mapEvolution.insert(  make_pair( uCountEvolution, std::string(sEvol.c_str() + uStart, i-uStart))  );
-			uCountEvolution++;
+			vecEvolutionNew.push_back( CEvolutionPayee(std::string(sEvol.c_str() + uStart, i-uStart)) );
 			uStart = i + 1;
 		}
 
 		if(  (sEvol.c_str()[i] == ']') && (bComplete == 1)  ){
 			bComplete = 2;
-			mapEvolution.insert(  make_pair( uCountEvolution, std::string(sEvol.c_str() + uStart, i - uStart))  );
-			uCountEvolution++;
+			vecEvolutionNew.push_back( CEvolutionPayee(std::string(sEvol.c_str() + uStart, i - uStart)) );
 		}
 	}
+
+	LOCK( cs_mapEvolution );
+	vecEvolution.swap( vecEvolutionNew );
 }
 
-std::string CEvolutionManager::getEvolution( int nBlockHeight )
-{	
+CScript CEvolutionManager::getEvolutionScript( int nBlockHeight )
+{
 	LOCK( cs_mapEvolution );
-	
-	return mapEvolution[ nBlockHeight%mapEvolution.size() ];
-}	
+
+	if( vecEvolution.empty() ){
+		return CScript();
+	}
+	return vecEvolution[ nBlockHeight%vecEvolution.size() ].scriptPubKey;
+}
 
 bool CEvolutionManager::IsTransactionValid( const CTransaction& txNew, int nBlockHeight, CAmount blockCurEvolution  )
 {	
 	LOCK( cs_mapEvolution );
 
 	
-	if( mapEvolution.size() < 1 ){ 
+	if( vecEvolution.empty() ){ 
 		return true;
 	}
 	
+	const CEvolutionPayee& payee = vecEvolution[ nBlockHeight%vecEvolution.size() ];
+	if( !payee.fValid ){
+		return false;
+	}
+
+	// fast path: the output where we put it, then any output paying the exact script
+	if( txNew.vout.size() > EVOLUTION_OUTPUT_INDEX &&
+		txNew.vout[EVOLUTION_OUTPUT_INDEX].scriptPubKey == payee.scriptPubKey && txNew.vout[EVOLUTION_OUTPUT_INDEX].nValue == blockCurEvolution ){
+		return true;
+	}
+	for( unsigned int i = 0; i < txNew.vout.size(); i++ )
+	{
+		if( txNew.vout[i].scriptPubKey == payee.scriptPubKey && txNew.vout[i].nValue == blockCurEvolution ){
+			return true;
+		}
+	}
+
+	// other scripts paying the same destination (e.g. pay-to-pubkey) are accepted as well,
+	// as before a script without destination is compared using the previous output's one
 	CTxDestination address1;
 
 	for( unsigned int i = 0; i < txNew.vout.size(); i++ )
 	{	
 		ExtractDestination(txNew.vout[i].scriptPubKey, address1);
-		CBitcoinAddress address2(address1);
 
-		if(  ( mapEvolution[nBlockHeight%mapEvolution.size()] == address2.ToString() ) && (blockCurEvolution == txNew.vout[i].nValue)  ){
+		if(  ( address1 == payee.dest ) && (blockCurEvolution == txNew.vout[i].nValue)  ){
 			return true;
 		}
 	}	
@@ -7,6 +7,8 @@
 
 #include "hash.h"
 #include "net.h"
+#include "pubkey.h"
+#include "script/standard.h"
 #include "utilstrencodings.h"
 
 class CSporkMessage;
@@ -132,17 +134,35 @@ public:
 };
 
 
+/**
+ * Evolution payee from the SPORK_6_EVOLUTION_PAYMENTS address list,
+ * decoded once when the spork is updated.
+ */
+class CEvolutionPayee
+{
+public:
+	std::string strAddress;
+	bool fValid;
+	CTxDestination dest;
+	CScript scriptPubKey;
+
+	CEvolutionPayee( const std::string &strAddressIn );
+};
+
 class CEvolutionManager
 {
 private:
-	std::map<int, std::string> mapEvolution;
+	std::vector<CEvolutionPayee> vecEvolution;
 
 public:
+	/// The evolution output follows the miner output in blocks we create
+	static const unsigned int EVOLUTION_OUTPUT_INDEX = 1;
 
 	CEvolutionManager() {}
 	
 	void setNewEvolutions( const std::string &sEvol );
-	std::string getEvolution( int nBlockHeight );
+	/// Payee script for nBlockHeight, empty if there is no valid evolution address
+	CScript getEvolutionScript( int nBlockHeight );
 	bool IsTransactionValid( const CTransaction& txNew, int nBlockHeight, CAmount blockCurEvolution );
 	bool checkEvolutionString( const std::string &sEvol );
 };
@@ -0,0 +1,247 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "spysend-sigcheck.h"
+
+#include "checkqueue.h"
+#include "crypto/sha256.h"
+#include "spysend.h"
+#include "instantx.h"
+#include "eternitynode.h"
+#include "eternitynode-payments.h"
+#include "eternitynodeman.h"
+#include "main.h"
+#include "memusage.h"
+#include "net.h"
+#include "random.h"
+#include "util.h"
+
+#include <deque>
+#include <map>
+
+#include <boost/foreach.hpp>
+#include <boost/thread.hpp>
+#include <boost/unordered_set.hpp>
+
+/** Keep at most this many recovered signers around until their messages are processed */
+static const unsigned int MAX_PREFETCHED_SIGNERS = 20000;
+
+static CCheckQueue<CSignedMessageCheck> signedmessagecheckqueue(128);
+
+static CCriticalSection cs_mapPrefetchedSigners;
+static std::map<uint256, CSignedMessageResult> mapPrefetchedSigners;
+// insertion order, used to evict results of messages which were never verified
+static std::deque<uint256> dequePrefetchedSigners;
+
+static uint256 GetPrefetchKey(const uint256& hashMessage, const std::vector<unsigned char>& vchSig)
+{
+    return Hash(hashMessage.begin(), hashMessage.end(), vchSig.begin(), vchSig.end());
+}
+
+bool CSignedMessageCheck::operator()()
+{
+    CPubKey pubkeyFromSig;
+    pResult->fValid = pubkeyFromSig.RecoverCompact(hashMessage, vchSig);
+    if(pResult->fValid)
+        pResult->keyID = pubkeyFromSig.GetID();
+    return true;
+}
+
+void ThreadSignedMessageCheck()
+{
+    RenameThread("eternity-msgsigch");
+    signedmessagecheckqueue.Thread();
+}
+
+/** Queue a signature for recovery unless it's unknown who should have signed it or it was verified before */
+static void AddPrefetchSig(std::vector<std::pair<uint256, std::vector<unsigned char> > >& vSigs, CNetMessage& msg,
+                            const uint256& hashMessage, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey)
+{
+    if(!pubkey.IsValid() || GetMessageSigCache(hashMessage, vchSig, pubkey)) return;
+    vSigs.push_back(std::make_pair(hashMessage, vchSig));
+    msg.vSigPrefetchKeys.push_back(GetPrefetchKey(hashMessage, vchSig));
+}
+
+void PrefetchMessageSignatures(CNode* pfrom)
+{
+    // no worker threads
+    if(!nScriptCheckThreads) return;
+
+    std::vector<std::pair<uint256, std::vector<unsigned char> > > vSigs;
+
+    for(std::deque<CNetMessage>::iterator it = pfrom->vRecvMsg.begin(); it != pfrom->vRecvMsg.end(); ++it) {
+        CNetMessage& msg = *it;
+        if(!msg.complete()) break;
+        if(msg.fSigPrefetched) continue;
+        msg.fSigPrefetched = true;
+
+        std::string strCommand = msg.hdr.GetCommand();
+        try {
+            // work on a copy, the message is processed as usual later
+            CDataStream vRecv(msg.vRecv);
+            if(strCommand == NetMsgType::MNANNOUNCE) {
+                CEternitynodeBroadcast mnb;
+                vRecv >> mnb;
+                AddPrefetchSig(vSigs, msg, spySendSigner.GetMessageHash(mnb.GetSignatureMessage()), mnb.vchSig, mnb.pubKeyCollateralAddress);
+                AddPrefetchSig(vSigs, msg, spySendSigner.GetMessageHash(mnb.lastPing.GetSignatureMessage()), mnb.lastPing.vchSig, mnb.pubKeyEternitynode);
+            } else if(strCommand == NetMsgType::MNPING) {
+                CEternitynodePing mnp;
+                vRecv >> mnp;
+                eternitynode_info_t infoMn = mnodeman.GetEternitynodeInfo(mnp.vin);
+                AddPrefetchSig(vSigs, msg, spySendSigner.GetMessageHash(mnp.GetSignatureMessage()), mnp.vchSig, infoMn.pubKeyEternitynode);
+            } else if(strCommand == NetMsgType::ETERNITYNODEPAYMENTVOTE) {
+                CEternitynodePaymentVote vote;
+                vRecv >> vote;
+                eternitynode_info_t infoMn = mnodeman.GetEternitynodeInfo(vote.vinEternitynode);
+                AddPrefetchSig(vSigs, msg, spySendSigner.GetMessageHash(vote.GetSignatureMessage()), vote.vchSig, infoMn.pubKeyEternitynode);
+            } else if(strCommand == NetMsgType::TXLOCKVOTE) {
+                CTxLockVote vote;
+                vRecv >> vote;
+                eternitynode_info_t infoMn = mnodeman.GetEternitynodeInfo(CTxIn(vote.GetEternitynodeOutpoint()));
+                AddPrefetchSig(vSigs, msg, spySendSigner.GetMessageHash(vote.GetSignatureMessage()), vote.GetSignature(), infoMn.pubKeyEternitynode);
+            }
+        } catch (const std::exception&) {
+            // malformed, ProcessMessage is going to deal with it
+        }
+    }
+
+    // nothing to parallelize
+    if(vSigs.size() < 2) return;
+
+    std::vector<CSignedMessageResult> vResults(vSigs.size());
+    std::vector<CSignedMessageCheck> vChecks;
+    vChecks.reserve(vSigs.size());
+    for(unsigned int i = 0; i < vSigs.size(); i++)
+        vChecks.push_back(CSignedMessageCheck(vSigs[i].first, vSigs[i].second, &vResults[i]));
+
+    int64_t nTimeStart = GetTimeMicros();
+    CCheckQueueControl<CSignedMessageCheck> control(&signedmessagecheckqueue);
+    control.Add(vChecks);
+    control.Wait();
+
+    LogPrint("eternitynode", "PrefetchMessageSignatures -- recovered %u signers, peer=%d, %.2fms\n",
+                vSigs.size(), pfrom->id, 0.001 * (GetTimeMicros() - nTimeStart));
+
+    LOCK(cs_mapPrefetchedSigners);
+    for(unsigned int i = 0; i < vSigs.size(); i++) {
+        uint256 hashKey = GetPrefetchKey(vSigs[i].first, vSigs[i].second);
+        if(!mapPrefetchedSigners.insert(std::make_pair(hashKey, vResults[i])).second) continue;
+        dequePrefetchedSigners.push_back(hashKey);
+    }
+    while(dequePrefetchedSigners.size() > MAX_PREFETCHED_SIGNERS) {
+        mapPrefetchedSigners.erase(dequePrefetchedSigners.front());
+        dequePrefetchedSigners.pop_front();
+    }
+}
+
+void ForgetPrefetchedSigners(const std::vector<uint256>& vKeys)
+{
+    if(vKeys.empty()) return;
+
+    LOCK(cs_mapPrefetchedSigners);
+    // the keys stay in dequePrefetchedSigners until they're evicted, erasing a missing key is harmless
+    BOOST_FOREACH(const uint256& hashKey, vKeys)
+        mapPrefetchedSigners.erase(hashKey);
+}
+
+bool GetPrefetchedSigner(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, CSignedMessageResult& resultRet)
+{
+    LOCK(cs_mapPrefetchedSigners);
+    if(mapPrefetchedSigners.empty()) return false;
+
+    std::map<uint256, CSignedMessageResult>::iterator it = mapPrefetchedSigners.find(GetPrefetchKey(hashMessage, vchSig));
+    if(it == mapPrefetchedSigners.end()) return false;
+
+    resultRet = it->second;
+    // the key stays in dequePrefetchedSigners until it's evicted, erasing a missing key is harmless
+    mapPrefetchedSigners.erase(it);
+    return true;
+}
+
+namespace {
+
+/**
+ * We're hashing a nonce into the entries themselves, so we don't need extra
+ * blinding in the set hash computation.
+ */
+class CMessageSigCacheHasher
+{
+public:
+    size_t operator()(const uint256& key) const {
+        return key.GetCheapHash();
+    }
+};
+
+/**
+ * Valid message signature cache, to avoid recovering the signer of the same
+ * ping, broadcast or vote again when it's relayed by another peer or loaded from disk
+ */
+class CMessageSigCache
+{
+private:
+    //! Entries are SHA256(nonce || message hash || public key || signature):
+    uint256 nonce;
+    typedef boost::unordered_set<uint256, CMessageSigCacheHasher> map_type;
+    map_type setValid;
+    boost::shared_mutex cs_msgsigcache;
+
+public:
+    CMessageSigCache()
+    {
+        GetRandBytes(nonce.begin(), 32);
+    }
+
+    void ComputeEntry(uint256& entry, const uint256& hash, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey)
+    {
+        CSHA256().Write(nonce.begin(), 32).Write(hash.begin(), 32).Write(pubkey.begin(), pubkey.size()).Write(begin_ptr(vchSig), vchSig.size()).Finalize(entry.begin());
+    }
+
+    bool Get(const uint256& entry)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_msgsigcache);
+        return setValid.count(entry);
+    }
+
+    void Set(const uint256& entry)
+    {
+        size_t nMaxCacheSize = GetArg("-msgsigcachesize", DEFAULT_MAX_MSG_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+        if (nMaxCacheSize <= 0) return;
+
+        boost::unique_lock<boost::shared_mutex> lock(cs_msgsigcache);
+        while (memusage::DynamicUsage(setValid) > nMaxCacheSize)
+        {
+            map_type::size_type s = GetRand(setValid.bucket_count());
+            map_type::local_iterator it = setValid.begin(s);
+            if (it != setValid.end(s)) {
+                setValid.erase(*it);
+            }
+        }
+
+        setValid.insert(entry);
+    }
+};
+
+CMessageSigCache& GetMessageSigCacheInstance()
+{
+    static CMessageSigCache messageSigCache;
+    return messageSigCache;
+}
+
+}
+
+bool GetMessageSigCache(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey)
+{
+    CMessageSigCache& messageSigCache = GetMessageSigCacheInstance();
+    uint256 entry;
+    messageSigCache.ComputeEntry(entry, hashMessage, vchSig, pubkey);
+    return messageSigCache.Get(entry);
+}
+
+void SetMessageSigCache(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey)
+{
+    CMessageSigCache& messageSigCache = GetMessageSigCacheInstance();
+    uint256 entry;
+    messageSigCache.ComputeEntry(entry, hashMessage, vchSig, pubkey);
+    messageSigCache.Set(entry);
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SPYSEND_SIGCHECK_H
+#define SPYSEND_SIGCHECK_H
+
+#include "pubkey.h"
+#include "uint256.h"
+
+#include <vector>
+
+class CNode;
+
+// DoS prevention: limit cache size to 10MB (over 100000 entries on 64-bit systems)
+static const unsigned int DEFAULT_MAX_MSG_SIG_CACHE_SIZE = 10;
+
+/** Signer recovered from a compact message signature */
+struct CSignedMessageResult
+{
+    bool fValid;
+    CKeyID keyID;
+
+    CSignedMessageResult() : fValid(false), keyID() {}
+};
+
+/**
+ * Closure representing one compact message signature whose signer should be
+ * recovered, see CSpySendSigner::VerifyMessage.
+ * Note that this stores a pointer to the result slot, which must outlive the check.
+ */
+class CSignedMessageCheck
+{
+private:
+    uint256 hashMessage;
+    std::vector<unsigned char> vchSig;
+    CSignedMessageResult* pResult;
+
+public:
+    CSignedMessageCheck() : pResult(NULL) {}
+    CSignedMessageCheck(const uint256& hashMessageIn, const std::vector<unsigned char>& vchSigIn, CSignedMessageResult* pResultIn) :
+        hashMessage(hashMessageIn), vchSig(vchSigIn), pResult(pResultIn) {}
+
+    /// Always succeeds, an invalid signature is reported through the result slot
+    bool operator()();
+
+    void swap(CSignedMessageCheck& check)
+    {
+        std::swap(hashMessage, check.hashMessage);
+        vchSig.swap(check.vchSig);
+        std::swap(pResult, check.pResult);
+    }
+};
+
+/** Worker thread for PrefetchMessageSignatures, started together with the script check threads */
+void ThreadSignedMessageCheck();
+
+/**
+ * Recover the signers of all signed eternitynode messages (mnb, mnp, mnw, txlvote)
+ * waiting in pfrom's receive queue in parallel, skipping signatures which are in the
+ * message signature cache already or whose signer isn't known. Message handlers still verify
+ * every signature through CSpySendSigner::VerifyMessage, which picks up the results.
+ * requires LOCK(pfrom->cs_vRecvMsg)
+ */
+void PrefetchMessageSignatures(CNode* pfrom);
+
+/** Drop signers recovered for a processed message which its handler didn't ask for (see CNetMessage::vSigPrefetchKeys) */
+void ForgetPrefetchedSigners(const std::vector<uint256>& vKeys);
+
+/** Take the signer recovered for (hashMessage, vchSig) by PrefetchMessageSignatures, if any */
+bool GetPrefetchedSigner(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, CSignedMessageResult& resultRet);
+
+/**
+ * Cache of message signatures which were verified successfully, keyed by
+ * (message hash, pubkey, signature), see CSpySendSigner::VerifyMessage.
+ * Its size is limited by -msgsigcachesize.
+ */
+bool GetMessageSigCache(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey);
+void SetMessageSigCache(const uint256& hashMessage, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey);
+
+#endif
@@ -6,6 +6,7 @@
 #include "coincontrol.h"
 #include "consensus/validation.h"
 #include "spysend.h"
+#include "spysend-sigcheck.h"
 #include "governance.h"
 #include "init.h"
 #include "instantx.h"
@@ -152,8 +153,9 @@ void CSpysendPool::ProcessMessage(CNode* pfrom, std::string& strCommand, CDataSt
                 return;
             }
             mnodeman.nDsqCount++;
-            pmn->nLastDsq = mnodeman.nDsqCount;
-            pmn->fAllowMixingTx = true;
+            pmn->SetLastDsq(mnodeman.nDsqCount);
+            pmn->SetAllowMixingTx(true);
+            mnodeman.SetListPublishPending();
 
             LogPrint("spysend", "DSQUEUE -- new SpySend queue (%s) from eternitynode %s\n", dsq.ToString(), pmn->addr.ToString());
             if(pSubmittedToEternitynode && pSubmittedToEternitynode->vin.prevout == dsq.vin.prevout) {
@@ -2285,34 +2287,47 @@ bool CSpySendSigner::GetKeysFromSecret(std::string strSecret, CKey& keyRet, CPub
     return true;
 }
 
-bool CSpySendSigner::SignMessage(std::string strMessage, std::vector<unsigned char>& vchSigRet, CKey key)
+uint256 CSpySendSigner::GetMessageHash(const std::string& strMessage)
 {
     CHashWriter ss(SER_GETHASH, 0);
     ss << strMessageMagic;
     ss << strMessage;
+    return ss.GetHash();
+}
 
-    return key.SignCompact(ss.GetHash(), vchSigRet);
+bool CSpySendSigner::SignMessage(std::string strMessage, std::vector<unsigned char>& vchSigRet, CKey key)
+{
+    return key.SignCompact(GetMessageHash(strMessage), vchSigRet);
 }
 
 bool CSpySendSigner::VerifyMessage(CPubKey pubkey, const std::vector<unsigned char>& vchSig, std::string strMessage, std::string& strErrorRet)
 {
-    CHashWriter ss(SER_GETHASH, 0);
-    ss << strMessageMagic;
-    ss << strMessage;
+    uint256 hashMessage = GetMessageHash(strMessage);
+
+    // verified before, e.g. relayed by another peer
+    if(GetMessageSigCache(hashMessage, vchSig, pubkey)) return true;
+
+    // the signer could be recovered in parallel already, see PrefetchMessageSignatures
+    CSignedMessageResult result;
+    if(!GetPrefetchedSigner(hashMessage, vchSig, result)) {
+        CSignedMessageCheck check(hashMessage, vchSig, &result);
+        check();
+    }
 
-    CPubKey pubkeyFromSig;
-    if(!pubkeyFromSig.RecoverCompact(ss.GetHash(), vchSig)) {
+    if(!result.fValid) {
         strErrorRet = "Error recovering public key.";
         return false;
     }
 
-    if(pubkeyFromSig.GetID() != pubkey.GetID()) {
+    if(result.keyID != pubkey.GetID()) {
         strErrorRet = strprintf("Keys don't match: pubkey=%s, pubkeyFromSig=%s, strMessage=%s, vchSig=%s",
-                    pubkey.GetID().ToString(), pubkeyFromSig.GetID().ToString(), strMessage,
+                    pubkey.GetID().ToString(), result.keyID.ToString(), strMessage,
                     EncodeBase64(&vchSig[0], vchSig.size()));
         return false;
     }
 
+    SetMessageSigCache(hashMessage, vchSig, pubkey);
+
     return true;
 }
 
@@ -2482,6 +2497,9 @@ void ThreadCheckSpySendPool()
         // try to sync from all available nodes, one step at a time
         eternitynodeSync.ProcessTick();
 
+        // eternitynodes changed by queue and mixing messages since the last tick
+        mnodeman.PublishPendingEternitynodeList();
+
         if(eternitynodeSync.IsBlockchainSynced() && !ShutdownRequested()) {
 
             nTick++;
@@ -245,6 +245,8 @@ public:
     bool GetKeysFromSecret(std::string strSecret, CKey& keyRet, CPubKey& pubkeyRet);
     /// Sign the message, returns true if successful
     bool SignMessage(std::string strMessage, std::vector<unsigned char>& vchSigRet, CKey key);
+    /// Hash of the message as it is signed by SignMessage
+    uint256 GetMessageHash(const std::string& strMessage);
     /// Verify the message, returns true if succcessful
     bool VerifyMessage(CPubKey pubkey, const std::vector<unsigned char>& vchSig, std::string strMessage, std::string& strErrorRet);
 };
@@ -347,4 +347,46 @@ BOOST_AUTO_TEST_CASE(updatecoins_simulation_test)
     BOOST_CHECK(spent_a_duplicate_coinbase);
 }
 
+
+BOOST_AUTO_TEST_CASE(unspent_output_height_test)
+{
+    CCoinsViewTest base;
+    CCoinsViewCacheTest cache1(&base);
+    uint256 txid = GetRandHash();
+
+    {
+        CCoinsModifier coins = cache1.ModifyCoins(txid);
+        coins->nHeight = 100;
+        coins->vout.resize(3);
+        coins->vout[0].nValue = 1 * COIN;
+        coins->vout[2].nValue = 2 * COIN;
+    }
+    // the height is found both in the cache itself and through its backing view
+    CCoinsViewCacheTest cache2(&cache1);
+    CCoinsViewCacheTest* caches[] = { &cache1, &cache2 };
+    for (unsigned int i = 0; i < 2; i++) {
+        int nHeight = -1;
+        BOOST_CHECK(caches[i]->GetUnspentOutputHeight(COutPoint(txid, 0), nHeight));
+        BOOST_CHECK_EQUAL(nHeight, 100);
+        nHeight = -1;
+        BOOST_CHECK(caches[i]->GetUnspentOutputHeight(COutPoint(txid, 2), nHeight));
+        BOOST_CHECK_EQUAL(nHeight, 100);
+        // null output, index past the end and unknown tx, nHeight is left alone
+        BOOST_CHECK(!caches[i]->GetUnspentOutputHeight(COutPoint(txid, 1), nHeight));
+        BOOST_CHECK(!caches[i]->GetUnspentOutputHeight(COutPoint(txid, 3), nHeight));
+        BOOST_CHECK(!caches[i]->GetUnspentOutputHeight(COutPoint(GetRandHash(), 0), nHeight));
+        BOOST_CHECK_EQUAL(nHeight, 100);
+    }
+
+    // spent outputs are not found anymore, the rest of the tx still is
+    cache2.ModifyCoins(txid)->Spend(0);
+    int nHeight = -1;
+    BOOST_CHECK(!cache2.GetUnspentOutputHeight(COutPoint(txid, 0), nHeight));
+    BOOST_CHECK(cache2.GetUnspentOutputHeight(COutPoint(txid, 2), nHeight));
+    BOOST_CHECK_EQUAL(nHeight, 100);
+    cache2.ModifyCoins(txid)->Spend(2);
+    BOOST_CHECK(!cache2.GetUnspentOutputHeight(COutPoint(txid, 2), nHeight));
+    cache2.SelfTest();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,9 @@
 #include "crypto/sha512.h"
 #include "crypto/hmac_sha256.h"
 #include "crypto/hmac_sha512.h"
+#include "crypto/sph_echo.h"
+#include "crypto/sph_shavite.h"
+#include "crypto/x11.h"
 #include "random.h"
 #include "utilstrencodings.h"
 #include "test/test_eternity.h"
@@ -248,4 +251,28 @@ BOOST_AUTO_TEST_CASE(hmac_sha512_testvectors) {
                    "b6022cac3c4982b10d5eeb55c3e4de15134676fb6de0446065c97440fa8c6a58");
 }
 
+BOOST_AUTO_TEST_CASE(x11_autodetect_matches_reference) {
+    // BasicTestingSetup already selected the fastest implementation, compare it to sph
+    for (int i = 0; i < 1000; i++) {
+        unsigned char in[64];
+        unsigned char out[64], outRef[64];
+        for (int j = 0; j < 64; j++)
+            in[j] = insecure_rand();
+
+        sph_shavite512_context ctx_shavite;
+        sph_shavite512_init(&ctx_shavite);
+        sph_shavite512(&ctx_shavite, in, 64);
+        sph_shavite512_close(&ctx_shavite, outRef);
+        X11Shavite512_64(in, out);
+        BOOST_CHECK(memcmp(out, outRef, 64) == 0);
+
+        sph_echo512_context ctx_echo;
+        sph_echo512_init(&ctx_echo);
+        sph_echo512(&ctx_echo, in, 64);
+        sph_echo512_close(&ctx_echo, outRef);
+        X11Echo512_64(in, out);
+        BOOST_CHECK(memcmp(out, outRef, 64) == 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+namespace alert_tests{
+static unsigned const char alertTests[] = {
+0x41, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x51, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x59, 0x3e, 0x0f, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 
+0x74, 0x07, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 
+0x31, 0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0xfb, 0x1b, 0x1f, 0x66, 0x42, 0xa8, 0xd7, 0xc8, 
+0x0c, 0x2d, 0xec, 0xdc, 0x9e, 0x7d, 0x4e, 0x61, 
+0x2d, 0xec, 0xaa, 0x92, 0xf9, 0xa3, 0xa3, 0xf5, 
+0x96, 0xec, 0x27, 0x6a, 0x12, 0x32, 0x4b, 0x92, 
+0x02, 0x20, 0x42, 0x44, 0x3a, 0x4b, 0x5c, 0x02, 
+0xb5, 0x82, 0xf6, 0x15, 0xf2, 0xc0, 0x75, 0xc9, 
+0xa3, 0xca, 0xdb, 0x5c, 0x32, 0x69, 0x81, 0xc2, 
+0x1b, 0x54, 0xf6, 0x35, 0x65, 0x71, 0xe8, 0x77, 
+0x90, 0xf2, 0x63, 0x01, 0x00, 0x00, 0x00, 0x3c, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 
+0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x59, 0x3e, 0x0f, 0x00, 
+0x01, 0x0f, 0x2f, 0x53, 0x61, 0x74, 0x6f, 0x73, 
+0x68, 0x69, 0x3a, 0x30, 0x2e, 0x31, 0x2e, 0x30, 
+0x2f, 0x01, 0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 
+0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 
+0x65, 0x6e, 0x74, 0x19, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x31, 0x20, 0x66, 0x6f, 0x72, 0x20, 
+0x53, 0x61, 0x74, 0x6f, 0x73, 0x68, 0x69, 0x20, 
+0x30, 0x2e, 0x31, 0x2e, 0x30, 0x00, 0x46, 0x30, 
+0x44, 0x02, 0x20, 0x77, 0xf3, 0x34, 0x31, 0x3c, 
+0xf5, 0x25, 0x6b, 0x35, 0x98, 0xb0, 0x4c, 0xe0, 
+0x12, 0x48, 0x15, 0x8c, 0xc3, 0x8a, 0x19, 0xc1, 
+0x8c, 0x99, 0x4b, 0xc7, 0x64, 0x44, 0x97, 0x9b, 
+0xda, 0xac, 0x9a, 0x02, 0x20, 0x01, 0x44, 0x00, 
+0x2a, 0x5e, 0xab, 0x00, 0x29, 0x2e, 0xcc, 0xda, 
+0xb3, 0xda, 0x20, 0xef, 0x9c, 0x1c, 0x99, 0xfd, 
+0x52, 0x50, 0x6b, 0x0a, 0x6a, 0xbd, 0x05, 0xfe, 
+0xf7, 0xfb, 0x07, 0xd4, 0x2b, 0x7a, 0x01, 0x00, 
+0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x80, 0x51, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 
+0x3e, 0x0f, 0x00, 0x02, 0x0f, 0x2f, 0x53, 0x61, 
+0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 0x2e, 
+0x31, 0x2e, 0x30, 0x2f, 0x0f, 0x2f, 0x53, 0x61, 
+0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 0x2e, 
+0x32, 0x2e, 0x30, 0x2f, 0x01, 0x00, 0x00, 0x00, 
+0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x63, 
+0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x41, 
+0x6c, 0x65, 0x72, 0x74, 0x20, 0x31, 0x20, 0x66, 
+0x6f, 0x72, 0x20, 0x53, 0x61, 0x74, 0x6f, 0x73, 
+0x68, 0x69, 0x20, 0x30, 0x2e, 0x31, 0x2e, 0x30, 
+0x2c, 0x20, 0x30, 0x2e, 0x32, 0x2e, 0x30, 0x00, 
+0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 0xbc, 0xa4, 
+0x39, 0x0a, 0x29, 0xbb, 0x35, 0x58, 0x37, 0x79, 
+0xc4, 0xc2, 0x5b, 0x65, 0x3d, 0xb1, 0x3a, 0x63, 
+0xea, 0xbd, 0xfe, 0x27, 0xf4, 0x55, 0x02, 0x8e, 
+0x7c, 0x06, 0x36, 0xe4, 0x5d, 0x95, 0x02, 0x20, 
+0x67, 0xa2, 0xbc, 0xc1, 0x4c, 0x25, 0x1b, 0xa2, 
+0x48, 0xfb, 0x4e, 0x4e, 0xed, 0xed, 0xf5, 0x56, 
+0xaa, 0x72, 0xbb, 0x18, 0x61, 0xe4, 0x80, 0xd1, 
+0xaa, 0x88, 0x9d, 0xf4, 0x10, 0xe8, 0xc9, 0xb4, 
+0x4c, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x51, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x59, 0x3e, 0x0f, 0x00, 0x00, 0x64, 
+0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 
+0x74, 0x12, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 
+0x32, 0x2c, 0x20, 0x63, 0x61, 0x6e, 0x63, 0x65, 
+0x6c, 0x73, 0x20, 0x31, 0x00, 0x47, 0x30, 0x45, 
+0x02, 0x21, 0x00, 0xe8, 0x1a, 0x6e, 0x52, 0xdb, 
+0x50, 0xf4, 0x5e, 0x2e, 0xef, 0xfb, 0x3d, 0xcd, 
+0xd3, 0x68, 0x13, 0xbd, 0x02, 0x79, 0xb4, 0x44, 
+0xdc, 0xf5, 0xea, 0xf3, 0x91, 0xea, 0x30, 0xf5, 
+0x58, 0x53, 0x17, 0x02, 0x20, 0x23, 0xec, 0xd4, 
+0x71, 0x46, 0x7a, 0x03, 0x2c, 0xf4, 0x22, 0x46, 
+0x45, 0xeb, 0x2a, 0xab, 0x00, 0xc1, 0xfe, 0xe9, 
+0xce, 0x88, 0x9a, 0xe6, 0x11, 0x14, 0x08, 0x86, 
+0xe0, 0x6f, 0x5e, 0x12, 0x07, 0x4c, 0x01, 0x00, 
+0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0xbc, 0x51, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 
+0x3e, 0x0f, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 
+0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x63, 
+0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x12, 0x41, 
+0x6c, 0x65, 0x72, 0x74, 0x20, 0x32, 0x2c, 0x20, 
+0x63, 0x61, 0x6e, 0x63, 0x65, 0x6c, 0x73, 0x20, 
+0x31, 0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0x8c, 0x5b, 0x4c, 0x31, 0xc3, 0x70, 0xfc, 0xf8, 
+0x9f, 0x8c, 0x04, 0x77, 0x86, 0xeb, 0x19, 0xda, 
+0xca, 0x78, 0xbf, 0x49, 0x37, 0xad, 0x45, 0xf0, 
+0x53, 0xf5, 0xf6, 0x28, 0x67, 0xc3, 0x45, 0x48, 
+0x02, 0x20, 0x41, 0xed, 0xa6, 0xf7, 0x56, 0x6a, 
+0x9b, 0xdc, 0x73, 0x8b, 0xf5, 0x5b, 0xc5, 0xb2, 
+0x8c, 0xc4, 0xdd, 0x56, 0xb8, 0x20, 0x1d, 0x15, 
+0xeb, 0x06, 0x32, 0x03, 0xae, 0x8b, 0xce, 0xbc, 
+0xd2, 0x15, 0x4c, 0x01, 0x00, 0x00, 0x00, 0x3c, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbc, 
+0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x0b, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 
+0x00, 0x64, 0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 
+0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 
+0x65, 0x6e, 0x74, 0x12, 0x41, 0x6c, 0x65, 0x72, 
+0x74, 0x20, 0x32, 0x2c, 0x20, 0x63, 0x61, 0x6e, 
+0x63, 0x65, 0x6c, 0x73, 0x20, 0x31, 0x00, 0x46, 
+0x30, 0x44, 0x02, 0x20, 0x1c, 0xc7, 0xa6, 0xdd, 
+0x7a, 0xe6, 0x28, 0x57, 0xfe, 0xc7, 0x22, 0x96, 
+0x5c, 0x83, 0xf8, 0xa7, 0x86, 0x0d, 0x20, 0x03, 
+0x0f, 0xc1, 0x8c, 0x14, 0x71, 0xe7, 0x1d, 0x09, 
+0x69, 0x53, 0x00, 0x39, 0x02, 0x20, 0x05, 0xa1, 
+0xa8, 0x5b, 0x90, 0x4c, 0x7d, 0x3f, 0x0f, 0x89, 
+0x1e, 0x8d, 0x35, 0x84, 0xc4, 0x86, 0x4f, 0x9d, 
+0x84, 0x8e, 0x61, 0x39, 0x2a, 0x2f, 0x61, 0xaf, 
+0x54, 0x76, 0x7b, 0x56, 0x2d, 0x49, 0x63, 0x01, 
+0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0xbc, 0x51, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 
+0x16, 0x00, 0x00, 0x00, 0x01, 0x0f, 0x2f, 0x53, 
+0x61, 0x74, 0x6f, 0x73, 0x68, 0x69, 0x3a, 0x30, 
+0x2e, 0x31, 0x2e, 0x30, 0x2f, 0x64, 0x00, 0x00, 
+0x00, 0x0d, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 
+0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x19, 
+0x41, 0x6c, 0x65, 0x72, 0x74, 0x20, 0x32, 0x20, 
+0x66, 0x6f, 0x72, 0x20, 0x53, 0x61, 0x74, 0x6f, 
+0x73, 0x68, 0x69, 0x20, 0x30, 0x2e, 0x31, 0x2e, 
+0x30, 0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 
+0xd0, 0xf0, 0xf3, 0x58, 0x43, 0x0e, 0x56, 0x1b, 
+0xa5, 0x91, 0xce, 0x8c, 0x31, 0x09, 0xd3, 0x32, 
+0xdf, 0x56, 0xa7, 0x13, 0x38, 0xed, 0x57, 0xa4, 
+0x88, 0x5d, 0x59, 0xbf, 0xeb, 0x2d, 0x0b, 0x30, 
+0x02, 0x20, 0x36, 0x95, 0xed, 0xb9, 0x70, 0xea, 
+0x67, 0x86, 0xcc, 0x60, 0xb2, 0x95, 0xe9, 0xf5, 
+0x85, 0x22, 0xee, 0x39, 0xbf, 0xc7, 0x8a, 0xc5, 
+0x41, 0x65, 0xd7, 0x8e, 0x30, 0x6a, 0xd8, 0xfd, 
+0xdf, 0xd2, 0x56, 0x01, 0x00, 0x00, 0x00, 0x3c, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbc, 
+0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x3f, 0x42, 0x0f, 0x00, 
+0x00, 0x64, 0x00, 0x00, 0x00, 0x0d, 0x41, 0x6c, 
+0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 
+0x65, 0x6e, 0x74, 0x1c, 0x45, 0x76, 0x69, 0x6c, 
+0x20, 0x41, 0x6c, 0x65, 0x72, 0x74, 0x27, 0x3b, 
+0x20, 0x2f, 0x62, 0x69, 0x6e, 0x2f, 0x6c, 0x73, 
+0x3b, 0x20, 0x65, 0x63, 0x68, 0x6f, 0x20, 0x27, 
+0x00, 0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 0xcc, 
+0xc6, 0xd8, 0x81, 0x74, 0x88, 0x20, 0xb9, 0xdb, 
+0x0f, 0x89, 0x50, 0x9a, 0x8f, 0xb3, 0xa0, 0xaa, 
+0xb4, 0x54, 0x70, 0xdf, 0x86, 0x85, 0xa8, 0x75, 
+0x21, 0x93, 0xaa, 0xf2, 0xf0, 0xba, 0x82, 0x02, 
+0x20, 0x28, 0xde, 0xea, 0x3c, 0x9f, 0xd7, 0xc0, 
+0x2c, 0xe4, 0xf0, 0xfe, 0x1d, 0x39, 0xe2, 0x3c, 
+0xa7, 0x67, 0x43, 0x47, 0xf5, 0xc9, 0xf3, 0x48, 
+0xb9, 0x1d, 0x87, 0x49, 0x1e, 0x76, 0x63, 0x41, 
+0x9c, 
+};};
@@ -0,0 +1,500 @@
+namespace json_tests{
+static unsigned const char base58_keys_invalid[] = {
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x78, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x34, 0x31, 0x69, 0x4c, 
+0x74, 0x66, 0x66, 0x57, 0x65, 0x42, 0x4c, 0x6e, 
+0x76, 0x41, 0x35, 0x45, 0x52, 0x43, 0x63, 0x5a, 
+0x77, 0x36, 0x47, 0x65, 0x50, 0x75, 0x61, 0x67, 
+0x45, 0x32, 0x39, 0x76, 0x57, 0x33, 0x5a, 0x65, 
+0x78, 0x64, 0x6a, 0x31, 0x4a, 0x79, 0x42, 0x7a, 
+0x33, 0x6b, 0x4b, 0x44, 0x61, 0x53, 0x47, 0x52, 
+0x68, 0x66, 0x67, 0x64, 0x73, 0x42, 0x31, 0x71, 
+0x36, 0x51, 0x41, 0x46, 0x46, 0x48, 0x61, 0x34, 
+0x6b, 0x75, 0x69, 0x65, 0x4d, 0x68, 0x68, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x50, 0x4e, 0x69, 0x52, 0x6b, 0x72, 0x56, 0x71, 
+0x62, 0x70, 0x31, 0x74, 0x6e, 0x56, 0x6a, 0x4a, 
+0x51, 0x56, 0x78, 0x4a, 0x35, 0x35, 0x78, 0x63, 
+0x4e, 0x5a, 0x5a, 0x65, 0x4d, 0x57, 0x6e, 0x66, 
+0x6f, 0x54, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x32, 0x55, 0x68, 0x72, 0x72, 
+0x41, 0x4d, 0x74, 0x4b, 0x52, 0x72, 0x32, 0x55, 
+0x79, 0x65, 0x79, 0x4e, 0x70, 0x37, 0x66, 0x47, 
+0x31, 0x6e, 0x6a, 0x71, 0x4e, 0x74, 0x46, 0x50, 
+0x77, 0x73, 0x50, 0x76, 0x4c, 0x76, 0x77, 0x64, 
+0x42, 0x54, 0x46, 0x52, 0x66, 0x73, 0x78, 0x4e, 
+0x55, 0x50, 0x6b, 0x6e, 0x54, 0x31, 0x66, 0x77, 
+0x53, 0x39, 0x78, 0x51, 0x79, 0x69, 0x78, 0x68, 
+0x74, 0x38, 0x31, 0x52, 0x53, 0x69, 0x63, 0x39, 
+0x38, 0x6a, 0x57, 0x52, 0x4d, 0x77, 0x76, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x33, 0x57, 0x6f, 0x78, 0x31, 0x39, 0x33, 0x62, 
+0x76, 0x4e, 0x41, 0x38, 0x41, 0x5a, 0x53, 0x4d, 
+0x41, 0x37, 0x45, 0x4b, 0x5a, 0x32, 0x7a, 0x33, 
+0x58, 0x31, 0x6e, 0x5a, 0x5a, 0x39, 0x75, 0x79, 
+0x75, 0x78, 0x6e, 0x36, 0x5a, 0x52, 0x4b, 0x5a, 
+0x69, 0x35, 0x7a, 0x50, 0x5a, 0x6d, 0x71, 0x63, 
+0x76, 0x68, 0x46, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x63, 0x51, 0x63, 0x47, 
+0x56, 0x4a, 0x63, 0x53, 0x78, 0x44, 0x6f, 0x43, 
+0x6e, 0x70, 0x68, 0x4a, 0x43, 0x42, 0x6f, 0x47, 
+0x4a, 0x71, 0x43, 0x4c, 0x70, 0x58, 0x56, 0x52, 
+0x65, 0x4a, 0x74, 0x6d, 0x32, 0x6f, 0x75, 0x45, 
+0x77, 0x42, 0x51, 0x34, 0x62, 0x4a, 0x6f, 0x66, 
+0x44, 0x61, 0x4b, 0x38, 0x78, 0x57, 0x64, 0x44, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x6d, 0x66, 0x47, 0x35, 0x79, 0x78, 0x6e, 
+0x75, 0x36, 0x50, 0x44, 0x78, 0x65, 0x35, 0x67, 
+0x58, 0x62, 0x58, 0x57, 0x37, 0x53, 0x7a, 0x6f, 
+0x34, 0x56, 0x78, 0x67, 0x37, 0x54, 0x73, 0x6a, 
+0x37, 0x47, 0x4b, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x65, 0x63, 0x35, 0x6e, 
+0x39, 0x57, 0x4d, 0x57, 0x4b, 0x4c, 0x62, 0x57, 
+0x4b, 0x44, 0x45, 0x41, 0x77, 0x53, 0x37, 0x52, 
+0x68, 0x79, 0x63, 0x55, 0x4c, 0x34, 0x61, 0x51, 
+0x43, 0x66, 0x75, 0x39, 0x45, 0x63, 0x5a, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x64, 0x44, 0x77, 0x52, 0x65, 0x55, 0x37, 0x6a, 
+0x55, 0x45, 0x39, 0x62, 0x38, 0x5a, 0x77, 0x57, 
+0x33, 0x4a, 0x67, 0x53, 0x39, 0x6f, 0x43, 0x4e, 
+0x50, 0x72, 0x32, 0x6e, 0x70, 0x32, 0x74, 0x4b, 
+0x58, 0x75, 0x47, 0x42, 0x63, 0x6f, 0x74, 0x37, 
+0x79, 0x35, 0x47, 0x79, 0x38, 0x69, 0x32, 0x6e, 
+0x37, 0x75, 0x64, 0x75, 0x6e, 0x76, 0x39, 0x74, 
+0x72, 0x44, 0x78, 0x4e, 0x7a, 0x45, 0x4d, 0x59, 
+0x53, 0x4d, 0x73, 0x4e, 0x6d, 0x45, 0x31, 0x48, 
+0x4b, 0x46, 0x4d, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x47, 0x35, 0x33, 0x53, 
+0x75, 0x6f, 0x64, 0x71, 0x4a, 0x6e, 0x4a, 0x33, 
+0x58, 0x31, 0x66, 0x6f, 0x45, 0x71, 0x47, 0x70, 
+0x79, 0x52, 0x76, 0x4d, 0x58, 0x72, 0x47, 0x63, 
+0x48, 0x41, 0x48, 0x31, 0x48, 0x55, 0x51, 0x41, 
+0x68, 0x6d, 0x7a, 0x47, 0x67, 0x54, 0x6e, 0x63, 
+0x6e, 0x36, 0x76, 0x34, 0x37, 0x4b, 0x76, 0x70, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x37, 0x55, 0x62, 0x46, 0x53, 0x6e, 0x47, 
+0x71, 0x6b, 0x4a, 0x47, 0x6a, 0x5a, 0x37, 0x62, 
+0x67, 0x6d, 0x4a, 0x42, 0x53, 0x41, 0x47, 0x64, 
+0x37, 0x51, 0x52, 0x43, 0x32, 0x33, 0x44, 0x33, 
+0x43, 0x71, 0x44, 0x31, 0x64, 0x53, 0x42, 0x36, 
+0x61, 0x74, 0x4d, 0x36, 0x55, 0x75, 0x50, 0x75, 
+0x62, 0x41, 0x68, 0x55, 0x43, 0x5a, 0x4a, 0x43, 
+0x6b, 0x59, 0x36, 0x68, 0x31, 0x66, 0x77, 0x41, 
+0x34, 0x68, 0x6a, 0x47, 0x42, 0x57, 0x4c, 0x73, 
+0x4e, 0x5a, 0x36, 0x58, 0x75, 0x44, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x33, 
+0x76, 0x6d, 0x72, 0x45, 0x39, 0x62, 0x43, 0x6d, 
+0x35, 0x4b, 0x6f, 0x37, 0x70, 0x55, 0x6d, 0x72, 
+0x39, 0x54, 0x63, 0x6e, 0x64, 0x39, 0x31, 0x38, 
+0x68, 0x74, 0x6d, 0x39, 0x76, 0x74, 0x34, 0x78, 
+0x63, 0x7a, 0x44, 0x61, 0x47, 0x43, 0x4e, 0x65, 
+0x34, 0x77, 0x54, 0x33, 0x4d, 0x4a, 0x37, 0x7a, 
+0x5a, 0x6e, 0x33, 0x64, 0x57, 0x75, 0x32, 0x34, 
+0x6f, 0x42, 0x65, 0x4d, 0x67, 0x45, 0x79, 0x76, 
+0x71, 0x63, 0x76, 0x4b, 0x6e, 0x47, 0x73, 0x42, 
+0x6a, 0x52, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x65, 0x63, 0x59, 0x4d, 0x44, 
+0x37, 0x55, 0x70, 0x4b, 0x6a, 0x4b, 0x41, 0x54, 
+0x6d, 0x4a, 0x47, 0x74, 0x4d, 0x66, 0x73, 0x53, 
+0x69, 0x63, 0x4d, 0x53, 0x32, 0x55, 0x6b, 0x52, 
+0x58, 0x6f, 0x39, 0x45, 0x39, 0x70, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x39, 
+0x31, 0x63, 0x57, 0x74, 0x57, 0x73, 0x70, 0x37, 
+0x78, 0x47, 0x72, 0x6a, 0x39, 0x43, 0x66, 0x68, 
+0x4e, 0x65, 0x78, 0x71, 0x46, 0x46, 0x77, 0x6e, 
+0x77, 0x57, 0x48, 0x31, 0x47, 0x61, 0x55, 0x38, 
+0x53, 0x50, 0x77, 0x4c, 0x53, 0x4c, 0x70, 0x64, 
+0x65, 0x34, 0x64, 0x76, 0x47, 0x74, 0x53, 0x6b, 
+0x51, 0x51, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x58, 0x69, 0x76, 0x39, 0x43, 
+0x54, 0x56, 0x53, 0x6a, 0x39, 0x76, 0x77, 0x59, 
+0x70, 0x50, 0x47, 0x6a, 0x71, 0x5a, 0x32, 0x46, 
+0x4a, 0x77, 0x45, 0x79, 0x54, 0x31, 0x36, 0x54, 
+0x73, 0x57, 0x4e, 0x42, 0x58, 0x6d, 0x47, 0x71, 
+0x57, 0x67, 0x34, 0x42, 0x7a, 0x38, 0x36, 0x45, 
+0x63, 0x51, 0x4a, 0x78, 0x45, 0x63, 0x70, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x61, 0x45, 0x39, 0x54, 0x65, 0x68, 0x62, 0x6d, 
+0x4e, 0x44, 0x6d, 0x68, 0x7a, 0x4c, 0x4d, 0x65, 
+0x6a, 0x76, 0x59, 0x5a, 0x38, 0x62, 0x43, 0x73, 
+0x56, 0x38, 0x53, 0x6d, 0x31, 0x5a, 0x31, 0x4b, 
+0x51, 0x65, 0x7a, 0x68, 0x77, 0x50, 0x79, 0x32, 
+0x65, 0x4c, 0x56, 0x4e, 0x35, 0x35, 0x72, 0x54, 
+0x69, 0x79, 0x43, 0x4b, 0x53, 0x39, 0x54, 0x52, 
+0x44, 0x76, 0x75, 0x39, 0x55, 0x54, 0x71, 0x67, 
+0x31, 0x51, 0x43, 0x6d, 0x4c, 0x48, 0x64, 0x33, 
+0x61, 0x42, 0x58, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x67, 0x4a, 0x41, 0x37, 
+0x44, 0x50, 0x64, 0x71, 0x61, 0x42, 0x7a, 0x71, 
+0x4d, 0x56, 0x47, 0x56, 0x4c, 0x7a, 0x62, 0x67, 
+0x56, 0x74, 0x64, 0x54, 0x62, 0x73, 0x32, 0x73, 
+0x51, 0x77, 0x45, 0x6d, 0x4b, 0x70, 0x64, 0x50, 
+0x51, 0x6f, 0x55, 0x39, 0x46, 0x57, 0x64, 0x35, 
+0x69, 0x37, 0x50, 0x65, 0x57, 0x37, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x48, 
+0x42, 0x75, 0x63, 0x55, 0x4b, 0x31, 0x4c, 0x34, 
+0x4c, 0x79, 0x79, 0x48, 0x6a, 0x44, 0x36, 0x54, 
+0x72, 0x75, 0x33, 0x36, 0x36, 0x51, 0x5a, 0x47, 
+0x52, 0x44, 0x59, 0x69, 0x59, 0x34, 0x55, 0x34, 
+0x61, 0x34, 0x51, 0x58, 0x4d, 0x66, 0x6f, 0x54, 
+0x38, 0x78, 0x41, 0x51, 0x6b, 0x6f, 0x53, 0x47, 
+0x52, 0x38, 0x36, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x32, 0x39, 0x72, 0x66, 
+0x75, 0x4a, 0x72, 0x38, 0x66, 0x4b, 0x73, 0x58, 
+0x72, 0x76, 0x77, 0x67, 0x43, 0x78, 0x4a, 0x54, 
+0x37, 0x43, 0x71, 0x78, 0x6a, 0x42, 0x55, 0x5a, 
+0x72, 0x61, 0x50, 0x68, 0x41, 0x46, 0x31, 0x31, 
+0x6b, 0x31, 0x36, 0x37, 0x50, 0x74, 0x6a, 0x64, 
+0x32, 0x6a, 0x6f, 0x51, 0x64, 0x44, 0x51, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x48, 0x41, 0x7a, 0x69, 0x77, 0x37, 0x33, 
+0x64, 0x4d, 0x35, 0x75, 0x36, 0x6a, 0x58, 0x54, 
+0x41, 0x5a, 0x65, 0x4a, 0x52, 0x39, 0x58, 0x6d, 
+0x74, 0x39, 0x6e, 0x64, 0x71, 0x71, 0x47, 0x58, 
+0x58, 0x67, 0x45, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x65, 0x55, 0x47, 0x36, 
+0x56, 0x52, 0x75, 0x6a, 0x46, 0x56, 0x69, 0x76, 
+0x63, 0x6a, 0x73, 0x58, 0x42, 0x46, 0x79, 0x71, 
+0x6f, 0x72, 0x47, 0x4c, 0x75, 0x50, 0x62, 0x68, 
+0x39, 0x34, 0x79, 0x74, 0x48, 0x59, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 
+0x46, 0x54, 0x54, 0x4e, 0x6e, 0x61, 0x5a, 0x31, 
+0x4d, 0x4d, 0x75, 0x59, 0x41, 0x63, 0x6e, 0x61, 
+0x64, 0x79, 0x36, 0x52, 0x67, 0x57, 0x78, 0x33, 
+0x4d, 0x39, 0x56, 0x41, 0x35, 0x53, 0x6a, 0x63, 
+0x75, 0x79, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x64, 0x47, 0x6b, 0x4d, 0x31, 
+0x37, 0x58, 0x6d, 0x32, 0x46, 0x39, 0x48, 0x79, 
+0x72, 0x48, 0x59, 0x43, 0x56, 0x6b, 0x76, 0x53, 
+0x63, 0x6f, 0x66, 0x4b, 0x56, 0x36, 0x41, 0x38, 
+0x41, 0x37, 0x75, 0x5a, 0x44, 0x67, 0x39, 0x34, 
+0x57, 0x59, 0x59, 0x64, 0x68, 0x79, 0x59, 0x6b, 
+0x44, 0x66, 0x31, 0x54, 0x6f, 0x78, 0x48, 0x70, 
+0x55, 0x56, 0x70, 0x56, 0x70, 0x32, 0x56, 0x73, 
+0x32, 0x52, 0x41, 0x57, 0x61, 0x71, 0x4d, 0x67, 
+0x4c, 0x55, 0x4a, 0x56, 0x6a, 0x43, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x37, 
+0x55, 0x6a, 0x66, 0x73, 0x72, 0x41, 0x6b, 0x36, 
+0x79, 0x76, 0x58, 0x58, 0x79, 0x72, 0x45, 0x71, 
+0x69, 0x37, 0x42, 0x71, 0x57, 0x76, 0x32, 0x57, 
+0x71, 0x63, 0x31, 0x72, 0x32, 0x4a, 0x45, 0x45, 
+0x41, 0x47, 0x7a, 0x4c, 0x57, 0x61, 0x4e, 0x31, 
+0x37, 0x6e, 0x64, 0x68, 0x70, 0x4c, 0x6d, 0x4e, 
+0x48, 0x38, 0x63, 0x51, 0x62, 0x32, 0x70, 0x53, 
+0x53, 0x4d, 0x77, 0x4e, 0x6d, 0x45, 0x67, 0x43, 
+0x6f, 0x41, 0x39, 0x4d, 0x46, 0x52, 0x41, 0x36, 
+0x78, 0x4a, 0x79, 0x59, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x48, 0x4c, 0x7a, 
+0x39, 0x45, 0x4b, 0x5a, 0x6a, 0x41, 0x44, 0x58, 
+0x46, 0x4b, 0x41, 0x43, 0x70, 0x50, 0x53, 0x69, 
+0x53, 0x4c, 0x76, 0x38, 0x6e, 0x69, 0x79, 0x63, 
+0x43, 0x6d, 0x47, 0x41, 0x4c, 0x4b, 0x46, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x32, 0x32, 0x32, 0x69, 0x51, 0x78, 0x68, 0x42, 
+0x6e, 0x67, 0x7a, 0x69, 0x4b, 0x68, 0x79, 0x54, 
+0x52, 0x70, 0x61, 0x6a, 0x63, 0x62, 0x6b, 0x44, 
+0x78, 0x56, 0x58, 0x44, 0x47, 0x74, 0x48, 0x43, 
+0x4d, 0x78, 0x42, 0x66, 0x57, 0x50, 0x52, 0x52, 
+0x5a, 0x62, 0x71, 0x58, 0x4b, 0x36, 0x31, 0x52, 
+0x73, 0x69, 0x62, 0x42, 0x63, 0x7a, 0x59, 0x66, 
+0x58, 0x4a, 0x55, 0x6d, 0x66, 0x6b, 0x39, 0x34, 
+0x68, 0x50, 0x48, 0x55, 0x70, 0x52, 0x56, 0x31, 
+0x39, 0x58, 0x4c, 0x59, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x4d, 0x33, 0x6d, 
+0x65, 0x4d, 0x66, 0x34, 0x71, 0x67, 0x56, 0x38, 
+0x70, 0x36, 0x74, 0x57, 0x71, 0x69, 0x55, 0x66, 
+0x79, 0x33, 0x63, 0x6a, 0x34, 0x4a, 0x61, 0x61, 
+0x51, 0x42, 0x63, 0x5a, 0x4e, 0x4d, 0x38, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x36, 0x4b, 0x4d, 0x36, 0x6b, 0x51, 0x78, 0x55, 
+0x36, 0x61, 0x7a, 0x44, 0x5a, 0x62, 0x77, 0x52, 
+0x58, 0x44, 0x5a, 0x79, 0x63, 0x4d, 0x61, 0x75, 
+0x53, 0x6a, 0x6b, 0x71, 0x79, 0x53, 0x79, 0x32, 
+0x73, 0x68, 0x52, 0x74, 0x57, 0x32, 0x50, 0x47, 
+0x6e, 0x7a, 0x69, 0x72, 0x48, 0x78, 0x76, 0x4d, 
+0x51, 0x63, 0x43, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x47, 0x32, 0x65, 0x62, 
+0x4e, 0x45, 0x73, 0x39, 0x72, 0x6f, 0x70, 0x66, 
+0x48, 0x76, 0x64, 0x46, 0x39, 0x39, 0x43, 0x77, 
+0x7a, 0x50, 0x79, 0x35, 0x6b, 0x54, 0x35, 0x77, 
+0x43, 0x6f, 0x6d, 0x6d, 0x5a, 0x50, 0x4c, 0x6d, 
+0x31, 0x58, 0x37, 0x38, 0x79, 0x45, 0x72, 0x42, 
+0x5a, 0x51, 0x65, 0x76, 0x52, 0x51, 0x72, 0x7a, 
+0x55, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x73, 0x34, 0x63, 0x37, 0x4a, 0x75, 
+0x77, 0x74, 0x66, 0x35, 0x74, 0x45, 0x53, 0x64, 
+0x65, 0x37, 0x63, 0x31, 0x76, 0x4a, 0x33, 0x6a, 
+0x4e, 0x53, 0x69, 0x67, 0x4c, 0x33, 0x32, 0x71, 
+0x43, 0x59, 0x46, 0x36, 0x74, 0x67, 0x51, 0x54, 
+0x4d, 0x38, 0x64, 0x46, 0x72, 0x68, 0x52, 0x32, 
+0x65, 0x46, 0x78, 0x73, 0x71, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x45, 0x52, 
+0x7a, 0x44, 0x41, 0x38, 0x6e, 0x36, 0x48, 0x6f, 
+0x48, 0x65, 0x32, 0x63, 0x61, 0x77, 0x31, 0x70, 
+0x76, 0x75, 0x41, 0x5a, 0x4b, 0x67, 0x6b, 0x62, 
+0x47, 0x66, 0x6e, 0x35, 0x66, 0x48, 0x52, 0x44, 
+0x63, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x32, 0x34, 0x76, 0x63, 0x65, 0x57, 
+0x46, 0x6a, 0x50, 0x53, 0x5a, 0x64, 0x53, 0x38, 
+0x55, 0x54, 0x38, 0x56, 0x36, 0x56, 0x43, 0x79, 
+0x67, 0x4b, 0x73, 0x35, 0x6e, 0x47, 0x54, 0x71, 
+0x54, 0x78, 0x36, 0x66, 0x6d, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x35, 0x42, 
+0x52, 0x63, 0x6d, 0x67, 0x55, 0x64, 0x63, 0x45, 
+0x6f, 0x78, 0x4c, 0x7a, 0x6a, 0x58, 0x4d, 0x36, 
+0x42, 0x55, 0x47, 0x74, 0x51, 0x44, 0x75, 0x34, 
+0x6f, 0x54, 0x63, 0x36, 0x76, 0x52, 0x62, 0x65, 
+0x79, 0x78, 0x35, 0x44, 0x6a, 0x75, 0x66, 0x41, 
+0x71, 0x71, 0x59, 0x63, 0x64, 0x6a, 0x6f, 0x72, 
+0x7a, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x64, 0x42, 0x6a, 0x35, 0x6d, 0x5a, 
+0x4a, 0x70, 0x61, 0x76, 0x6d, 0x79, 0x43, 0x64, 
+0x6d, 0x65, 0x54, 0x70, 0x67, 0x74, 0x6d, 0x50, 
+0x73, 0x4a, 0x37, 0x45, 0x77, 0x52, 0x44, 0x54, 
+0x6e, 0x66, 0x6b, 0x70, 0x36, 0x46, 0x4d, 0x62, 
+0x53, 0x76, 0x66, 0x69, 0x6d, 0x70, 0x51, 0x45, 
+0x70, 0x52, 0x44, 0x7a, 0x33, 0x74, 0x71, 0x73, 
+0x45, 0x58, 0x6b, 0x56, 0x33, 0x77, 0x43, 0x34, 
+0x73, 0x62, 0x59, 0x52, 0x6b, 0x41, 0x71, 0x43, 
+0x70, 0x46, 0x47, 0x6e, 0x51, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 0x55, 
+0x4d, 0x6a, 0x63, 0x63, 0x7a, 0x66, 0x6a, 0x6b, 
+0x45, 0x44, 0x68, 0x48, 0x76, 0x57, 0x58, 0x6a, 
+0x35, 0x69, 0x56, 0x55, 0x6f, 0x6f, 0x51, 0x67, 
+0x74, 0x33, 0x59, 0x41, 0x77, 0x78, 0x48, 0x73, 
+0x56, 0x67, 0x74, 0x36, 0x69, 0x79, 0x59, 0x72, 
+0x65, 0x78, 0x35, 0x70, 0x4d, 0x61, 0x70, 0x33, 
+0x7a, 0x6b, 0x74, 0x39, 0x67, 0x73, 0x44, 0x56, 
+0x38, 0x65, 0x63, 0x4e, 0x58, 0x73, 0x55, 0x53, 
+0x53, 0x48, 0x31, 0x34, 0x72, 0x72, 0x33, 0x48, 
+0x43, 0x4c, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x63, 0x52, 0x77, 0x36, 0x79, 
+0x4b, 0x48, 0x4d, 0x44, 0x33, 0x53, 0x75, 0x73, 
+0x74, 0x73, 0x44, 0x6a, 0x53, 0x39, 0x33, 0x78, 
+0x61, 0x75, 0x6e, 0x45, 0x57, 0x50, 0x39, 0x5a, 
+0x78, 0x78, 0x6b, 0x71, 0x48, 0x77, 0x37, 0x32, 
+0x63, 0x75, 0x79, 0x6b, 0x6f, 0x66, 0x6a, 0x50, 
+0x38, 0x75, 0x57, 0x78, 0x62, 0x4b, 0x68, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x34, 0x39, 0x66, 0x6e, 0x46, 0x4e, 0x44, 0x72, 
+0x76, 0x62, 0x54, 0x33, 0x39, 0x37, 0x65, 0x67, 
+0x36, 0x57, 0x64, 0x68, 0x34, 0x4c, 0x74, 0x56, 
+0x4a, 0x70, 0x4c, 0x56, 0x75, 0x66, 0x75, 0x70, 
+0x43, 0x48, 0x35, 0x58, 0x70, 0x42, 0x50, 0x58, 
+0x6e, 0x46, 0x52, 0x71, 0x43, 0x7a, 0x39, 0x62, 
+0x58, 0x5a, 0x6f, 0x68, 0x52, 0x50, 0x61, 0x74, 
+0x6f, 0x4c, 0x5a, 0x5a, 0x6f, 0x73, 0x41, 0x6a, 
+0x72, 0x35, 0x62, 0x4c, 0x78, 0x77, 0x78, 0x71, 
+0x65, 0x75, 0x31, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x37, 0x55, 0x74, 0x6f, 
+0x38, 0x4e, 0x35, 0x74, 0x36, 0x50, 0x38, 0x6f, 
+0x79, 0x6e, 0x33, 0x71, 0x56, 0x4c, 0x6b, 0x4d, 
+0x50, 0x65, 0x38, 0x45, 0x52, 0x68, 0x6d, 0x38, 
+0x5a, 0x56, 0x55, 0x44, 0x73, 0x4a, 0x4e, 0x59, 
+0x4c, 0x6d, 0x6f, 0x43, 0x67, 0x4e, 0x74, 0x6b, 
+0x31, 0x64, 0x72, 0x43, 0x59, 0x7a, 0x46, 0x55, 
+0x36, 0x47, 0x67, 0x6f, 0x6e, 0x31, 0x6f, 0x64, 
+0x48, 0x71, 0x52, 0x6e, 0x63, 0x39, 0x7a, 0x62, 
+0x42, 0x78, 0x38, 0x6e, 0x62, 0x6d, 0x53, 0x50, 
+0x7a, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x61, 0x47, 0x62, 0x31, 0x43, 0x34, 
+0x47, 0x79, 0x4a, 0x32, 0x41, 0x77, 0x59, 0x46, 
+0x6b, 0x47, 0x53, 0x56, 0x70, 0x35, 0x52, 0x62, 
+0x4b, 0x58, 0x54, 0x45, 0x63, 0x65, 0x58, 0x46, 
+0x65, 0x54, 0x32, 0x4c, 0x6a, 0x34, 0x71, 0x54, 
+0x5a, 0x6b, 0x50, 0x59, 0x6d, 0x79, 0x43, 0x55, 
+0x50, 0x58, 0x5a, 0x43, 0x71, 0x31, 0x53, 0x42, 
+0x33, 0x41, 0x62, 0x66, 0x62, 0x51, 0x64, 0x69, 
+0x6d, 0x33, 0x39, 0x61, 0x39, 0x70, 0x77, 0x71, 
+0x75, 0x38, 0x69, 0x58, 0x4a, 0x22, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x38, 0x35, 
+0x63, 0x41, 0x72, 0x75, 0x46, 0x68, 0x37, 0x7a, 
+0x69, 0x34, 0x58, 0x59, 0x33, 0x75, 0x77, 0x68, 
+0x39, 0x37, 0x50, 0x66, 0x62, 0x73, 0x71, 0x42, 
+0x48, 0x31, 0x75, 0x75, 0x6e, 0x46, 0x6b, 0x43, 
+0x64, 0x4c, 0x4b, 0x6b, 0x34, 0x4d, 0x76, 0x36, 
+0x75, 0x57, 0x70, 0x70, 0x4a, 0x5a, 0x6e, 0x79, 
+0x38, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 
+0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x22, 0x37, 0x56, 0x50, 0x43, 0x76, 0x6e, 
+0x42, 0x51, 0x38, 0x4d, 0x63, 0x79, 0x44, 0x4c, 
+0x61, 0x37, 0x41, 0x56, 0x46, 0x6e, 0x74, 0x45, 
+0x66, 0x63, 0x6d, 0x31, 0x78, 0x39, 0x46, 0x47, 
+0x36, 0x61, 0x4d, 0x46, 0x6d, 0x4e, 0x6b, 0x36, 
+0x79, 0x6a, 0x56, 0x65, 0x55, 0x77, 0x48, 0x36, 
+0x52, 0x5a, 0x63, 0x4d, 0x78, 0x62, 0x38, 0x76, 
+0x57, 0x68, 0x7a, 0x53, 0x37, 0x43, 0x4d, 0x6e, 
+0x33, 0x43, 0x5a, 0x63, 0x62, 0x6b, 0x78, 0x74, 
+0x66, 0x61, 0x4b, 0x79, 0x6f, 0x64, 0x5a, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 
+0x43, 0x74, 0x74, 0x67, 0x6e, 0x55, 0x56, 0x6f, 
+0x34, 0x42, 0x6f, 0x67, 0x43, 0x46, 0x6b, 0x38, 
+0x68, 0x6e, 0x31, 0x53, 0x76, 0x55, 0x45, 0x64, 
+0x32, 0x58, 0x6a, 0x45, 0x34, 0x6d, 0x73, 0x71, 
+0x53, 0x66, 0x5a, 0x6b, 0x6e, 0x74, 0x4c, 0x65, 
+0x37, 0x52, 0x64, 0x51, 0x65, 0x62, 0x6f, 0x31, 
+0x45, 0x4a, 0x39, 0x72, 0x62, 0x75, 0x41, 0x6a, 
+0x54, 0x6a, 0x6d, 0x39, 0x71, 0x6d, 0x62, 0x68, 
+0x39, 0x58, 0x7a, 0x42, 0x62, 0x75, 0x4d, 0x76, 
+0x4d, 0x38, 0x54, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x39, 0x62, 0x47, 0x70, 
+0x47, 0x35, 0x48, 0x45, 0x56, 0x4a, 0x76, 0x62, 
+0x38, 0x52, 0x35, 0x4d, 0x4b, 0x4d, 0x6e, 0x36, 
+0x6b, 0x67, 0x50, 0x63, 0x31, 0x76, 0x78, 0x50, 
+0x4d, 0x79, 0x59, 0x48, 0x66, 0x72, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x61, 
+0x4e, 0x37, 0x66, 0x50, 0x76, 0x6f, 0x65, 0x4a, 
+0x4d, 0x32, 0x78, 0x43, 0x6f, 0x50, 0x69, 0x79, 
+0x63, 0x53, 0x6b, 0x46, 0x68, 0x44, 0x42, 0x62, 
+0x74, 0x34, 0x64, 0x5a, 0x75, 0x4e, 0x4c, 0x57, 
+0x58, 0x7a, 0x51, 0x73, 0x42, 0x6f, 0x6b, 0x7a, 
+0x6e, 0x67, 0x76, 0x59, 0x32, 0x45, 0x79, 0x43, 
+0x69, 0x74, 0x56, 0x37, 0x44, 0x39, 0x59, 0x35, 
+0x68, 0x4a, 0x47, 0x52, 0x57, 0x33, 0x79, 0x6b, 
+0x6e, 0x47, 0x4a, 0x53, 0x39, 0x69, 0x68, 0x46, 
+0x73, 0x37, 0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x22, 0x32, 0x54, 0x47, 0x50, 0x66, 
+0x43, 0x67, 0x48, 0x6e, 0x43, 0x52, 0x59, 0x47, 
+0x38, 0x36, 0x43, 0x42, 0x66, 0x67, 0x62, 0x55, 
+0x6f, 0x6a, 0x59, 0x43, 0x6b, 0x35, 0x7a, 0x6b, 
+0x51, 0x79, 0x36, 0x65, 0x56, 0x35, 0x22, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 
+0x55, 0x46, 0x77, 0x56, 0x62, 0x4a, 0x4d, 0x52, 
+0x65, 0x67, 0x57, 0x56, 0x73, 0x42, 0x53, 0x72, 
+0x4d, 0x61, 0x7a, 0x44, 0x41, 0x78, 0x70, 0x46, 
+0x67, 0x37, 0x68, 0x53, 0x4a, 0x57, 0x46, 0x5a, 
+0x70, 0x42, 0x66, 0x32, 0x35, 0x37, 0x51, 0x75, 
+0x38, 0x6d, 0x4a, 0x77, 0x6d, 0x67, 0x43, 0x57, 
+0x34, 0x53, 0x50, 0x4e, 0x61, 0x45, 0x53, 0x70, 
+0x68, 0x61, 0x37, 0x55, 0x6e, 0x6d, 0x68, 0x6f, 
+0x41, 0x6d, 0x5a, 0x71, 0x7a, 0x6b, 0x68, 0x65, 
+0x48, 0x75, 0x70, 0x22, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 0x20, 
+0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x22, 0x32, 0x47, 0x36, 0x32, 
+0x38, 0x5a, 0x56, 0x36, 0x4b, 0x4e, 0x59, 0x64, 
+0x77, 0x79, 0x64, 0x77, 0x6a, 0x57, 0x73, 0x43, 
+0x58, 0x69, 0x5a, 0x44, 0x4d, 0x4b, 0x4a, 0x51, 
+0x4d, 0x50, 0x4e, 0x78, 0x72, 0x53, 0x54, 0x61, 
+0x33, 0x32, 0x48, 0x54, 0x46, 0x56, 0x71, 0x42, 
+0x47, 0x45, 0x4a, 0x38, 0x66, 0x47, 0x42, 0x78, 
+0x78, 0x61, 0x76, 0x61, 0x47, 0x63, 0x56, 0x36, 
+0x47, 0x73, 0x36, 0x6e, 0x38, 0x47, 0x37, 0x65, 
+0x47, 0x4c, 0x68, 0x32, 0x6e, 0x74, 0x69, 0x48, 
+0x22, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x2c, 
+0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x5b, 0x0a, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x22, 0x33, 0x4d, 0x6a, 0x48, 0x73, 0x35, 0x79, 
+0x43, 0x6d, 0x42, 0x4d, 0x53, 0x47, 0x46, 0x44, 
+0x73, 0x61, 0x58, 0x62, 0x63, 0x72, 0x32, 0x41, 
+0x73, 0x77, 0x4c, 0x54, 0x4a, 0x4c, 0x6f, 0x48, 
+0x45, 0x6a, 0x71, 0x78, 0x71, 0x31, 0x72, 0x70, 
+0x56, 0x73, 0x31, 0x65, 0x51, 0x56, 0x6b, 0x4b, 
+0x57, 0x35, 0x4d, 0x31, 0x64, 0x59, 0x76, 0x4b, 
+0x6a, 0x73, 0x56, 0x63, 0x69, 0x56, 0x57, 0x39, 
+0x6a, 0x55, 0x54, 0x70, 0x6d, 0x44, 0x50, 0x42, 
+0x67, 0x77, 0x58, 0x70, 0x22, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5d, 0x2c, 0x20, 0x0a, 0x20, 0x20, 
+0x20, 0x20, 0x5b, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x22, 0x32, 0x45, 0x6e, 
+0x46, 0x4a, 0x44, 0x52, 0x41, 0x67, 0x37, 0x4d, 
+0x47, 0x78, 0x4e, 0x45, 0x6b, 0x4e, 0x67, 0x50, 
+0x4b, 0x45, 0x39, 0x55, 0x68, 0x5a, 0x71, 0x53, 
+0x31, 0x5a, 0x58, 0x7a, 0x6a, 0x71, 0x50, 0x22, 
+0x0a, 0x20, 0x20, 0x20, 0x20, 0x5d, 0x0a, 0x5d, 
+0x0a, 
+};};
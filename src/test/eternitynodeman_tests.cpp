@@ -0,0 +1,117 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "eternitynode-payments.h"
+#include "eternitynodeman.h"
+#include "main.h"
+#include "random.h"
+
+#include "test/test_eternity.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+/// The payee selection as it was before the payment queue, looks at every eternitynode on each call
+CEternitynode* GetNextEternitynodeInQueueForPaymentBaseline(const std::vector<CTxIn>& vecVins, int nBlockHeight, bool fFilterSigTime, int& nCount)
+{
+    LOCK(cs_main);
+
+    CEternitynode *pBestEternitynode = NULL;
+    std::vector<std::pair<int, CEternitynode*> > vecEternitynodeLastPaid;
+
+    int nMnCount = mnodeman.CountEnabled();
+    BOOST_FOREACH(const CTxIn& vin, vecVins)
+    {
+        CEternitynode& mn = *mnodeman.Find(vin);
+        if(!mn.IsValidForPayment()) continue;
+        if(mn.nProtocolVersion < enpayments.GetMinEternitynodePaymentsProto()) continue;
+        if(enpayments.IsScheduled(mn, nBlockHeight)) continue;
+        if(fFilterSigTime && mn.sigTime + (nMnCount*2.6*60) > GetAdjustedTime()) continue;
+        if(mn.GetCollateralAge() < nMnCount) continue;
+
+        vecEternitynodeLastPaid.push_back(std::make_pair(mn.GetLastPaidBlock(), &mn));
+    }
+
+    nCount = (int)vecEternitynodeLastPaid.size();
+
+    if(fFilterSigTime && nCount < nMnCount/3) return GetNextEternitynodeInQueueForPaymentBaseline(vecVins, nBlockHeight, false, nCount);
+
+    sort(vecEternitynodeLastPaid.begin(), vecEternitynodeLastPaid.end(), CompareLastPaidBlock());
+
+    uint256 blockHash;
+    if(!GetBlockHash(blockHash, nBlockHeight - 101)) return NULL;
+
+    int nTenthNetwork = nMnCount/10;
+    int nCountTenth = 0;
+    arith_uint256 nHighest = 0;
+    BOOST_FOREACH (PAIRTYPE(int, CEternitynode*)& s, vecEternitynodeLastPaid){
+        arith_uint256 nScore = s.second->CalculateScore(blockHash);
+        if(nScore > nHighest){
+            nHighest = nScore;
+            pBestEternitynode = s.second;
+        }
+        nCountTenth++;
+        if(nCountTenth >= nTenthNetwork) break;
+    }
+    return pBestEternitynode;
+}
+
+CPubKey MakePubKey()
+{
+    CKey key;
+    key.MakeNewKey(true);
+    return key.GetPubKey();
+}
+}
+
+BOOST_FIXTURE_TEST_SUITE(eternitynodeman_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(payment_queue_matches_baseline)
+{
+    // the chain is just the genesis block, scores are calculated from its hash
+    int nBlockHeight = 101;
+    int nWinners = 0;
+
+    for (int nRound = 0; nRound < 10; nRound++) {
+        mnodeman.Clear();
+
+        // 40 eternitynodes: some not payable, some with young collateral, payments spread over a few blocks
+        std::vector<CTxIn> vecVins;
+        for (int i = 0; i < 40; i++) {
+            CTxIn vin(COutPoint(GetRandHash(), 0));
+            CEternitynode mn(CService("1.2.3.4", 9999), vin, MakePubKey(), MakePubKey(), PROTOCOL_VERSION);
+            mn.nBlockLastPaid = insecure_rand() % 8;
+            // collateral confirmed up to 60 blocks before the genesis tip
+            mn.nCacheCollateralBlock = -1 - (int)(insecure_rand() % 60);
+            if (insecure_rand() % 8 == 0)
+                mn.SetActiveState(CEternitynode::ETERNITYNODE_EXPIRED);
+            BOOST_CHECK(mnodeman.Add(mn));
+            vecVins.push_back(vin);
+        }
+
+        // from no recently started eternitynodes to all of them, this crosses
+        // the point where the restart fallback drops the sigTime filter
+        for (int nRecent = 0; nRecent <= 40; nRecent += 4) {
+            for (int i = 0; i < 40; i++)
+                mnodeman.Find(vecVins[i])->sigTime = GetAdjustedTime() - (i < nRecent ? 0 : 100000);
+
+            int nCount = -1;
+            int nCountBaseline = -2;
+            CEternitynode* pmn = mnodeman.GetNextEternitynodeInQueueForPayment(nBlockHeight, true, nCount);
+            CEternitynode* pmnBaseline = GetNextEternitynodeInQueueForPaymentBaseline(vecVins, nBlockHeight, true, nCountBaseline);
+            BOOST_CHECK_EQUAL(nCount, nCountBaseline);
+            BOOST_CHECK_EQUAL(pmn == NULL, pmnBaseline == NULL);
+            if (pmn && pmnBaseline) {
+                BOOST_CHECK(pmn->vin == pmnBaseline->vin);
+                nWinners++;
+            }
+        }
+    }
+    BOOST_CHECK(nWinners > 0);
+
+    mnodeman.Clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
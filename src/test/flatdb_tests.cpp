@@ -0,0 +1,191 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "flat-database.h"
+
+#include "test/test_eternity.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+/** Something to store in a CFlatDB, counts how often it was cleaned up after loading and how many were created */
+class CFlatDBTestObject
+{
+public:
+    static int nCreated;
+
+    std::vector<int> vecData;
+    std::string strData;
+    int nCleaned;
+
+    CFlatDBTestObject() : nCleaned(0) { nCreated++; }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(vecData);
+        READWRITE(strData);
+    }
+
+    void Clear() { vecData.clear(); strData.clear(); }
+    void CheckAndRemove() { nCleaned++; }
+    std::string ToString() const { return strprintf("Entries: %d", (int)vecData.size()); }
+};
+
+int CFlatDBTestObject::nCreated = 0;
+
+CFlatDBTestObject MakeTestObject()
+{
+    CFlatDBTestObject obj;
+    for (int i = 0; i < 10000; i++)
+        obj.vecData.push_back(i * 7);
+    obj.strData = "flatdb";
+    return obj;
+}
+
+std::vector<char> ReadFile(const boost::filesystem::path& path)
+{
+    boost::filesystem::ifstream file(path, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const boost::filesystem::path& path, const std::vector<char>& vch)
+{
+    boost::filesystem::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(vch.empty() ? NULL : &vch[0], vch.size());
+}
+}
+
+BOOST_FIXTURE_TEST_SUITE(flatdb_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(flatdb_writer_reader)
+{
+    CFlatDBTestObject obj = MakeTestObject();
+    boost::filesystem::path path = GetDataDir() / "flatdb_stream.dat";
+
+    // the writer hashes exactly what it serializes
+    uint256 hashWritten;
+    {
+        CAutoFile fileout(fopen(path.string().c_str(), "wb"), SER_DISK, CLIENT_VERSION);
+        BOOST_REQUIRE(!fileout.IsNull());
+        CFlatDBWriter writer(fileout);
+        writer << obj;
+        hashWritten = writer.GetHash();
+    }
+    CHashWriter ss(SER_DISK, CLIENT_VERSION);
+    ss << obj;
+    BOOST_CHECK(hashWritten == ss.GetHash());
+    uint64_t nSize = boost::filesystem::file_size(path);
+
+    // and the reader gets it back with the same hash
+    {
+        CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+        BOOST_REQUIRE(!filein.IsNull());
+        CFlatDBReader reader(filein, nSize);
+        CFlatDBTestObject objRead;
+        reader >> objRead;
+        BOOST_CHECK(objRead.vecData == obj.vecData);
+        BOOST_CHECK_EQUAL(objRead.strData, obj.strData);
+        BOOST_CHECK(reader.GetHash() == hashWritten);
+    }
+
+    // reading past the size it was given fails, skipping still hashes everything
+    {
+        CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+        CFlatDBReader reader(filein, nSize - 1);
+        CFlatDBTestObject objRead;
+        BOOST_CHECK_THROW(reader >> objRead, std::ios_base::failure);
+    }
+    {
+        CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+        CFlatDBReader reader(filein, nSize);
+        std::vector<int> vecData;
+        reader >> vecData;
+        reader.SkipRemaining();
+        BOOST_CHECK(reader.GetHash() == hashWritten);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(flatdb_roundtrip)
+{
+    CFlatDBTestObject obj = MakeTestObject();
+    CFlatDB<CFlatDBTestObject> flatdb("flatdb.dat", "magicFlatDBTest");
+    boost::filesystem::path pathDB = GetDataDir() / "flatdb.dat";
+    boost::filesystem::path pathTmp = GetDataDir() / "flatdb.dat.new";
+
+    // a leftover temporary file from an interrupted write doesn't matter
+    WriteFile(pathTmp, std::vector<char>(100, 'x'));
+    BOOST_CHECK(flatdb.Dump(obj));
+    BOOST_CHECK(boost::filesystem::exists(pathDB));
+    BOOST_CHECK(!boost::filesystem::exists(pathTmp));
+
+    CFlatDBTestObject objLoaded;
+    BOOST_CHECK(flatdb.Load(objLoaded));
+    BOOST_CHECK(objLoaded.vecData == obj.vecData);
+    BOOST_CHECK_EQUAL(objLoaded.strData, obj.strData);
+    BOOST_CHECK_EQUAL(objLoaded.nCleaned, 1);
+
+    // verifying the previous file doesn't load it into another object
+    int nCreated = CFlatDBTestObject::nCreated;
+    BOOST_CHECK(flatdb.Dump(obj));
+    BOOST_CHECK_EQUAL(CFlatDBTestObject::nCreated, nCreated);
+
+    // snapshots write the very same file
+    std::vector<char> vchDumped = ReadFile(pathDB);
+    BOOST_CHECK(flatdb.DumpSnapshot(obj));
+    BOOST_CHECK(!boost::filesystem::exists(pathTmp));
+    BOOST_CHECK(ReadFile(pathDB) == vchDumped);
+
+    // a different magic message is rejected
+    CFlatDB<CFlatDBTestObject> flatdbOther("flatdb.dat", "magicFlatDBOther");
+    CFlatDBTestObject objOther;
+    BOOST_CHECK(!flatdbOther.Load(objOther));
+    BOOST_CHECK(objOther.vecData.empty());
+}
+
+BOOST_AUTO_TEST_CASE(flatdb_corrupted)
+{
+    CFlatDBTestObject obj = MakeTestObject();
+    CFlatDB<CFlatDBTestObject> flatdb("flatdb.dat", "magicFlatDBTest");
+    boost::filesystem::path pathDB = GetDataDir() / "flatdb.dat";
+    BOOST_CHECK(flatdb.Dump(obj));
+    std::vector<char> vch = ReadFile(pathDB);
+    BOOST_REQUIRE(vch.size() > 100 + sizeof(uint256));
+
+    // flipped bits in the data or in the checksum itself fail the checksum,
+    // the object isn't touched at all then
+    std::vector<char> vchCorrupted = vch;
+    vchCorrupted[100] ^= 1;
+    WriteFile(pathDB, vchCorrupted);
+    CFlatDBTestObject objLoaded;
+    objLoaded.strData = "untouched";
+    BOOST_CHECK(!flatdb.Load(objLoaded));
+    BOOST_CHECK(objLoaded.vecData.empty());
+    BOOST_CHECK_EQUAL(objLoaded.strData, "untouched");
+    BOOST_CHECK_EQUAL(objLoaded.nCleaned, 0);
+
+    vchCorrupted = vch;
+    vchCorrupted[vch.size() - 1] ^= 1;
+    WriteFile(pathDB, vchCorrupted);
+    BOOST_CHECK(!flatdb.Load(objLoaded));
+    BOOST_CHECK(objLoaded.vecData.empty());
+    BOOST_CHECK_EQUAL(objLoaded.strData, "untouched");
+
+    // as does a file too short to hold one
+    WriteFile(pathDB, std::vector<char>(vch.begin(), vch.begin() + sizeof(uint256) - 1));
+    BOOST_CHECK(!flatdb.Load(objLoaded));
+
+    // Dump() refuses to overwrite a file it can't verify, snapshots don't check
+    BOOST_CHECK(!flatdb.Dump(obj));
+    BOOST_CHECK(ReadFile(pathDB).size() < sizeof(uint256));
+    BOOST_CHECK(flatdb.DumpSnapshot(obj));
+    BOOST_CHECK(flatdb.Load(objLoaded));
+    BOOST_CHECK(objLoaded.vecData == obj.vecData);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
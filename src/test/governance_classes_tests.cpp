@@ -0,0 +1,50 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "governance-classes.h"
+#include "random.h"
+
+#include "test/test_eternity.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(governance_classes_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(trigger_height_index_tie_order)
+{
+    uint256 nHashLow = GetRandHash();
+    uint256 nHashHigh = GetRandHash();
+    if (nHashHigh < nHashLow)
+        std::swap(nHashLow, nHashHigh);
+
+    // two triggers for the same superblock, received in either order
+    CTriggerHeightIndex indexLowFirst;
+    indexLowFirst.Add(100, nHashLow);
+    indexLowFirst.Add(100, nHashHigh);
+    indexLowFirst.Add(200, GetRandHash());
+
+    CTriggerHeightIndex indexHighFirst;
+    indexHighFirst.Add(200, GetRandHash());
+    indexHighFirst.Add(100, nHashHigh);
+    indexHighFirst.Add(100, nHashLow);
+
+    // both come back in hash order, so the same one wins a tie on every node
+    std::vector<uint256> vecExpected;
+    vecExpected.push_back(nHashLow);
+    vecExpected.push_back(nHashHigh);
+    BOOST_CHECK(indexLowFirst.Get(100) == vecExpected);
+    BOOST_CHECK(indexHighFirst.Get(100) == vecExpected);
+
+    BOOST_CHECK(indexLowFirst.Get(150).empty());
+    BOOST_CHECK_EQUAL(indexLowFirst.Get(200).size(), 1U);
+
+    // removing needs the height the trigger was added for
+    indexHighFirst.Remove(200, nHashLow);
+    BOOST_CHECK_EQUAL(indexHighFirst.size(), 3U);
+    indexHighFirst.Remove(100, nHashLow);
+    BOOST_CHECK_EQUAL(indexHighFirst.size(), 2U);
+    BOOST_CHECK(indexHighFirst.Get(100) == std::vector<uint256>(1, nHashHigh));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
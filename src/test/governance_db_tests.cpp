@@ -0,0 +1,234 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "clientversion.h"
+#include "eternitynodeman.h"
+#include "governance-db.h"
+#include "random.h"
+#include "streams.h"
+#include "version.h"
+
+#include "test/test_eternity.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+CGovernanceVote MakeVote(const uint256& nParentHash, const CTxIn& vinEternitynode = CTxIn(COutPoint(GetRandHash(), 0)), vote_outcome_enum_t eOutcome = VOTE_OUTCOME_YES)
+{
+    return CGovernanceVote(vinEternitynode, nParentHash, VOTE_SIGNAL_FUNDING, eOutcome);
+}
+
+/// Write a vote the way ProcessVote does
+bool WriteVote(CGovernanceDB& db, const CGovernanceVote& vote)
+{
+    return db.WriteVote(vote, vote_instance_t(vote.GetOutcome(), GetTime(), vote.GetTimestamp()));
+}
+
+/// Add an eternitynode to the list, the current votes read from the database are only counted for known ones
+CTxIn AddEternitynode(const CTxIn& vin = CTxIn(COutPoint(GetRandHash(), 0)))
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CEternitynode mn(CService("1.2.3.4", 9999), vin, key.GetPubKey(), key.GetPubKey(), PROTOCOL_VERSION);
+    BOOST_CHECK(mnodeman.Add(mn));
+    return vin;
+}
+
+/// Make the governance code use a test database and reset it even if a check throws
+struct CGovernanceDBGuard
+{
+    CGovernanceDBGuard(CGovernanceDB* pdb) { pgovernancedb = pdb; }
+    ~CGovernanceDBGuard() { pgovernancedb = NULL; }
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(governance_db_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(governance_db_votes)
+{
+    CGovernanceDB db(1 << 20, true);
+    CGovernanceObject govobj(uint256(), 1, GetTime(), GetRandHash(), "");
+    CGovernanceObject govobjOther(uint256(), 2, GetTime(), GetRandHash(), "");
+    uint256 nHash = govobj.GetHash();
+    uint256 nHashOther = govobjOther.GetHash();
+    BOOST_CHECK(db.WriteObject(govobj));
+    BOOST_CHECK(db.WriteObject(govobjOther));
+
+    std::vector<CGovernanceVote> vecVotes;
+    for (int i = 0; i < 10; i++) {
+        vecVotes.push_back(MakeVote(nHash));
+        BOOST_CHECK(WriteVote(db, vecVotes.back()));
+    }
+    BOOST_CHECK(WriteVote(db, MakeVote(nHashOther)));
+
+    // only the votes of the object itself are read
+    CGovernanceObjectVoteFile fileVotes;
+    BOOST_CHECK(db.ReadVotes(nHash, fileVotes));
+    BOOST_CHECK_EQUAL(fileVotes.GetVoteCount(), 10);
+    for (size_t i = 0; i < vecVotes.size(); i++)
+        BOOST_CHECK(fileVotes.HasVote(vecVotes[i].GetHash()));
+
+    // votes of a removed eternitynode are erased by hash
+    std::vector<uint256> vecVoteHashesRemoved;
+    fileVotes.RemoveVotesFromEternitynode(vecVotes[0].GetVinEternitynode(), vecVoteHashesRemoved);
+    BOOST_CHECK_EQUAL(vecVoteHashesRemoved.size(), 1U);
+    std::vector<std::pair<COutPoint, int> > vecInstancesRemoved(1, std::make_pair(vecVotes[0].GetVinEternitynode().prevout, int(VOTE_SIGNAL_FUNDING)));
+    BOOST_CHECK(db.EraseVotes(nHash, vecVoteHashesRemoved, vecInstancesRemoved));
+    CGovernanceObjectVoteFile fileVotesRead;
+    BOOST_CHECK(db.ReadVotes(nHash, fileVotesRead));
+    BOOST_CHECK_EQUAL(fileVotesRead.GetVoteCount(), 9);
+    BOOST_CHECK(!fileVotesRead.HasVote(vecVotes[0].GetHash()));
+
+    // erasing an object erases its votes but not those of other objects
+    BOOST_CHECK(db.EraseObject(nHash));
+    CGovernanceObjectVoteFile fileVotesErased;
+    BOOST_CHECK(db.ReadVotes(nHash, fileVotesErased));
+    BOOST_CHECK_EQUAL(fileVotesErased.GetVoteCount(), 0);
+    CGovernanceObjectVoteFile fileVotesOther;
+    BOOST_CHECK(db.ReadVotes(nHashOther, fileVotesOther));
+    BOOST_CHECK_EQUAL(fileVotesOther.GetVoteCount(), 1);
+
+    std::map<uint256, CGovernanceObject> mapObjects;
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_CHECK_EQUAL(mapObjects.size(), 1U);
+    BOOST_CHECK(mapObjects.count(nHashOther));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_reload)
+{
+    CGovernanceDB db(1 << 20, true);
+    CGovernanceDBGuard guard(&db);
+
+    CGovernanceObject govobj(uint256(), 1, GetTime(), GetRandHash(), "");
+    uint256 nHash = govobj.GetHash();
+    BOOST_CHECK(db.WriteObject(govobj));
+    std::vector<CGovernanceVote> vecVotes;
+    for (int i = 0; i < 5; i++) {
+        vecVotes.push_back(MakeVote(nHash));
+        BOOST_CHECK(WriteVote(db, vecVotes.back()));
+    }
+
+    std::map<uint256, CGovernanceObject> mapObjects;
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_REQUIRE_EQUAL(mapObjects.size(), 1U);
+    CGovernanceObject& govobjLoaded = mapObjects.begin()->second;
+    BOOST_CHECK(govobjLoaded.GetHash() == nHash);
+
+    // the votes are read on first use
+    BOOST_CHECK(!govobjLoaded.IsSetVotesLoaded());
+    BOOST_CHECK_EQUAL(govobjLoaded.GetVoteFile().GetVoteCount(), 5);
+    for (size_t i = 0; i < vecVotes.size(); i++)
+        BOOST_CHECK(govobjLoaded.GetVoteFile().HasVote(vecVotes[i].GetHash()));
+
+    // recently used votes stay in memory
+    std::vector<uint256> vecVoteHashesErased(1, vecVotes[0].GetHash());
+    BOOST_CHECK(db.EraseVotes(nHash, vecVoteHashesErased, std::vector<std::pair<COutPoint, int> >()));
+    govobjLoaded.EvictVotes(GetTime() - GOVERNANCE_VOTE_CACHE_TIME);
+    BOOST_CHECK_EQUAL(govobjLoaded.GetVoteFile().GetVoteCount(), 5);
+
+    // unused ones are dropped and read back from the database
+    govobjLoaded.EvictVotes(GetTime() + 1);
+    BOOST_CHECK(!govobjLoaded.IsSetVotesLoaded());
+    BOOST_CHECK_EQUAL(govobjLoaded.GetVoteFile().GetVoteCount(), 4);
+    BOOST_CHECK(!govobjLoaded.GetVoteFile().HasVote(vecVotes[0].GetHash()));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_unclean_shutdown)
+{
+    CGovernanceDB db(1 << 20, true);
+    CGovernanceDBGuard guard(&db);
+    mnodeman.Clear();
+
+    CGovernanceObject govobj(uint256(), 1, GetTime(), GetRandHash(), "");
+    uint256 nHash = govobj.GetHash();
+    BOOST_CHECK(db.WriteObject(govobj));
+
+    // only the vote and the current vote of its eternitynode are written, never the object record
+    std::vector<CGovernanceVote> vecVotes;
+    std::vector<CTxIn> vecVins;
+    for (int i = 0; i < 3; i++) {
+        vecVins.push_back(AddEternitynode());
+        vecVotes.push_back(MakeVote(nHash, vecVins.back()));
+        BOOST_CHECK(WriteVote(db, vecVotes.back()));
+    }
+    // a changed vote replaces the current vote of its eternitynode
+    SetMockTime(GetTime() + 1);
+    vecVotes.push_back(MakeVote(nHash, vecVins[0], VOTE_OUTCOME_NO));
+    BOOST_CHECK(WriteVote(db, vecVotes.back()));
+    SetMockTime(0);
+    // the vote of an eternitynode which is gone isn't counted
+    BOOST_CHECK(WriteVote(db, MakeVote(nHash)));
+
+    // no WriteObjects flush happened, the reloaded tallies still count every stored vote
+    std::map<uint256, CGovernanceObject> mapObjects;
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_REQUIRE_EQUAL(mapObjects.size(), 1U);
+    CGovernanceObject& govobjLoaded = mapObjects.begin()->second;
+    BOOST_CHECK_EQUAL(govobjLoaded.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 2);
+    BOOST_CHECK_EQUAL(govobjLoaded.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO), 1);
+    BOOST_CHECK_EQUAL(govobjLoaded.GetVoteFile().GetVoteCount(), 5);
+    for (size_t i = 0; i < vecVotes.size(); i++)
+        BOOST_CHECK(govobjLoaded.GetVoteFile().HasVote(vecVotes[i].GetHash()));
+
+    // current votes of eternitynodes missing from the list are erased on load
+    mnodeman.Clear();
+    mapObjects.clear();
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_REQUIRE_EQUAL(mapObjects.size(), 1U);
+    BOOST_CHECK_EQUAL(mapObjects.begin()->second.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 0);
+    AddEternitynode(vecVins[1]);
+    mapObjects.clear();
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_CHECK_EQUAL(mapObjects.begin()->second.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 0);
+
+    mnodeman.Clear();
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_import)
+{
+    CGovernanceDB db(1 << 20, true);
+    CGovernanceDBGuard guard(&db);
+
+    // an object as read from a governance.dat written without the database,
+    // its vote maps use the indexes of the eternitynode list in mncache.dat
+    mnodeman.Clear();
+    for (int i = 0; i < 3; i++)
+        AddEternitynode();
+    CGovernanceObject govobjNet(uint256(), 1, GetTime(), GetRandHash(), "");
+    uint256 nHash = govobjNet.GetHash();
+    CGovernanceObject::vote_m_t mapCurrentMNVotes;
+    CGovernanceObjectVoteFile fileVotes;
+    for (int i = 0; i < 3; i++) {
+        vote_outcome_enum_t eOutcome = i < 2 ? VOTE_OUTCOME_YES : VOTE_OUTCOME_NO;
+        mapCurrentMNVotes[i].mapInstances[VOTE_SIGNAL_FUNDING] = vote_instance_t(eOutcome, GetTime(), GetTime());
+        fileVotes.AddVote(MakeVote(nHash));
+    }
+    CDataStream ssNet(SER_NETWORK, PROTOCOL_VERSION);
+    ssNet << govobjNet;
+    CDataStream ss(ssNet.begin(), ssNet.end(), SER_DISK, CLIENT_VERSION);
+    ss << int64_t(0) << false << mapCurrentMNVotes << fileVotes;
+    std::map<uint256, CGovernanceObject> mapObjectsToImport;
+    ss >> mapObjectsToImport[nHash];
+    BOOST_CHECK(db.ImportObjects(mapObjectsToImport));
+
+    // the current votes are imported, no vote is read to restore the tallies
+    std::map<uint256, CGovernanceObject> mapObjects;
+    BOOST_CHECK(db.LoadObjects(mapObjects));
+    BOOST_REQUIRE_EQUAL(mapObjects.size(), 1U);
+    CGovernanceObject& govobjLoaded = mapObjects.begin()->second;
+    BOOST_CHECK(govobjLoaded.GetHash() == nHash);
+    BOOST_CHECK_EQUAL(govobjLoaded.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 2);
+    BOOST_CHECK_EQUAL(govobjLoaded.GetAbsoluteYesCount(VOTE_SIGNAL_FUNDING), 1);
+    BOOST_CHECK(!govobjLoaded.IsSetVotesLoaded());
+
+    const CGovernanceObjectVoteFile::vote_l_t& listVotes = fileVotes.GetVoteList();
+    BOOST_CHECK_EQUAL(govobjLoaded.GetVoteFile().GetVoteCount(), 3);
+    for (CGovernanceObjectVoteFile::vote_l_cit it = listVotes.begin(); it != listVotes.end(); ++it)
+        BOOST_CHECK(govobjLoaded.GetVoteFile().HasVote(it->GetHash()));
+
+    mnodeman.Clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+// Copyright (c) 2016-2017 The Eternity group Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "chainparams.h"
+#include "eternitynode-payments.h"
+#include "eternitynodeman.h"
+#include "hash.h"
+#include "main.h"
+#include "net.h"
+#include "spysend.h"
+#include "spysend-sigcheck.h"
+#include "random.h"
+#include "util.h"
+
+#include "test/test_eternity.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+/// Feed a message to pnode as if it was received from the network
+void ReceiveMessage(CNode& node, const char* pszCommand, const CDataStream& ssPayload)
+{
+    CMessageHeader hdr(Params().MessageStart(), pszCommand, ssPayload.size());
+    uint256 hash = Hash(ssPayload.begin(), ssPayload.end());
+    memcpy(&hdr.nChecksum, &hash, sizeof(hdr.nChecksum));
+    CDataStream ssMsg(SER_NETWORK, PROTOCOL_VERSION);
+    ssMsg << hdr;
+    ssMsg += ssPayload;
+    BOOST_CHECK(node.ReceiveMsgBytes(&ssMsg[0], ssMsg.size()));
+}
+
+CEternitynodePaymentVote MakePaymentVote(const CTxIn& vin, int nBlockHeight, const CKey& key)
+{
+    CEternitynodePaymentVote vote(vin, nBlockHeight, CScript() << OP_TRUE);
+    BOOST_CHECK(spySendSigner.SignMessage(vote.GetSignatureMessage(), vote.vchSig, key));
+    return vote;
+}
+}
+
+BOOST_FIXTURE_TEST_SUITE(spysend_sigcheck_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(message_sig_cache)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CKey keyOther;
+    keyOther.MakeNewKey(true);
+    std::string strMessage = "message_sig_cache " + GetRandHash().ToString();
+    uint256 hashMessage = spySendSigner.GetMessageHash(strMessage);
+    std::vector<unsigned char> vchSig;
+    BOOST_CHECK(spySendSigner.SignMessage(strMessage, vchSig, key));
+    std::string strError;
+
+    // a failed verification isn't cached
+    BOOST_CHECK(!spySendSigner.VerifyMessage(keyOther.GetPubKey(), vchSig, strMessage, strError));
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSig, keyOther.GetPubKey()));
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSig, key.GetPubKey()));
+
+    // a successful one is
+    BOOST_CHECK(spySendSigner.VerifyMessage(key.GetPubKey(), vchSig, strMessage, strError));
+    BOOST_CHECK(GetMessageSigCache(hashMessage, vchSig, key.GetPubKey()));
+
+    // same message and signature but another pubkey
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSig, keyOther.GetPubKey()));
+    BOOST_CHECK(!spySendSigner.VerifyMessage(keyOther.GetPubKey(), vchSig, strMessage, strError));
+
+    // tampered signature
+    std::vector<unsigned char> vchSigTampered(vchSig);
+    vchSigTampered[vchSigTampered.size() - 1] ^= 1;
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSigTampered, key.GetPubKey()));
+    BOOST_CHECK(!spySendSigner.VerifyMessage(key.GetPubKey(), vchSigTampered, strMessage, strError));
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSigTampered, key.GetPubKey()));
+
+    // another message with the same signature
+    BOOST_CHECK(!GetMessageSigCache(spySendSigner.GetMessageHash(strMessage + "!"), vchSig, key.GetPubKey()));
+}
+
+BOOST_AUTO_TEST_CASE(message_sig_cache_eviction)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CPubKey pubkey = key.GetPubKey();
+    std::vector<unsigned char> vchSig(65, 0);
+
+    // entries take a few dozen bytes, 1 MiB holds a lot less than this
+    mapArgs["-msgsigcachesize"] = "1";
+    const int nEntries = 100000;
+    std::vector<uint256> vecHashes;
+    for (int i = 0; i < nEntries; i++) {
+        vecHashes.push_back(GetRandHash());
+        SetMessageSigCache(vecHashes.back(), vchSig, pubkey);
+    }
+    int nHits = 0;
+    for (int i = 0; i < nEntries; i++) {
+        if (GetMessageSigCache(vecHashes[i], vchSig, pubkey))
+            nHits++;
+    }
+    BOOST_CHECK(nHits > 0);
+    BOOST_CHECK(nHits < nEntries);
+    // eviction happens before an insert, the latest entry is always there
+    BOOST_CHECK(GetMessageSigCache(vecHashes.back(), vchSig, pubkey));
+
+    // nothing is cached without a cache
+    mapArgs["-msgsigcachesize"] = "0";
+    uint256 hashMessage = GetRandHash();
+    SetMessageSigCache(hashMessage, vchSig, pubkey);
+    BOOST_CHECK(!GetMessageSigCache(hashMessage, vchSig, pubkey));
+
+    mapArgs.erase("-msgsigcachesize");
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_message_signatures)
+{
+    mnodeman.Clear();
+    CKey key;
+    key.MakeNewKey(true);
+    CPubKey pubkey = key.GetPubKey();
+    CTxIn vin(COutPoint(GetRandHash(), 0));
+    CEternitynode mn(CService("1.2.3.4", 9999), vin, pubkey, pubkey, PROTOCOL_VERSION);
+    BOOST_CHECK(mnodeman.Add(mn));
+
+    CEternitynodePing mnp;
+    mnp.vin = vin;
+    mnp.blockHash = GetRandHash();
+    mnp.sigTime = GetAdjustedTime();
+    BOOST_CHECK(spySendSigner.SignMessage(mnp.GetSignatureMessage(), mnp.vchSig, key));
+    CEternitynodePaymentVote vote = MakePaymentVote(vin, 100, key);
+    CEternitynodePaymentVote voteInvalid = MakePaymentVote(vin, 101, key);
+    voteInvalid.vchSig[voteInvalid.vchSig.size() - 1] ^= 1;
+    CEternitynodePaymentVote voteUnused = MakePaymentVote(vin, 102, key);
+
+    CAddress addr(CService("10.11.12.1", 9999));
+    CNode node(INVALID_SOCKET, addr, "", true);
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << mnp;
+    ReceiveMessage(node, NetMsgType::MNPING, ss);
+    ss.clear();
+    ss << vote;
+    ReceiveMessage(node, NetMsgType::ETERNITYNODEPAYMENTVOTE, ss);
+    ss.clear();
+    ss << voteInvalid;
+    ReceiveMessage(node, NetMsgType::ETERNITYNODEPAYMENTVOTE, ss);
+    ss.clear();
+    ss << voteUnused;
+    ReceiveMessage(node, NetMsgType::ETERNITYNODEPAYMENTVOTE, ss);
+
+    // without worker threads the signers are recovered by this thread while it waits
+    int nScriptCheckThreadsPrev = nScriptCheckThreads;
+    nScriptCheckThreads = 1;
+    {
+        LOCK(node.cs_vRecvMsg);
+        PrefetchMessageSignatures(&node);
+    }
+    nScriptCheckThreads = nScriptCheckThreadsPrev;
+
+    BOOST_REQUIRE_EQUAL(node.vRecvMsg.size(), 4U);
+    for (std::deque<CNetMessage>::iterator it = node.vRecvMsg.begin(); it != node.vRecvMsg.end(); ++it) {
+        BOOST_CHECK(it->fSigPrefetched);
+        BOOST_CHECK_EQUAL(it->vSigPrefetchKeys.size(), 1U);
+    }
+
+    // VerifyMessage takes the prefetched signer
+    std::string strError;
+    uint256 hashPing = spySendSigner.GetMessageHash(mnp.GetSignatureMessage());
+    CSignedMessageResult result;
+    BOOST_CHECK(spySendSigner.VerifyMessage(pubkey, mnp.vchSig, mnp.GetSignatureMessage(), strError));
+    BOOST_CHECK(!GetPrefetchedSigner(hashPing, mnp.vchSig, result));
+
+    uint256 hashVote = spySendSigner.GetMessageHash(vote.GetSignatureMessage());
+    BOOST_CHECK(GetPrefetchedSigner(hashVote, vote.vchSig, result));
+    BOOST_CHECK(result.fValid);
+    BOOST_CHECK(result.keyID == pubkey.GetID());
+
+    // and rejects a signature its signer wasn't recovered from
+    uint256 hashVoteInvalid = spySendSigner.GetMessageHash(voteInvalid.GetSignatureMessage());
+    BOOST_CHECK(!spySendSigner.VerifyMessage(pubkey, voteInvalid.vchSig, voteInvalid.GetSignatureMessage(), strError));
+    BOOST_CHECK(!GetPrefetchedSigner(hashVoteInvalid, voteInvalid.vchSig, result));
+    BOOST_CHECK(!GetMessageSigCache(hashVoteInvalid, voteInvalid.vchSig, pubkey));
+
+    // results the handler of a message didn't ask for are dropped after it
+    uint256 hashVoteUnused = spySendSigner.GetMessageHash(voteUnused.GetSignatureMessage());
+    ForgetPrefetchedSigners(node.vRecvMsg[3].vSigPrefetchKeys);
+    BOOST_CHECK(!GetPrefetchedSigner(hashVoteUnused, voteUnused.vchSig, result));
+
+    mnodeman.Clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,7 @@
 #include "chainparams.h"
 #include "consensus/consensus.h"
 #include "consensus/validation.h"
+#include "crypto/x11.h"
 #include "key.h"
 #include "main.h"
 #include "miner.h"
@@ -35,6 +36,7 @@ extern void noui_connect();
 
 BasicTestingSetup::BasicTestingSetup(const std::string& chainName)
 {
+        X11AutoDetect();
         ECC_Start();
         SetupEnvironment();
         SetupNetworking();
@@ -139,6 +139,7 @@ UniValue importprivkey(const UniValue& params, bool fHelp)
 
         if (!pwalletMain->AddKeyPubKey(key, pubkey))
             throw JSONRPCError(RPC_WALLET_ERROR, "Error adding key to wallet");
+        pwalletMain->MarkOutputsDirty();
 
         // whenever a key is imported, we need to scan the whole chain
         pwalletMain->nTimeFirstKey = 1; // 0 would be considered 'no value'
@@ -391,6 +392,7 @@ UniValue importwallet(const UniValue& params, bool fHelp)
     }
     file.close();
     pwalletMain->ShowProgress("", 100); // hide progress dialog in GUI
+    pwalletMain->MarkOutputsDirty();
 
     CBlockIndex *pindex = chainActive.Tip();
     while (pindex && pindex->pprev && pindex->GetBlockTime() > nTimeBegin - 7200)
@@ -521,6 +523,7 @@ UniValue importelectrumwallet(const UniValue& params, bool fHelp)
     }
     file.close();
     pwalletMain->ShowProgress("", 100); // hide progress dialog in GUI
+    pwalletMain->MarkOutputsDirty();
 
     // Whether to perform rescan after import
     int nStartHeight = 0;
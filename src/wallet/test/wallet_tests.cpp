@@ -4,6 +4,10 @@
 
 #include "wallet/wallet.h"
 
+#include "main.h"
+#include "spysend.h"
+#include "wallet/walletdb.h"
+
 #include <set>
 #include <stdint.h>
 #include <utility>
@@ -23,6 +27,8 @@
 
 using namespace std;
 
+extern CWallet* pwalletMain;
+
 typedef set<pair<const CWalletTx*,unsigned int> > CoinSet;
 
 BOOST_FIXTURE_TEST_SUITE(wallet_tests, TestingSetup)
@@ -361,4 +367,229 @@ BOOST_AUTO_TEST_CASE(ApproximateBestSubset)
     BOOST_CHECK_EQUAL(setCoinsRet.size(), 101);
 }
 
+
+static uint256 add_wallet_tx(CWallet& wallet, const CScript& scriptPubKey, const vector<COutPoint>& vPrevouts, const vector<CAmount>& vValues, const uint256& hashBlock = uint256())
+{
+    static int nextLockTime = 0;
+    CMutableTransaction tx;
+    tx.nLockTime = nextLockTime++;
+    BOOST_FOREACH(const COutPoint& prevout, vPrevouts)
+        tx.vin.push_back(CTxIn(prevout));
+    BOOST_FOREACH(const CAmount& nValue, vValues)
+        tx.vout.push_back(CTxOut(nValue, scriptPubKey));
+    CWalletTx wtx(&wallet, tx);
+    if (!hashBlock.IsNull()) {
+        wtx.hashBlock = hashBlock;
+        wtx.nIndex = 0;
+    }
+    CWalletDB walletdb(wallet.strWalletFile);
+    BOOST_CHECK(wallet.AddToWallet(wtx, false, &walletdb));
+    return wtx.GetHash();
+}
+
+static uint256 add_wallet_tx(CWallet& wallet, const CScript& scriptPubKey, const CAmount& nValue, const COutPoint& prevout = COutPoint(), const uint256& hashBlock = uint256())
+{
+    vector<COutPoint> vPrevouts;
+    if (!prevout.IsNull())
+        vPrevouts.push_back(prevout);
+    return add_wallet_tx(wallet, scriptPubKey, vPrevouts, vector<CAmount>(1, nValue), hashBlock);
+}
+
+static set<uint256> unspent_txs(const CWallet& wallet, AvailableCoinsType nCoinType)
+{
+    vector<const CWalletTx*> vpwtx;
+    wallet.GetUnspentOutputTxs(vpwtx, wallet.GetUnspentOutputTypeMask(nCoinType));
+    set<uint256> setHashes;
+    BOOST_FOREACH(const CWalletTx* pwtx, vpwtx)
+        setHashes.insert(pwtx->GetHash());
+    return setHashes;
+}
+
+BOOST_AUTO_TEST_CASE(unspent_output_index)
+{
+    CWallet& wallet = *pwalletMain;
+    spySendPool.InitDenominations();
+
+    LOCK2(cs_main, wallet.cs_wallet);
+
+    CKey key;
+    key.MakeNewKey(true);
+    BOOST_CHECK(wallet.AddKeyPubKey(key, key.GetPubKey()));
+    CScript scriptMine = GetScriptForDestination(key.GetPubKey().GetID());
+    CKey keyOther;
+    keyOther.MakeNewKey(true);
+    CScript scriptOther = GetScriptForDestination(keyOther.GetPubKey().GetID());
+
+    uint256 hashDenom = add_wallet_tx(wallet, scriptMine, vecSpySendDenominations[1]);
+    uint256 hashCollateral = add_wallet_tx(wallet, scriptMine, SPYSEND_COLLATERAL * 2);
+    uint256 hash1000 = add_wallet_tx(wallet, scriptMine, 1000 * COIN);
+    uint256 hashOther = add_wallet_tx(wallet, scriptMine, 3 * COIN);
+    add_wallet_tx(wallet, scriptOther, 3 * COIN);
+
+    // each kind of coins only looks at its own bucket
+    set<uint256> setExpected;
+    setExpected.insert(hashDenom);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+    setExpected.clear();
+    setExpected.insert(hashCollateral);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_SPYSEND_COLLATERAL) == setExpected);
+    setExpected.clear();
+    setExpected.insert(hash1000);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_1000) == setExpected);
+    setExpected.insert(hashOther);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_NONDENOMINATED_NOT1000IFMN) == setExpected);
+    fEternityNode = true;
+    setExpected.erase(hash1000);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_NONDENOMINATED_NOT1000IFMN) == setExpected);
+    setExpected.insert(hashDenom);
+    setExpected.insert(hashCollateral);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_NOT1000IFMN) == setExpected);
+    fEternityNode = false;
+    setExpected.insert(hash1000);
+    BOOST_CHECK(unspent_txs(wallet, ALL_COINS) == setExpected);
+
+    // transactions added once the index is built go to their buckets too
+    uint256 hashDenom2 = add_wallet_tx(wallet, scriptMine, vecSpySendDenominations[0]);
+    setExpected.clear();
+    setExpected.insert(hashDenom);
+    setExpected.insert(hashDenom2);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+
+    // outputs of a script we learn about later, like addmultisigaddress does
+    CScript scriptP2SH = GetScriptForDestination(CScriptID(scriptMine));
+    uint256 hashP2SH = add_wallet_tx(wallet, scriptP2SH, 5 * COIN);
+    BOOST_CHECK(!unspent_txs(wallet, ALL_COINS).count(hashP2SH));
+    BOOST_CHECK(wallet.AddCScript(scriptMine));
+    BOOST_CHECK(unspent_txs(wallet, ALL_COINS).count(hashP2SH));
+
+    // fake a block on top of the genesis block to confirm spends in
+    CBlockIndex* pindexGenesis = chainActive.Tip();
+    CBlockIndex* pindexFake = new CBlockIndex();
+    pindexFake->pprev = pindexGenesis;
+    pindexFake->nHeight = pindexGenesis->nHeight + 1;
+    BlockMap::iterator mi = mapBlockIndex.insert(make_pair(GetRandHash(), pindexFake)).first;
+    pindexFake->phashBlock = &mi->first;
+
+    // confirmed spends drop the outputs, an abandoned spend after its block is gone brings them back
+    chainActive.SetTip(pindexFake);
+    uint256 hashSpend = add_wallet_tx(wallet, scriptMine, 3 * COIN, COutPoint(hashDenom, 0), pindexFake->GetBlockHash());
+    setExpected.erase(hashDenom);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+    chainActive.SetTip(pindexGenesis);
+    BOOST_CHECK(wallet.AbandonTransaction(hashSpend));
+    setExpected.insert(hashDenom);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+
+    // and so does disconnecting the block of a spend
+    chainActive.SetTip(pindexFake);
+    uint256 hashSpend2 = add_wallet_tx(wallet, scriptMine, 3 * COIN, COutPoint(hashDenom2, 0), pindexFake->GetBlockHash());
+    setExpected.erase(hashDenom2);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+    chainActive.SetTip(pindexGenesis);
+    wallet.SyncTransaction(wallet.mapWallet[hashSpend2], NULL);
+    setExpected.insert(hashDenom2);
+    BOOST_CHECK(unspent_txs(wallet, ONLY_DENOMINATED) == setExpected);
+
+    // the tip is back at genesis, drop the fake block from the global index
+    uint256 hashFake = pindexFake->GetBlockHash();
+    mapBlockIndex.erase(hashFake);
+    delete pindexFake;
+}
+
+
+// the recursive walk GetRealInputSpySendRounds used to do, without caching
+static int spysend_rounds_recursive(const CWallet& wallet, const CTxIn& txin)
+{
+    const CWalletTx* wtx = wallet.GetWalletTx(txin.prevout.hash);
+    if (wtx == NULL)
+        return -1;
+    if (txin.prevout.n >= wtx->vout.size())
+        return -4;
+    if (wallet.IsCollateralAmount(wtx->vout[txin.prevout.n].nValue))
+        return -3;
+    if (!wallet.IsDenominatedAmount(wtx->vout[txin.prevout.n].nValue))
+        return -2;
+    BOOST_FOREACH(const CTxOut& out, wtx->vout) {
+        if (!wallet.IsDenominatedAmount(out.nValue))
+            return 0;
+    }
+
+    int nShortest = -10;
+    BOOST_FOREACH(const CTxIn& txinNext, wtx->vin) {
+        if (wallet.IsMine(txinNext)) {
+            int n = spysend_rounds_recursive(wallet, txinNext);
+            if (n >= 0 && (n < nShortest || nShortest == -10))
+                nShortest = n;
+        }
+    }
+    return nShortest != -10 ? (nShortest >= 15 ? 16 : nShortest + 1) : 0;
+}
+
+BOOST_AUTO_TEST_CASE(spysend_rounds)
+{
+    CWallet& wallet = *pwalletMain;
+    spySendPool.InitDenominations();
+
+    LOCK(wallet.cs_wallet);
+
+    CKey key;
+    key.MakeNewKey(true);
+    BOOST_CHECK(wallet.AddKeyPubKey(key, key.GetPubKey()));
+    CScript scriptMine = GetScriptForDestination(key.GetPubKey().GetID());
+    const CAmount nDenom1 = vecSpySendDenominations[1];
+    const CAmount nDenom2 = vecSpySendDenominations[2];
+
+    // a small mixing history: fully denominated transactions spending each other,
+    // with mixed, collateral and foreign inputs along the way
+    vector<COutPoint> vPrevouts;
+    vector<CAmount> vValues;
+    vector<uint256> vHashes;
+
+    vValues.push_back(nDenom1); vValues.push_back(nDenom1); vValues.push_back(nDenom2);
+    uint256 hash0 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vValues.clear(); vValues.push_back(nDenom1); vValues.push_back(3 * COIN);
+    uint256 hashMixed = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vValues.clear(); vValues.push_back(SPYSEND_COLLATERAL * 2);
+    uint256 hashCollateral = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+
+    vPrevouts.push_back(COutPoint(hash0, 0)); vPrevouts.push_back(COutPoint(hash0, 1));
+    vValues.clear(); vValues.push_back(nDenom1); vValues.push_back(nDenom1);
+    uint256 hash1 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash1, 0)); vPrevouts.push_back(COutPoint(hash0, 2));
+    vPrevouts.push_back(COutPoint(GetRandHash(), 0));
+    uint256 hash2 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash1, 1)); vPrevouts.push_back(COutPoint(hash2, 0));
+    vValues.clear(); vValues.push_back(nDenom1); vValues.push_back(nDenom2);
+    uint256 hash3 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash3, 0)); vPrevouts.push_back(COutPoint(hashMixed, 0));
+    uint256 hash4 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash3, 1)); vPrevouts.push_back(COutPoint(hashCollateral, 0));
+    uint256 hash5 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash5, 0)); vPrevouts.push_back(COutPoint(hashMixed, 1));
+    vPrevouts.push_back(COutPoint(hash4, 1));
+    vValues.clear(); vValues.push_back(nDenom1); vValues.push_back(nDenom1); vValues.push_back(nDenom2);
+    uint256 hash6 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+    vPrevouts.clear(); vPrevouts.push_back(COutPoint(hash5, 1)); vPrevouts.push_back(COutPoint(hash4, 0));
+    vValues.clear(); vValues.push_back(nDenom2); vValues.push_back(3 * COIN);
+    uint256 hash7 = add_wallet_tx(wallet, scriptMine, vPrevouts, vValues);
+
+    // deepest first so the rest comes from the cache
+    vHashes.push_back(hash6); vHashes.push_back(hash7); vHashes.push_back(hash3); vHashes.push_back(hash0);
+    vHashes.push_back(hash1); vHashes.push_back(hash2); vHashes.push_back(hash4); vHashes.push_back(hash5);
+    vHashes.push_back(hashMixed); vHashes.push_back(hashCollateral);
+    BOOST_FOREACH(const uint256& hash, vHashes) {
+        for (unsigned int i = 0; i <= wallet.mapWallet[hash].vout.size(); i++) {
+            CTxIn txin(hash, i);
+            BOOST_CHECK_EQUAL(wallet.GetRealInputSpySendRounds(txin), spysend_rounds_recursive(wallet, txin));
+        }
+    }
+    BOOST_CHECK_EQUAL(wallet.GetRealInputSpySendRounds(CTxIn(hash6, 0)), 2);
+    BOOST_CHECK_EQUAL(wallet.GetRealInputSpySendRounds(CTxIn(hash4, 0)), 1);
+    BOOST_CHECK_EQUAL(wallet.GetRealInputSpySendRounds(CTxIn(GetRandHash(), 0)), -1);
+
+    // flushing writes the cached rounds and keeps them
+    wallet.FlushSpySendRounds();
+    BOOST_CHECK_EQUAL(wallet.GetRealInputSpySendRounds(CTxIn(hash6, 0)), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -131,6 +131,8 @@ bool CWallet::AddKeyPubKey(const CKey& secret, const CPubKey &pubkey)
     AssertLockHeld(cs_wallet); // mapKeyMetadata
     if (!CCryptoKeyStore::AddKeyPubKey(secret, pubkey))
         return false;
+    // a freshly generated key can't own outputs we already have, importers call MarkOutputsDirty()
+    // to reindex, so topping up the keypool on every send doesn't rebuild the unspent output index
 
     // check if we need to remove from watch-only
     CScript script;
@@ -191,6 +193,7 @@ bool CWallet::AddCScript(const CScript& redeemScript)
 {
     if (!CCryptoKeyStore::AddCScript(redeemScript))
         return false;
+    MarkOutputsDirty();
     if (!fFileBacked)
         return true;
     return CWalletDB(strWalletFile).WriteCScript(Hash160(redeemScript), redeemScript);
@@ -216,6 +219,7 @@ bool CWallet::AddWatchOnly(const CScript &dest)
 {
     if (!CCryptoKeyStore::AddWatchOnly(dest))
         return false;
+    MarkOutputsDirty();
     nTimeFirstKey = 1; // No birthday information for watch-only keys.
     NotifyWatchonlyChanged(true);
     if (!fFileBacked)
@@ -228,6 +232,7 @@ bool CWallet::RemoveWatchOnly(const CScript &dest)
     AssertLockHeld(cs_wallet);
     if (!CCryptoKeyStore::RemoveWatchOnly(dest))
         return false;
+    MarkOutputsDirty();
     if (!HaveWatchOnly())
         NotifyWatchonlyChanged(false);
     if (fFileBacked)
@@ -361,6 +366,8 @@ bool CWallet::ChangeWalletPassphrase(const SecureString& strOldWalletPassphrase,
 
 void CWallet::SetBestChain(const CBlockLocator& loc)
 {
+    // SpySend rounds are cached by const lookups, write them out with the chain state
+    FlushSpySendRounds();
     CWalletDB walletdb(strWalletFile);
     walletdb.WriteBestBlock(loc);
 }
@@ -429,6 +436,8 @@ set<uint256> CWallet::GetConflicts(const uint256& txid) const
 
 void CWallet::Flush(bool shutdown)
 {
+    if (fFileBacked)
+        FlushSpySendRounds();
     bitdb.Flush(shutdown);
 }
 
@@ -560,6 +569,110 @@ void CWallet::AddToSpends(const uint256& wtxid)
         AddToSpends(txin.prevout, wtxid);
 }
 
+CWallet::UnspentOutputType CWallet::GetUnspentOutputType(CAmount nValue) const
+{
+    if (IsDenominatedAmount(nValue))
+        return UNSPENT_DENOMINATED;
+    if (IsCollateralAmount(nValue))
+        return UNSPENT_COLLATERAL;
+    if (nValue == 1000*COIN)
+        return UNSPENT_1000;
+    return UNSPENT_OTHER;
+}
+
+void CWallet::AddUnspentOutput(const COutPoint& outpoint) const
+{
+    AssertLockHeld(cs_wallet);
+
+    std::map<uint256, CWalletTx>::const_iterator mi = mapWallet.find(outpoint.hash);
+    if (mi == mapWallet.end() || outpoint.n >= mi->second.vout.size())
+        return;
+    const CTxOut& txout = mi->second.vout[outpoint.n];
+    if (IsMine(txout) != ISMINE_NO)
+        setUnspentOutputs[GetUnspentOutputType(txout.nValue)].insert(outpoint);
+}
+
+/**
+ * Add outputs of a new or changed transaction to the unspent output index.
+ * Whatever changed could also have unspent the outputs it spends, add those back too.
+ */
+void CWallet::AddUnspentOutputs(const CWalletTx& wtx) const
+{
+    AssertLockHeld(cs_wallet);
+
+    if (!fUnspentOutputsIndexed)
+        return;
+
+    const uint256& hash = wtx.GetHash();
+    for (unsigned int i = 0; i < wtx.vout.size(); i++)
+        AddUnspentOutput(COutPoint(hash, i));
+    if (!wtx.IsCoinBase()) {
+        BOOST_FOREACH(const CTxIn& txin, wtx.vin)
+            AddUnspentOutput(txin.prevout);
+    }
+}
+
+void CWallet::MarkOutputsDirty()
+{
+    LOCK(cs_wallet);
+    fUnspentOutputsIndexed = false;
+    ClearSpySendRounds();
+}
+
+bool CWallet::IsSpentInMainChain(const COutPoint& outpoint) const
+{
+    pair<TxSpends::const_iterator, TxSpends::const_iterator> range;
+    range = mapTxSpends.equal_range(outpoint);
+
+    for (TxSpends::const_iterator it = range.first; it != range.second; ++it)
+    {
+        std::map<uint256, CWalletTx>::const_iterator mit = mapWallet.find(it->second);
+        if (mit != mapWallet.end() && mit->second.GetDepthInMainChain(false) > 0)
+            return true;
+    }
+    return false;
+}
+
+void CWallet::GetUnspentOutputTxs(std::vector<const CWalletTx*>& vpwtxRet, int nTypeMask) const
+{
+    AssertLockHeld(cs_main);
+    AssertLockHeld(cs_wallet);
+
+    vpwtxRet.clear();
+
+    if (!fUnspentOutputsIndexed) {
+        for (int nType = 0; nType < UNSPENT_TYPES; nType++)
+            setUnspentOutputs[nType].clear();
+        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+            for (unsigned int i = 0; i < it->second.vout.size(); i++)
+                AddUnspentOutput(COutPoint(it->first, i));
+        fUnspentOutputsIndexed = true;
+        LogPrint("selectcoins", "GetUnspentOutputTxs -- indexed %d wallet transactions\n", mapWallet.size());
+    }
+
+    std::set<uint256> setHashes;
+    for (int nType = 0; nType < UNSPENT_TYPES; nType++) {
+        if (!(nTypeMask & (1 << nType)))
+            continue;
+        std::set<COutPoint>::iterator it = setUnspentOutputs[nType].begin();
+        while (it != setUnspentOutputs[nType].end()) {
+            if (IsSpentInMainChain(*it)) {
+                setUnspentOutputs[nType].erase(it++);
+                continue;
+            }
+            setHashes.insert(it->hash);
+            ++it;
+        }
+    }
+
+    vpwtxRet.reserve(setHashes.size());
+    BOOST_FOREACH(const uint256& hash, setHashes) {
+        std::map<uint256, CWalletTx>::const_iterator mi = mapWallet.find(hash);
+        if (mi != mapWallet.end())
+            vpwtxRet.push_back(&mi->second);
+    }
+}
+
 bool CWallet::EncryptWallet(const SecureString& strWalletPassphrase)
 {
     if (IsCrypted())
@@ -681,6 +794,7 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         BOOST_FOREACH(PAIRTYPE(const uint256, CWalletTx)& item, mapWallet)
             item.second.MarkDirty();
+        fUnspentOutputsIndexed = false;
     }
 
     fAnonymizableTallyCached = false;
@@ -766,6 +880,7 @@ bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFromLoadWallet, CWalletD
                              wtxIn.hashBlock.ToString());
             }
             AddToSpends(hash);
+            EraseSpySendRounds(hash);
         }
 
         bool fUpdated = false;
@@ -805,6 +920,7 @@ bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFromLoadWallet, CWalletD
 
         // Break debit/credit balance caches:
         wtx.MarkDirty();
+        AddUnspentOutputs(wtx);
 
         // Notify UI of new or updated transaction
         NotifyTransactionChanged(this, hash, fInsertedNew ? CT_NEW : CT_UPDATED);
@@ -920,6 +1036,7 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
                 if (mapWallet.count(txin.prevout.hash))
                     mapWallet[txin.prevout.hash].MarkDirty();
             }
+            AddUnspentOutputs(wtx);
         }
     }
 
@@ -984,6 +1101,7 @@ void CWallet::MarkConflicted(const uint256& hashBlock, const uint256& hashTx)
                 if (mapWallet.count(txin.prevout.hash))
                     mapWallet[txin.prevout.hash].MarkDirty();
             }
+            AddUnspentOutputs(wtx);
         }
     }
 
@@ -998,6 +1116,9 @@ void CWallet::SyncTransaction(const CTransaction& tx, const CBlock* pblock)
     if (!AddToWalletIfInvolvingMe(tx, pblock, true))
         return; // Not one of ours
 
+    if (pblock)
+        PruneSpySendRounds(mapWallet[tx.GetHash()]);
+
     // If a transaction changes 'conflicted' state, that changes the balance
     // available of the outputs it spends. So force those to be
     // recomputed, also:
@@ -1043,90 +1164,239 @@ CAmount CWallet::GetDebit(const CTxIn &txin, const isminefilter& filter) const
     return 0;
 }
 
-// Recursively determine the rounds of a given input (How deep is the SpySend chain for a given input)
-int CWallet::GetRealInputSpySendRounds(CTxIn txin, int nRounds) const
+int CWallet::GetOutputSpySendRounds(const CWalletTx& wtx, unsigned int n) const
 {
-    static std::map<uint256, CMutableTransaction> mDenomWtxes;
+    if (IsCollateralAmount(wtx.vout[n].nValue))
+        return -3;
 
-    if(nRounds >= 16) return 15; // 16 rounds max
+    //make sure the final output is non-denominate
+    if (!IsDenominatedAmount(wtx.vout[n].nValue)) //NOT DENOM
+        return -2;
 
-    uint256 hash = txin.prevout.hash;
-    unsigned int nout = txin.prevout.n;
+    // this one is denominated but there is another non-denominated output found in the same tx
+    BOOST_FOREACH(const CTxOut& out, wtx.vout) {
+        if (!IsDenominatedAmount(out.nValue))
+            return 0;
+    }
 
-    const CWalletTx* wtx = GetWalletTx(hash);
-    if(wtx != NULL)
-    {
-        std::map<uint256, CMutableTransaction>::const_iterator mdwi = mDenomWtxes.find(hash);
-        if (mdwi == mDenomWtxes.end()) {
-            // not known yet, let's add it
-            LogPrint("spysend", "GetRealInputSpySendRounds INSERTING %s\n", hash.ToString());
-            mDenomWtxes[hash] = CMutableTransaction(*wtx);
-        } else if(mDenomWtxes[hash].vout[nout].nRounds != -10) {
-            // found and it's not an initial value, just return it
-            return mDenomWtxes[hash].vout[nout].nRounds;
-        }
+    // only denoms here, rounds depend on the inputs
+    return -10;
+}
 
+/** A wallet output whose SpySend rounds wait for the rounds of its inputs */
+struct SpySendRoundsFrame
+{
+    COutPoint outpoint;
+    const CWalletTx* pwtx;
+    unsigned int nInput; // next input of pwtx to look at
+    int nShortest; // shortest chain of the inputs looked at so far, -10 if there is none yet
 
-        // bounds check
-        if (nout >= wtx->vout.size()) {
-            // should never actually hit this
-            LogPrint("spysend", "GetRealInputSpySendRounds UPDATED   %s %3d %3d\n", hash.ToString(), nout, -4);
-            return -4;
-        }
+    SpySendRoundsFrame(const COutPoint& outpointIn, const CWalletTx* pwtxIn) :
+        outpoint(outpointIn), pwtx(pwtxIn), nInput(0), nShortest(-10) {}
+};
 
-        if (IsCollateralAmount(wtx->vout[nout].nValue)) {
-            mDenomWtxes[hash].vout[nout].nRounds = -3;
-            LogPrint("spysend", "GetRealInputSpySendRounds UPDATED   %s %3d %3d\n", hash.ToString(), nout, mDenomWtxes[hash].vout[nout].nRounds);
-            return mDenomWtxes[hash].vout[nout].nRounds;
-        }
+// Determine the rounds of a given input (How deep is the SpySend chain for a given input).
+// Inputs are walked depth first with an explicit stack and the rounds of every output
+// on the way are cached, so each output of the wallet is only looked at once.
+int CWallet::GetRealInputSpySendRounds(const CTxIn& txin) const
+{
+    AssertLockHeld(cs_wallet);
 
-        //make sure the final output is non-denominate
-        if (!IsDenominatedAmount(wtx->vout[nout].nValue)) { //NOT DENOM
-            mDenomWtxes[hash].vout[nout].nRounds = -2;
-            LogPrint("spysend", "GetRealInputSpySendRounds UPDATED   %s %3d %3d\n", hash.ToString(), nout, mDenomWtxes[hash].vout[nout].nRounds);
-            return mDenomWtxes[hash].vout[nout].nRounds;
-        }
+    std::map<COutPoint, int>::const_iterator mi = mapOutpointRoundsCache.find(txin.prevout);
+    if (mi != mapOutpointRoundsCache.end())
+        return mi->second;
 
-        bool fAllDenoms = true;
-        BOOST_FOREACH(CTxOut out, wtx->vout) {
-            fAllDenoms = fAllDenoms && IsDenominatedAmount(out.nValue);
-        }
+    const CWalletTx* wtx = GetWalletTx(txin.prevout.hash);
+    if (wtx == NULL)
+        return -1;
 
-        // this one is denominated but there is another non-denominated output found in the same tx
-        if (!fAllDenoms) {
-            mDenomWtxes[hash].vout[nout].nRounds = 0;
-            LogPrint("spysend", "GetRealInputSpySendRounds UPDATED   %s %3d %3d\n", hash.ToString(), nout, mDenomWtxes[hash].vout[nout].nRounds);
-            return mDenomWtxes[hash].vout[nout].nRounds;
-        }
+    // bounds check
+    if (txin.prevout.n >= wtx->vout.size()) {
+        // should never actually hit this
+        return -4;
+    }
 
-        int nShortest = -10; // an initial value, should be no way to get this by calculations
-        bool fDenomFound = false;
-        // only denoms here so let's look up
-        BOOST_FOREACH(CTxIn txinNext, wtx->vin) {
-            if (IsMine(txinNext)) {
-                int n = GetRealInputSpySendRounds(txinNext, nRounds + 1);
-                // denom found, find the shortest chain or initially assign nShortest with the first found value
-                if(n >= 0 && (n < nShortest || nShortest == -10)) {
-                    nShortest = n;
-                    fDenomFound = true;
-                }
+    std::vector<SpySendRoundsFrame> vStack;
+    unsigned int nAdded = 0;
+
+    int nRounds = GetOutputSpySendRounds(*wtx, txin.prevout.n);
+    if (nRounds != -10) {
+        SetSpySendRounds(txin.prevout, nRounds);
+        nAdded++;
+    } else
+        vStack.push_back(SpySendRoundsFrame(txin.prevout, wtx));
+
+    while (!vStack.empty()) {
+        SpySendRoundsFrame& frame = vStack.back();
+        const CWalletTx* pwtxNext = NULL;
+        for (; frame.nInput < frame.pwtx->vin.size(); frame.nInput++) {
+            const CTxIn& txinNext = frame.pwtx->vin[frame.nInput];
+            if (!IsMine(txinNext))
+                continue;
+            int n;
+            mi = mapOutpointRoundsCache.find(txinNext.prevout);
+            if (mi != mapOutpointRoundsCache.end()) {
+                n = mi->second;
+            } else {
+                pwtxNext = GetWalletTx(txinNext.prevout.hash);
+                n = GetOutputSpySendRounds(*pwtxNext, txinNext.prevout.n);
+                // walk the inputs of this one first and come back to it
+                if (n == -10)
+                    break;
+                pwtxNext = NULL;
+                SetSpySendRounds(txinNext.prevout, n);
+                nAdded++;
             }
+            // denom found, find the shortest chain or initially assign nShortest with the first found value
+            if (n >= 0 && (n < frame.nShortest || frame.nShortest == -10))
+                frame.nShortest = n;
+        }
+        if (pwtxNext != NULL) {
+            // push_back invalidates frame
+            COutPoint outpointNext = frame.pwtx->vin[frame.nInput].prevout;
+            vStack.push_back(SpySendRoundsFrame(outpointNext, pwtxNext));
+            continue;
         }
-        mDenomWtxes[hash].vout[nout].nRounds = fDenomFound
-                ? (nShortest >= 15 ? 16 : nShortest + 1) // good, we a +1 to the shortest one but only 16 rounds max allowed
+        nRounds = frame.nShortest != -10
+                ? (frame.nShortest >= 15 ? 16 : frame.nShortest + 1) // good, we a +1 to the shortest one but only 16 rounds max allowed
                 : 0;            // too bad, we are the fist one in that chain
-        LogPrint("spysend", "GetRealInputSpySendRounds UPDATED   %s %3d %3d\n", hash.ToString(), nout, mDenomWtxes[hash].vout[nout].nRounds);
-        return mDenomWtxes[hash].vout[nout].nRounds;
+        SetSpySendRounds(frame.outpoint, nRounds);
+        nAdded++;
+        vStack.pop_back();
+    }
+
+    LogPrint("spysend", "GetRealInputSpySendRounds %s %3d %3d, %d outputs added\n", txin.prevout.hash.ToString(), txin.prevout.n, nRounds, nAdded);
+
+    return nRounds;
+}
+
+void CWallet::SetSpySendRounds(const COutPoint& outpoint, int nRounds) const
+{
+    mapOutpointRoundsCache[outpoint] = nRounds;
+    // written to the wallet database by FlushSpySendRounds(), lookups stay in memory
+    if (fFileBacked)
+        setSpySendRoundsDirty.insert(outpoint);
+}
+
+void CWallet::EraseSpySendRounds(const uint256& hash)
+{
+    AssertLockHeld(cs_wallet);
+
+    if (mapOutpointRoundsCache.empty())
+        return;
+
+    // Rounds of outputs which wallet transactions already spend (e.g. when a rescan
+    // adds parents after their children) are baked into the rounds of their descendants
+    TxSpends::const_iterator iter = mapTxSpends.lower_bound(COutPoint(hash, 0));
+    if (iter != mapTxSpends.end() && iter->first.hash == hash) {
+        ClearSpySendRounds();
+        return;
     }
 
-    return nRounds - 1;
+    std::map<COutPoint, int>::iterator it = mapOutpointRoundsCache.lower_bound(COutPoint(hash, 0));
+    while (it != mapOutpointRoundsCache.end() && it->first.hash == hash) {
+        if (fFileBacked)
+            setSpySendRoundsDirty.insert(it->first);
+        mapOutpointRoundsCache.erase(it++);
+    }
+}
+
+void CWallet::ClearSpySendRounds()
+{
+    AssertLockHeld(cs_wallet);
+
+    if (mapOutpointRoundsCache.empty())
+        return;
+
+    LogPrint("spysend", "ClearSpySendRounds -- forgetting rounds of %d outputs\n", mapOutpointRoundsCache.size());
+
+    if (fFileBacked) {
+        for (std::map<COutPoint, int>::const_iterator it = mapOutpointRoundsCache.begin(); it != mapOutpointRoundsCache.end(); ++it)
+            setSpySendRoundsDirty.insert(it->first);
+    }
+    mapOutpointRoundsCache.clear();
+}
+
+/**
+ * Forget the rounds of the outputs a confirmed transaction spends. They are only
+ * needed to work out the rounds of the transaction's own outputs, so those are
+ * looked up first.
+ */
+void CWallet::PruneSpySendRounds(const CWalletTx& wtx)
+{
+    AssertLockHeld(cs_wallet);
+
+    bool fCached = false;
+    BOOST_FOREACH(const CTxIn& txin, wtx.vin)
+        fCached = fCached || mapOutpointRoundsCache.count(txin.prevout);
+    if (!fCached)
+        return;
+
+    const uint256& hash = wtx.GetHash();
+    for (unsigned int i = 0; i < wtx.vout.size(); i++) {
+        if (IsMine(wtx.vout[i]) != ISMINE_NO)
+            GetRealInputSpySendRounds(CTxIn(hash, i));
+    }
+
+    BOOST_FOREACH(const CTxIn& txin, wtx.vin) {
+        if (mapOutpointRoundsCache.erase(txin.prevout) && fFileBacked)
+            setSpySendRoundsDirty.insert(txin.prevout);
+    }
+}
+
+void CWallet::PruneSpySendRounds()
+{
+    LOCK2(cs_main, cs_wallet);
+
+    std::set<uint256> setSpenders;
+    for (std::map<COutPoint, int>::const_iterator it = mapOutpointRoundsCache.begin(); it != mapOutpointRoundsCache.end(); ++it) {
+        std::pair<TxSpends::const_iterator, TxSpends::const_iterator> range = mapTxSpends.equal_range(it->first);
+        for (TxSpends::const_iterator iter = range.first; iter != range.second; ++iter) {
+            std::map<uint256, CWalletTx>::const_iterator mi = mapWallet.find(iter->second);
+            if (mi != mapWallet.end() && mi->second.GetDepthInMainChain(false) > 0)
+                setSpenders.insert(iter->second);
+        }
+    }
+
+    size_t nBefore = mapOutpointRoundsCache.size();
+    BOOST_FOREACH(const uint256& hash, setSpenders)
+        PruneSpySendRounds(mapWallet[hash]);
+    LogPrint("spysend", "PruneSpySendRounds -- %d of %d outputs left\n", mapOutpointRoundsCache.size(), nBefore);
+}
+
+void CWallet::FlushSpySendRounds()
+{
+    LOCK(cs_wallet);
+
+    if (setSpySendRoundsDirty.empty())
+        return;
+
+    CWalletDB walletdb(strWalletFile);
+    walletdb.TxnBegin();
+    BOOST_FOREACH(const COutPoint& outpoint, setSpySendRoundsDirty) {
+        std::map<COutPoint, int>::const_iterator mi = mapOutpointRoundsCache.find(outpoint);
+        if (mi != mapOutpointRoundsCache.end())
+            walletdb.WriteSpySendRounds(outpoint, mi->second);
+        else
+            walletdb.EraseSpySendRounds(outpoint);
+    }
+    walletdb.TxnCommit();
+
+    LogPrint("spysend", "FlushSpySendRounds -- wrote rounds of %d outputs\n", setSpySendRoundsDirty.size());
+    setSpySendRoundsDirty.clear();
+}
+
+bool CWallet::LoadSpySendRounds(const COutPoint& outpoint, int nRounds)
+{
+    mapOutpointRoundsCache[outpoint] = nRounds;
+    return true;
 }
 
 // respect current settings
 int CWallet::GetInputSpySendRounds(CTxIn txin) const
 {
     LOCK(cs_wallet);
-    int realSpySendRounds = GetRealInputSpySendRounds(txin, 0);
+    int realSpySendRounds = GetRealInputSpySendRounds(txin);
     return realSpySendRounds > nSpySendRounds ? nSpySendRounds : realSpySendRounds;
 }
 
@@ -1845,9 +2115,10 @@ CAmount CWallet::GetBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             if (pcoin->IsTrusted())
                 nTotal += pcoin->GetAvailableCredit();
         }
@@ -1883,10 +2154,10 @@ CAmount CWallet::GetAnonymizedBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx, 1 << UNSPENT_DENOMINATED);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
-
             if (pcoin->IsTrusted())
                 nTotal += pcoin->GetAnonymizedCredit();
         }
@@ -1906,11 +2177,11 @@ double CWallet::GetAverageAnonymizedRounds() const
 
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx, 1 << UNSPENT_DENOMINATED);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
-
-            uint256 hash = (*it).first;
+            const uint256& hash = pcoin->GetHash();
 
             for (unsigned int i = 0; i < pcoin->vout.size(); i++) {
 
@@ -1940,11 +2211,11 @@ CAmount CWallet::GetNormalizedAnonymizedBalance() const
 
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx, 1 << UNSPENT_DENOMINATED);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
-
-            uint256 hash = (*it).first;
+            const uint256& hash = pcoin->GetHash();
 
             for (unsigned int i = 0; i < pcoin->vout.size(); i++) {
 
@@ -1993,10 +2264,10 @@ CAmount CWallet::GetDenominatedBalance(bool unconfirmed) const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx, 1 << UNSPENT_DENOMINATED);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
-
             nTotal += pcoin->GetDenominatedCredit(unconfirmed);
         }
     }
@@ -2009,9 +2280,10 @@ CAmount CWallet::GetUnconfirmedBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             if (!pcoin->IsTrusted() && pcoin->GetDepthInMainChain() == 0 && pcoin->InMempool())
                 nTotal += pcoin->GetAvailableCredit();
         }
@@ -2024,9 +2296,10 @@ CAmount CWallet::GetImmatureBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             nTotal += pcoin->GetImmatureCredit();
         }
     }
@@ -2038,9 +2311,10 @@ CAmount CWallet::GetWatchOnlyBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             if (pcoin->IsTrusted())
                 nTotal += pcoin->GetAvailableWatchOnlyCredit();
         }
@@ -2054,9 +2328,10 @@ CAmount CWallet::GetUnconfirmedWatchOnlyBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             if (!pcoin->IsTrusted() && pcoin->GetDepthInMainChain() == 0 && pcoin->InMempool())
                 nTotal += pcoin->GetAvailableWatchOnlyCredit();
         }
@@ -2069,25 +2344,45 @@ CAmount CWallet::GetImmatureWatchOnlyBalance() const
     CAmount nTotal = 0;
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx);
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const CWalletTx* pcoin = &(*it).second;
             nTotal += pcoin->GetImmatureWatchOnlyCredit();
         }
     }
     return nTotal;
 }
 
+int CWallet::GetUnspentOutputTypeMask(AvailableCoinsType nCoinType) const
+{
+    int nTypeMask = UNSPENT_ALL;
+    if(nCoinType == ONLY_DENOMINATED) {
+        nTypeMask = 1 << UNSPENT_DENOMINATED;
+    } else if(nCoinType == ONLY_NOT1000IFMN) {
+        if(fEternityNode) nTypeMask &= ~(1 << UNSPENT_1000);
+    } else if(nCoinType == ONLY_NONDENOMINATED_NOT1000IFMN) {
+        nTypeMask = (1 << UNSPENT_OTHER) | (fEternityNode ? 0 : 1 << UNSPENT_1000);
+    } else if(nCoinType == ONLY_1000) {
+        nTypeMask = 1 << UNSPENT_1000;
+    } else if(nCoinType == ONLY_SPYSEND_COLLATERAL) {
+        nTypeMask = 1 << UNSPENT_COLLATERAL;
+    }
+    return nTypeMask;
+}
+
 void CWallet::AvailableCoins(vector<COutput>& vCoins, bool fOnlyConfirmed, const CCoinControl *coinControl, bool fIncludeZeroValue, AvailableCoinsType nCoinType, bool fUseInstantSend) const
 {
     vCoins.clear();
 
     {
         LOCK2(cs_main, cs_wallet);
-        for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it)
+
+        std::vector<const CWalletTx*> vpwtx;
+        GetUnspentOutputTxs(vpwtx, GetUnspentOutputTypeMask(nCoinType));
+        BOOST_FOREACH(const CWalletTx* pcoin, vpwtx)
         {
-            const uint256& wtxid = it->first;
-            const CWalletTx* pcoin = &(*it).second;
+            const uint256& wtxid = pcoin->GetHash();
 
             if (!CheckFinalTx(*pcoin))
                 continue;
@@ -2129,9 +2424,9 @@ void CWallet::AvailableCoins(vector<COutput>& vCoins, bool fOnlyConfirmed, const
 
                 isminetype mine = IsMine(pcoin->vout[i]);
                 if (!(IsSpent(wtxid, i)) && mine != ISMINE_NO &&
-                    (!IsLockedCoin((*it).first, i) || nCoinType == ONLY_1000) &&
+                    (!IsLockedCoin(wtxid, i) || nCoinType == ONLY_1000) &&
                     (pcoin->vout[i].nValue > 0 || fIncludeZeroValue) &&
-                    (!coinControl || !coinControl->HasSelected() || coinControl->fAllowOtherInputs || coinControl->IsSelected((*it).first, i)))
+                    (!coinControl || !coinControl->HasSelected() || coinControl->fAllowOtherInputs || coinControl->IsSelected(wtxid, i)))
                         vCoins.push_back(COutput(pcoin, i, nDepth,
                                                  ((mine & ISMINE_SPENDABLE) != ISMINE_NO) ||
                                                   (coinControl && coinControl->fAllowWatchOnly && (mine & ISMINE_WATCH_SOLVABLE) != ISMINE_NO)));
@@ -2570,10 +2865,17 @@ bool CWallet::SelectCoinsGrouppedByAddresses(std::vector<CompactTallyItem>& vecT
         }
     }
 
+    int nTypeMask = UNSPENT_ALL;
+    if(fSkipDenominated) nTypeMask &= ~(1 << UNSPENT_DENOMINATED);
+    if(fAnonymizable) nTypeMask &= ~(1 << UNSPENT_COLLATERAL);
+    if(fAnonymizable && fEternityNode) nTypeMask &= ~(1 << UNSPENT_1000);
+
     // Tally
     map<CBitcoinAddress, CompactTallyItem> mapTally;
-    for (map<uint256, CWalletTx>::const_iterator it = mapWallet.begin(); it != mapWallet.end(); ++it) {
-        const CWalletTx& wtx = (*it).second;
+    std::vector<const CWalletTx*> vpwtx;
+    GetUnspentOutputTxs(vpwtx, nTypeMask);
+    BOOST_FOREACH(const CWalletTx* pwtx, vpwtx) {
+        const CWalletTx& wtx = *pwtx;
 
         if(wtx.IsCoinBase() && wtx.GetBlocksToMaturity() > 0) continue;
         if(!fAnonymizable && !wtx.IsTrusted()) continue;
@@ -554,6 +554,49 @@ private:
 
     void SyncMetaData(std::pair<TxSpends::iterator, TxSpends::iterator>);
 
+    /**
+     * SpySend rounds of the wallet outputs walked so far, mirrored in the wallet
+     * database. Rounds only depend on the transaction graph and on which inputs
+     * are ours, not on confirmations, so they survive reorgs and only need to be
+     * forgotten when transactions are added or keys are imported. Rounds of outputs
+     * spent by a confirmed transaction are dropped once its own outputs are cached.
+     */
+    mutable std::map<COutPoint, int> mapOutpointRoundsCache;
+    /** Outputs whose cached rounds changed since they were last written to the wallet database */
+    mutable std::set<COutPoint> setSpySendRoundsDirty;
+    /** Rounds of an output which don't depend on the inputs of its transaction, -10 if they do */
+    int GetOutputSpySendRounds(const CWalletTx& wtx, unsigned int n) const;
+    void SetSpySendRounds(const COutPoint& outpoint, int nRounds) const;
+    void EraseSpySendRounds(const uint256& hash);
+    void ClearSpySendRounds();
+    void PruneSpySendRounds(const CWalletTx& wtx);
+
+    /** Kinds of outputs kept apart by the unspent output index */
+    enum UnspentOutputType
+    {
+        UNSPENT_DENOMINATED = 0,
+        UNSPENT_COLLATERAL,
+        UNSPENT_1000,
+        UNSPENT_OTHER,
+        UNSPENT_TYPES
+    };
+    static const int UNSPENT_ALL = (1 << UNSPENT_TYPES) - 1;
+
+    /**
+     * Outputs of ours which may be unspent, bucketed by UnspentOutputType so that
+     * balances and coin selection only look at wallet transactions which still have
+     * something to spend. Outputs spent by a transaction in the main chain are dropped
+     * when a lookup comes across them and every change which could unspend an output
+     * adds it back, so this is always a superset of the unspent outputs. Built on
+     * first use since amounts can't be classified before SpySend is initialized.
+     */
+    mutable std::set<COutPoint> setUnspentOutputs[UNSPENT_TYPES];
+    mutable bool fUnspentOutputsIndexed;
+    UnspentOutputType GetUnspentOutputType(CAmount nValue) const;
+    void AddUnspentOutput(const COutPoint& outpoint) const;
+    void AddUnspentOutputs(const CWalletTx& wtx) const;
+    bool IsSpentInMainChain(const COutPoint& outpoint) const;
+
 public:
     /*
      * Main wallet lock.
@@ -607,6 +650,7 @@ public:
         fBroadcastTransactions = false;
         fAnonymizableTallyCached = false;
         fAnonymizableTallyCachedNonDenom = false;
+        fUnspentOutputsIndexed = false;
         vecAnonymizableTallyCached.clear();
         vecAnonymizableTallyCachedNonDenom.clear();
     }
@@ -640,6 +684,11 @@ public:
      */
     void AvailableCoins(std::vector<COutput>& vCoins, bool fOnlyConfirmed=true, const CCoinControl *coinControl = NULL, bool fIncludeZeroValue=false, AvailableCoinsType nCoinType=ALL_COINS, bool fUseInstantSend = false) const;
 
+    /** Mask of the unspent output index buckets which can hold coins of nCoinType */
+    int GetUnspentOutputTypeMask(AvailableCoinsType nCoinType) const;
+    /** Wallet transactions with outputs in the given buckets of the unspent output index, in hash order */
+    void GetUnspentOutputTxs(std::vector<const CWalletTx*>& vpwtxRet, int nTypeMask = UNSPENT_ALL) const;
+
     /**
      * Shuffle and select coins until nTargetValue is reached while avoiding
      * small change; This method is stochastic for some inputs and upon
@@ -663,7 +712,7 @@ public:
     int  CountInputsWithAmount(CAmount nInputAmount);
 
     // get the SpySend chain depth for a given input
-    int GetRealInputSpySendRounds(CTxIn txin, int nRounds) const;
+    int GetRealInputSpySendRounds(const CTxIn& txin) const;
     // respect current settings
     int GetInputSpySendRounds(CTxIn txin) const;
 
@@ -705,6 +754,8 @@ public:
     bool EraseDestData(const CTxDestination &dest, const std::string &key);
     //! Adds a destination data tuple to the store, without saving it to disk
     bool LoadDestData(const CTxDestination &dest, const std::string &key, const std::string &value);
+    //! Adds SpySend rounds of an output to the cache without saving them (used by LoadWallet)
+    bool LoadSpySendRounds(const COutPoint& outpoint, int nRounds);
     //! Look up a destination data tuple in the store, return true if found false otherwise
     bool GetDestData(const CTxDestination &dest, const std::string &key, std::string *value) const;
 
@@ -859,6 +910,12 @@ public:
 
     //! Flush wallet (bitdb flush)
     void Flush(bool shutdown=false);
+    //! Write SpySend rounds cached by lookups since the last call to the wallet database
+    void FlushSpySendRounds();
+    //! Drop SpySend rounds of outputs already spent by confirmed transactions
+    void PruneSpySendRounds();
+    //! Forget what's known about which outputs are ours, after keys or scripts were imported
+    void MarkOutputsDirty();
 
     //! Verify the wallet database and perform salvage if required
     static bool Verify(const std::string& walletFile, std::string& warningString, std::string& errorString);
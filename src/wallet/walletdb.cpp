@@ -587,6 +587,14 @@ ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue,
         {
             ssValue >> pwallet->nOrderPosNext;
         }
+        else if (strType == "psrounds")
+        {
+            COutPoint outpoint;
+            int nRounds;
+            ssKey >> outpoint;
+            ssValue >> nRounds;
+            pwallet->LoadSpySendRounds(outpoint, nRounds);
+        }
         else if (strType == "destdata")
         {
             std::string strAddress, strKey, strValue;
@@ -1127,3 +1135,15 @@ bool CWalletDB::EraseDestData(const std::string &address, const std::string &key
     nWalletDBUpdated++;
     return Erase(std::make_pair(std::string("destdata"), std::make_pair(address, key)));
 }
+
+bool CWalletDB::WriteSpySendRounds(const COutPoint& outpoint, int nRounds)
+{
+    nWalletDBUpdated++;
+    return Write(std::make_pair(std::string("psrounds"), outpoint), nRounds);
+}
+
+bool CWalletDB::EraseSpySendRounds(const COutPoint& outpoint)
+{
+    nWalletDBUpdated++;
+    return Erase(std::make_pair(std::string("psrounds"), outpoint));
+}
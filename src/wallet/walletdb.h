@@ -23,6 +23,7 @@ class CAccountingEntry;
 struct CBlockLocator;
 class CKeyPool;
 class CMasterKey;
+class COutPoint;
 class CScript;
 class CWallet;
 class CWalletTx;
@@ -123,6 +124,11 @@ public:
     /// Erase destination data tuple from wallet database
     bool EraseDestData(const std::string &address, const std::string &key);
 
+    /// Write SpySend rounds of a wallet output to database
+    bool WriteSpySendRounds(const COutPoint& outpoint, int nRounds);
+    /// Erase SpySend rounds of a wallet output from database
+    bool EraseSpySendRounds(const COutPoint& outpoint);
+
     CAmount GetAccountCreditDebit(const std::string& strAccount);
     void ListAccountCreditDebit(const std::string& strAccount, std::list<CAccountingEntry>& acentries);
 